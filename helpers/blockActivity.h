@@ -0,0 +1,162 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// quiescent-block skipping for the multiphase lattices
+// every interval time steps the change of rhoBar and j since the last check is measured per
+// local block; a block whose bulk changed less than the tolerance in all lattices is frozen
+// (no collision-streaming and no internal processors, only its envelope is kept up to date by
+// communication). a frozen block is compared to its state at the time it was frozen and is
+// re-activated once its envelope (the boundary data of its neighbours) or its bulk (e.g. new
+// boundary densities) moved by more than the tolerance
+# ifndef BLOCKACTIVITY_H_
+# define BLOCKACTIVITY_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+
+# include <map>
+# include <vector>
+# include <cmath>
+# include <algorithm>
+
+namespace activity {
+
+template <typename U, template<typename V> class Descriptor>
+class QuiescentBlocks {
+    public:
+        // all lattices must share one block decomposition
+        QuiescentBlocks(std::vector<plb::MultiBlockLattice3D<U, Descriptor> *> const & lattices,
+                U tolerance, plb::plint interval):
+                        lattices_{lattices}, tolerance_{tolerance}, interval_{interval} {};
+
+        // called after every time step of the lattices
+        void update() {
+            ++step_;
+            if (step_ % interval_ != 0) {
+                return;
+            }
+            plb::MultiBlockLattice3D<U, Descriptor> & first = *lattices_[0];
+            std::vector<plb::plint> const & blocks = first.getLocalInfo().getBlocks();
+            for (plb::pluint iBlock = 0; iBlock < blocks.size(); ++iBlock) {
+                plb::plint blockId = blocks[iBlock];
+                bool frozen = first.isFrozen(blockId);
+                if (snapshots_.find(blockId) == snapshots_.end()) {
+                    takeSnapshot(blockId);
+                    continue;
+                }
+                // active blocks are measured on their bulk, frozen blocks on the whole atomic
+                // block as their envelope is the only part that moves
+                U change = maxChange(blockId, !frozen);
+                if (!frozen && change < tolerance_) {
+                    for (plb::pluint iL = 0; iL < lattices_.size(); ++iL) {
+                        lattices_[iL]->freezeBlock(blockId);
+                    }
+                    takeSnapshot(blockId);
+                }
+                else if (frozen && change >= tolerance_) {
+                    for (plb::pluint iL = 0; iL < lattices_.size(); ++iL) {
+                        lattices_[iL]->unfreezeBlock(blockId);
+                    }
+                    takeSnapshot(blockId);
+                }
+                else if (!frozen) {
+                    takeSnapshot(blockId);
+                }
+            }
+            plb::plint numFrozen = first.getNumFrozenBlocks();
+# ifdef PLB_MPI_PARALLEL
+            plb::global::mpi().reduceAndBcast(numFrozen, MPI_SUM);
+# endif
+            if (numFrozen != numFrozen_) {
+                numFrozen_ = numFrozen;
+                plb::pcout << "quiescent blocks: " << numFrozen_ << " of "
+                           << first.getSparseBlockStructure().getNumBlocks() << " frozen" << std::endl;
+            }
+        }
+
+        // re-activates all blocks, e.g. after boundary values or model parameters were changed;
+        // the next measurement starts one interval later
+        void activateAll() {
+            for (plb::pluint iL = 0; iL < lattices_.size(); ++iL) {
+                lattices_[iL]->unfreezeAllBlocks();
+            }
+            snapshots_.clear();
+            numFrozen_ = 0;
+        }
+
+    private:
+        // rhoBar and j of every cell of the atomic block, for each lattice
+        void takeSnapshot(plb::plint blockId) {
+            std::vector<U> & snapshot = snapshots_[blockId];
+            snapshot.clear();
+            for (plb::pluint iL = 0; iL < lattices_.size(); ++iL) {
+                plb::BlockLattice3D<U, Descriptor> & block = lattices_[iL]->getComponent(blockId);
+                for (plb::plint iX = 0; iX < block.getNx(); ++iX) {
+                    for (plb::plint iY = 0; iY < block.getNy(); ++iY) {
+                        for (plb::plint iZ = 0; iZ < block.getNz(); ++iZ) {
+                            U rhoBar;
+                            plb::Array<U, 3> j;
+                            plb::momentTemplates<U, Descriptor>::get_rhoBar_j(block.get(iX, iY, iZ), rhoBar, j);
+                            snapshot.push_back(rhoBar);
+                            snapshot.push_back(j[0]);
+                            snapshot.push_back(j[1]);
+                            snapshot.push_back(j[2]);
+                        }
+                    }
+                }
+            }
+        }
+
+        U maxChange(plb::plint blockId, bool bulkOnly) const {
+            std::vector<U> const & snapshot = snapshots_.find(blockId)->second;
+            plb::SmartBulk3D bulk(lattices_[0]->getMultiBlockManagement(), blockId);
+            plb::Box3D domain = bulk.toLocal(bulk.getBulk());
+            U change{0};
+            plb::pluint pos{0};
+            for (plb::pluint iL = 0; iL < lattices_.size(); ++iL) {
+                plb::BlockLattice3D<U, Descriptor> & block = lattices_[iL]->getComponent(blockId);
+                for (plb::plint iX = 0; iX < block.getNx(); ++iX) {
+                    for (plb::plint iY = 0; iY < block.getNy(); ++iY) {
+                        for (plb::plint iZ = 0; iZ < block.getNz(); ++iZ, pos += 4) {
+                            if (bulkOnly && !plb::contained(iX, iY, iZ, domain)) {
+                                continue;
+                            }
+                            U rhoBar;
+                            plb::Array<U, 3> j;
+                            plb::momentTemplates<U, Descriptor>::get_rhoBar_j(block.get(iX, iY, iZ), rhoBar, j);
+                            change = std::max(change, std::fabs(rhoBar - snapshot[pos]));
+                            for (plb::plint iD = 0; iD < 3; ++iD) {
+                                change = std::max(change, std::fabs(j[iD] - snapshot[pos + 1 + iD]));
+                            }
+                        }
+                    }
+                }
+            }
+            return change;
+        }
+
+        std::vector<plb::MultiBlockLattice3D<U, Descriptor> *> lattices_;
+        U tolerance_;
+        plb::plint interval_;
+        plb::plint step_{0}, numFrozen_{0};
+        std::map<plb::plint, std::vector<U>> snapshots_;
+};
+
+}
+
+# endif
@@ -0,0 +1,204 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// residual-based convergence monitor for the two Shan-Chen species
+// keeps a float copy of both densities at the last check; one pass over both lattices measures
+// the l2 and linf residuals of each species and the saturation change since then, and the local
+// partial results are combined with a single reduction per check
+# ifndef CONVERGENCEMONITOR_H_
+# define CONVERGENCEMONITOR_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+# include "mpFunctionals.h"
+
+# include <vector>
+# include <cmath>
+# include <limits>
+# include <algorithm>
+
+namespace convergence {
+
+// layout of the partial results: sums first, then maxima
+enum Partial {sumSqOne, sumSqTwo, sumRefOne, sumRefTwo, volumeOne, poreNodes,
+              maxOne, maxTwo, maxRefOne, maxRefTwo, numPartials};
+const int numSums = maxOne;
+
+// residuals per time step since the last check, in percent like the energy criterion:
+// l2 = |rho - rho_old|_2/|rho_old|_2, linf = max|rho - rho_old|/max(rho_old), saturation change = |S - S_old|
+template <typename U>
+struct Residuals {
+    U l2F1, l2F2, linfF1, linfF2, saturation, saturationChange;
+};
+
+// blocks: lattice one, lattice two, tags, density snapshot one, density snapshot two
+// adds the partial results of its domain to partials and replaces the snapshots by the current densities
+template <typename U, template<typename V> class Descriptor>
+class DensityResiduals3D : public plb::BoxProcessingFunctional3D {
+    public:
+        DensityResiduals3D(std::vector<double> * partials, U rhoF1, U rhoF2, U rhoNoFluid):
+                partials_{partials}, rhoF1_{rhoF1}, rhoF2_{rhoF2}, rhoNoFluid_{rhoNoFluid} {};
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 5);
+            plb::BlockLattice3D<U, Descriptor> & latticeOne = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[0]);
+            plb::BlockLattice3D<U, Descriptor> & latticeTwo = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[1]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[2]);
+            plb::ScalarField3D<float> & oldOne = dynamic_cast<plb::ScalarField3D<float> &>(*blocks[3]);
+            plb::ScalarField3D<float> & oldTwo = dynamic_cast<plb::ScalarField3D<float> &>(*blocks[4]);
+            plb::Dot3D ofsTwo = plb::computeRelativeDisplacement(latticeOne, latticeTwo);
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(latticeOne, tags);
+            plb::Dot3D ofsO = plb::computeRelativeDisplacement(latticeOne, oldOne);
+            plb::Dot3D ofsW = plb::computeRelativeDisplacement(latticeOne, oldTwo);
+            std::vector<double> & partials = *partials_;
+
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (mpfunctionals::isSolidTag(tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z))) {
+                            continue;
+                        }
+                        U rhoOne = Descriptor<U>::fullRho(plb::momentTemplates<U, Descriptor>::get_rhoBar(latticeOne.get(iX, iY, iZ)));
+                        U rhoTwo = Descriptor<U>::fullRho(plb::momentTemplates<U, Descriptor>::get_rhoBar(
+                                latticeTwo.get(iX + ofsTwo.x, iY + ofsTwo.y, iZ + ofsTwo.z)));
+                        float & snapOne = oldOne.get(iX + ofsO.x, iY + ofsO.y, iZ + ofsO.z);
+                        float & snapTwo = oldTwo.get(iX + ofsW.x, iY + ofsW.y, iZ + ofsW.z);
+                        double diffOne = (double) rhoOne - (double) snapOne;
+                        double diffTwo = (double) rhoTwo - (double) snapTwo;
+                        partials[sumSqOne] += diffOne*diffOne;
+                        partials[sumSqTwo] += diffTwo*diffTwo;
+                        partials[sumRefOne] += (double) snapOne*(double) snapOne;
+                        partials[sumRefTwo] += (double) snapTwo*(double) snapTwo;
+                        partials[maxOne] = std::max(partials[maxOne], std::fabs(diffOne));
+                        partials[maxTwo] = std::max(partials[maxTwo], std::fabs(diffTwo));
+                        partials[maxRefOne] = std::max(partials[maxRefOne], std::fabs((double) snapOne));
+                        partials[maxRefTwo] = std::max(partials[maxRefTwo], std::fabs((double) snapTwo));
+                        // volume fraction of fluid one, as in the relative permeability fluxes
+                        U fillOne = std::max(rhoOne - rhoNoFluid_, (U) 0.)/(rhoF1_ - rhoNoFluid_);
+                        U fillTwo = std::max(rhoTwo - rhoNoFluid_, (U) 0.)/(rhoF2_ - rhoNoFluid_);
+                        partials[volumeOne] += fillOne + fillTwo > (U) 0. ? (double) (fillOne/(fillOne + fillTwo)) : 0.5;
+                        partials[poreNodes] += 1.;
+                        snapOne = (float) rhoOne;
+                        snapTwo = (float) rhoTwo;
+                    }
+                }
+            }
+        }
+        virtual DensityResiduals3D<U, Descriptor> * clone() const {
+            return new DensityResiduals3D<U, Descriptor>(*this);
+        }
+        // the snapshots are written, but only ever read on the same bulk nodes: their envelopes
+        // are not kept up to date, which saves a communication per check
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            for (plb::pluint iB = 0; iB < modified.size(); ++iB) {
+                modified[iB] = plb::modif::nothing;
+            }
+        }
+    private:
+        std::vector<double> * partials_;
+        U rhoF1_, rhoF2_, rhoNoFluid_;
+};
+
+# ifdef PLB_MPI_PARALLEL
+// element-wise reduction of the partial results: sum of the sums, maximum of the maxima
+inline void combinePartials(void * in, void * inOut, int * length, MPI_Datatype *) {
+    double * source = static_cast<double *>(in);
+    double * target = static_cast<double *>(inOut);
+    for (int i = 0; i < *length; ++i) {
+        target[i] = i % numPartials < numSums ? target[i] + source[i] : std::max(target[i], source[i]);
+    }
+}
+# endif
+
+// the lattices, the tags and the snapshots share one block decomposition
+template <typename U, template<typename V> class Descriptor>
+class ResidualMonitor {
+    public:
+        ResidualMonitor(plb::MultiBlockLattice3D<U, Descriptor> & latticeOne, plb::MultiBlockLattice3D<U, Descriptor> & latticeTwo,
+                plb::MultiScalarField3D<int> & tags, U rhoF1, U rhoF2, U rhoNoFluid):
+                        latticeOne_(latticeOne), latticeTwo_(latticeTwo), tags_(tags),
+                        rhoF1_{rhoF1}, rhoF2_{rhoF2}, rhoNoFluid_{rhoNoFluid},
+                        oldOne_{plb::generateMultiScalarField<float>(latticeOne, latticeOne.getBoundingBox())},
+                        oldTwo_{plb::generateMultiScalarField<float>(latticeOne, latticeOne.getBoundingBox())} {
+# ifdef PLB_MPI_PARALLEL
+            MPI_Op_create(&combinePartials, 1, &combine_);
+# endif
+        };
+        ResidualMonitor(const ResidualMonitor &) = delete;
+        ResidualMonitor & operator=(const ResidualMonitor &) = delete;
+        ~ResidualMonitor() {
+# ifdef PLB_MPI_PARALLEL
+            MPI_Op_free(&combine_);
+# endif
+        }
+
+        // residuals since the last check, per time step (steps since the last check);
+        // the first check after a reset only stores the densities and returns the largest values
+        Residuals<U> check(plb::plint steps) {
+            std::vector<double> partials(numPartials, 0.);
+            std::vector<plb::MultiBlock3D *> blocks;
+            blocks.push_back(& latticeOne_);
+            blocks.push_back(& latticeTwo_);
+            blocks.push_back(& tags_);
+            blocks.push_back(oldOne_.get());
+            blocks.push_back(oldTwo_.get());
+            plb::applyProcessingFunctional(new DensityResiduals3D<U, Descriptor>(& partials, rhoF1_, rhoF2_, rhoNoFluid_),
+                    latticeOne_.getBoundingBox(), blocks);
+# ifdef PLB_MPI_PARALLEL
+            MPI_Allreduce(MPI_IN_PLACE, &partials[0], numPartials, MPI_DOUBLE, combine_,
+                    plb::global::mpi().getGlobalCommunicator());
+# endif
+            Residuals<U> residuals;
+            residuals.saturation = partials[poreNodes] > 0. ? (U) (partials[volumeOne]/partials[poreNodes]) : (U) 0.;
+            if (!hasSnapshot_) {
+                U largest = std::numeric_limits<U>::max();
+                residuals.l2F1 = residuals.l2F2 = residuals.linfF1 = residuals.linfF2 = residuals.saturationChange = largest;
+                hasSnapshot_ = true;
+            }
+            else {
+                U scale = (U) 100./(U) std::max(steps, (plb::plint) 1);
+                residuals.l2F1 = scale*(U) std::sqrt(partials[sumSqOne]/std::max(partials[sumRefOne], 1e-30));
+                residuals.l2F2 = scale*(U) std::sqrt(partials[sumSqTwo]/std::max(partials[sumRefTwo], 1e-30));
+                residuals.linfF1 = scale*(U) (partials[maxOne]/std::max(partials[maxRefOne], 1e-30));
+                residuals.linfF2 = scale*(U) (partials[maxTwo]/std::max(partials[maxRefTwo], 1e-30));
+                residuals.saturationChange = scale*std::fabs(residuals.saturation - saturation_);
+            }
+            saturation_ = residuals.saturation;
+            return residuals;
+        }
+
+        // the next check starts a new measurement (e.g. after the boundary values changed)
+        void reset() {
+            hasSnapshot_ = false;
+        }
+
+    private:
+        plb::MultiBlockLattice3D<U, Descriptor> & latticeOne_;
+        plb::MultiBlockLattice3D<U, Descriptor> & latticeTwo_;
+        plb::MultiScalarField3D<int> & tags_;
+        U rhoF1_, rhoF2_, rhoNoFluid_;
+        std::unique_ptr<plb::MultiScalarField3D<float>> oldOne_, oldTwo_;
+        bool hasSnapshot_{false};
+        U saturation_{0};
+# ifdef PLB_MPI_PARALLEL
+        MPI_Op combine_;
+# endif
+};
+
+}
+
+# endif
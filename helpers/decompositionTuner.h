@@ -0,0 +1,357 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// startup tuning of the block decomposition shared by both species lattices and the tag field
+// each candidate layout (block shape, blocks per rank) runs a few coupled shan-chen steps on
+// the real domain and solid cells; the fastest layout is cached in a text file, one line per
+// domain size and rank count: nx ny nz ranks shape blocks_per_rank
+# ifndef DECOMPOSITIONTUNER_H_
+# define DECOMPOSITIONTUNER_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+# include "./mpFunctionals.h"
+
+# include <string>
+# include <vector>
+# include <memory>
+# include <fstream>
+# include <sstream>
+# include <algorithm>
+# include <stdexcept>
+
+namespace decomposition {
+
+// cube: regular blocks split along all axes (palabos default for one block per rank)
+// pencil: the longest axis is not split
+// slab: only the longest axis is split
+// xsliced: x slabs holding the same number of active (non interior solid) cells
+struct Layout {
+    std::string shape{"cube"};
+    plb::plint blocksPerRank{1};
+};
+
+inline std::string toString(Layout const & layout) {
+    std::ostringstream name;
+    name << layout.shape << "/" << layout.blocksPerRank;
+    return name.str();
+}
+
+// adds the active (non interior solid) cells of each x slice of its domain to the counts
+class CountActivePerSlice3D : public plb::BoxProcessingFunctional3D_S<int> {
+    public:
+        CountActivePerSlice3D(std::vector<plb::plint> * counts): counts_(counts){};
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<int> & tags) {
+            plb::Dot3D location = tags.getLocation();
+            std::vector<plb::plint> & counts = *counts_;
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (tags.get(iX, iY, iZ) != 2) {
+                            ++counts[iX + location.x];
+                        }
+                    }
+                }
+            }
+        }
+        virtual CountActivePerSlice3D * clone() const {
+            return new CountActivePerSlice3D(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::nothing;
+        }
+    private:
+        std::vector<plb::plint> * counts_;
+};
+
+class DecompositionTuner {
+    public:
+        // the geometry file is read once into a distributed tag field to place the solid cells
+        // and balance the x slices; without it the candidates are timed on an all-fluid domain
+        DecompositionTuner(plb::plint nx, plb::plint ny, plb::plint nz, std::string const & geometryFile):
+                        nx_{nx}, ny_{ny}, nz_{nz}{
+            readTags(geometryFile);
+        };
+
+        // returns the cached layout of this domain size and rank count, or times all candidates
+        // on numSteps coupled steps (after one warm-up step) and caches the fastest one
+        template <typename U, template<typename V> class Descriptor>
+        Layout tune(U gc, std::vector<U> const & omegas, plb::plint numSteps, std::string const & cacheFile) {
+            Layout best;
+            if (readCache(cacheFile, best)) {
+                plb::pcout << "decomposition: " << toString(best) << " (cached in " << cacheFile << ")" << std::endl;
+                return best;
+            }
+            double bestTime{-1.};
+            std::vector<Layout> layouts = candidates();
+            for (plb::pluint iLayout = 0; iLayout < layouts.size(); ++iLayout) {
+                double time = timeSteps<U, Descriptor>(layouts[iLayout], gc, omegas, numSteps);
+                plb::pcout << "decomposition: " << toString(layouts[iLayout]) << " "
+                           << time / numSteps << " s per step" << std::endl;
+                if (bestTime < 0. || time < bestTime) {
+                    bestTime = time;
+                    best = layouts[iLayout];
+                }
+            }
+            plb::pcout << "decomposition: " << toString(best) << " selected" << std::endl;
+            writeCache(cacheFile, best);
+            return best;
+        }
+
+        // block distribution of the layout; the blocks of one rank are neighbors in the block order
+        plb::MultiBlockManagement3D createManagement(Layout const & layout, plb::plint envelopeWidth) const {
+            plb::SparseBlockStructure3D blocks = createDistribution(layout);
+            plb::ExplicitThreadAttribution * attribution = new plb::ExplicitThreadAttribution;
+            std::map<plb::plint, plb::Box3D> const & bulks = blocks.getBulks();
+            for (std::map<plb::plint, plb::Box3D>::const_iterator it = bulks.begin(); it != bulks.end(); ++it) {
+                attribution->addBlock(it->first, it->first / layout.blocksPerRank);
+            }
+            return plb::MultiBlockManagement3D(blocks, attribution, envelopeWidth);
+        }
+
+    private:
+        plb::SparseBlockStructure3D createDistribution(Layout const & layout) const {
+            plb::plint numBlocks = plb::global::mpi().getSize() * layout.blocksPerRank;
+            if (layout.shape == "cube") {
+                return plb::createRegularDistribution3D(nx_, ny_, nz_, (int) numBlocks);
+            }
+            if (layout.shape == "xsliced") {
+                if (!tags_) {
+                    throw std::invalid_argument("xsliced decomposition needs the geometry file");
+                }
+                return createXSlicedDistribution(numBlocks);
+            }
+            // pencil and slab: split along the axes ordered from the longest to the shortest
+            std::vector<plb::plint> extent{nx_, ny_, nz_};
+            std::vector<int> axes{0, 1, 2};
+            std::stable_sort(axes.begin(), axes.end(), [&extent](int a, int b) { return extent[a] > extent[b]; });
+            std::vector<plb::plint> numBlocksPerAxis(3, 1);
+            if (layout.shape == "slab") {
+                numBlocksPerAxis[axes[0]] = numBlocks;
+            }
+            else if (layout.shape == "pencil") {
+                std::vector<plb::plint> repartition = plb::algorithm::evenRepartition(numBlocks, 2);
+                std::sort(repartition.begin(), repartition.end());
+                numBlocksPerAxis[axes[1]] = repartition[1];
+                numBlocksPerAxis[axes[2]] = repartition[0];
+            }
+            else {
+                throw std::invalid_argument("unknown decomposition shape " + layout.shape +
+                        " (cube, pencil, slab or xsliced)");
+            }
+            return plb::createRegularDistribution3D(nx_, ny_, nz_,
+                    numBlocksPerAxis[0], numBlocksPerAxis[1], numBlocksPerAxis[2]);
+        }
+
+        // x slabs of about the same number of active cells, as plb::createXSlicedDistribution3D
+        // but from the per-slice counts; every slab has at least one slice and the last one ends
+        // at the end of the domain
+        plb::SparseBlockStructure3D createXSlicedDistribution(plb::plint numBlocks) const {
+            numBlocks = std::max((plb::plint) 1, std::min(numBlocks, nx_));
+            plb::plint numActiveLeft{0};
+            for (plb::plint iX = 0; iX < nx_; ++iX) {
+                numActiveLeft += activePerSlice_[iX];
+            }
+            plb::SparseBlockStructure3D blocks(nx_, ny_, nz_);
+            plb::plint iX{0};
+            for (plb::plint iBlock = 0; iBlock < numBlocks; ++iBlock) {
+                plb::plint posX = iX;
+                plb::plint numBlocksLeft = numBlocks - iBlock;
+                if (numBlocksLeft == 1) {
+                    iX = nx_;
+                }
+                else {
+                    // the target is recomputed from what is left, and one slice is kept for each following slab
+                    plb::plint numActivePerBlock = numActiveLeft / numBlocksLeft;
+                    plb::plint lastX = nx_ - numBlocksLeft;
+                    plb::plint numActiveBlock{0};
+                    do {
+                        numActiveBlock += activePerSlice_[iX];
+                        ++iX;
+                    } while (numActiveBlock < numActivePerBlock && iX <= lastX);
+                    numActiveLeft -= numActiveBlock;
+                }
+                blocks.addBlock(plb::Box3D(posX, iX - 1, 0, ny_ - 1, 0, nz_ - 1), blocks.nextIncrementalId());
+            }
+            return blocks;
+        }
+
+        // candidates whose blocks are all at least minBlockWidth cells thick
+        std::vector<Layout> candidates() const {
+            static const plb::plint minBlockWidth = 4;
+            std::vector<std::string> shapes{"cube", "pencil", "slab"};
+            if (tags_) {
+                shapes.push_back("xsliced");
+            }
+            std::vector<Layout> layouts;
+            for (plb::plint blocksPerRank = 1; blocksPerRank <= 4; blocksPerRank *= 2) {
+                for (plb::pluint iShape = 0; iShape < shapes.size(); ++iShape) {
+                    Layout layout;
+                    layout.shape = shapes[iShape];
+                    layout.blocksPerRank = blocksPerRank;
+                    plb::SparseBlockStructure3D blocks = createDistribution(layout);
+                    std::map<plb::plint, plb::Box3D> const & bulks = blocks.getBulks();
+                    bool thickEnough = (plb::plint) bulks.size() == plb::global::mpi().getSize() * blocksPerRank;
+                    for (std::map<plb::plint, plb::Box3D>::const_iterator it = bulks.begin(); it != bulks.end(); ++it) {
+                        plb::Box3D const & bulk = it->second;
+                        thickEnough = thickEnough && std::min(bulk.getNx(), std::min(bulk.getNy(), bulk.getNz())) >= minBlockWidth;
+                    }
+                    if (thickEnough) {
+                        layouts.push_back(layout);
+                    }
+                }
+            }
+            if (layouts.empty()) {
+                layouts.push_back(Layout());
+            }
+            return layouts;
+        }
+
+        // wall time of numSteps coupled steps, the largest over all ranks
+        template <typename U, template<typename V> class Descriptor>
+        double timeSteps(Layout const & layout, U gc, std::vector<U> const & omegas, plb::plint numSteps) const {
+            plb::MultiBlockManagement3D management = createManagement(layout, Descriptor<U>::vicinity);
+            plb::MultiBlockLattice3D<U, Descriptor> latticeOne(management,
+                    plb::defaultMultiBlockPolicy3D().getBlockCommunicator(),
+                    plb::defaultMultiBlockPolicy3D().getCombinedStatistics(),
+                    plb::defaultMultiBlockPolicy3D().getMultiCellAccess<U, Descriptor>(),
+                    new plb::ExternalMomentRegularizedBGKdynamics<U, Descriptor>(omegas[0]));
+            plb::MultiBlockLattice3D<U, Descriptor> latticeTwo(management,
+                    plb::defaultMultiBlockPolicy3D().getBlockCommunicator(),
+                    plb::defaultMultiBlockPolicy3D().getCombinedStatistics(),
+                    plb::defaultMultiBlockPolicy3D().getMultiCellAccess<U, Descriptor>(),
+                    new plb::ExternalMomentRegularizedBGKdynamics<U, Descriptor>(omegas[1]));
+            plb::Box3D domain = latticeOne.getBoundingBox();
+            if (tags_) {
+                plb::MultiScalarField3D<int> tags(management,
+                        plb::defaultMultiBlockPolicy3D().getBlockCommunicator(),
+                        plb::defaultMultiBlockPolicy3D().getCombinedStatistics(),
+                        plb::defaultMultiBlockPolicy3D().getMultiScalarAccess<int>(), 0);
+                plb::copy(*tags_, domain, tags, domain);
+                plb::defineSharedDynamics(latticeOne, tags, new plb::NoDynamics<U, Descriptor>(), 2);
+                plb::defineSharedDynamics(latticeTwo, tags, new plb::NoDynamics<U, Descriptor>(), 2);
+            }
+            latticeOne.setInternalTypeOfModification(plb::modif::populations);
+            latticeTwo.setInternalTypeOfModification(plb::modif::populations);
+            plb::Array<U, 3> zeroVelocity(0., 0., 0.);
+            plb::initializeAtEquilibrium(latticeOne, domain, (U) 1., zeroVelocity);
+            plb::initializeAtEquilibrium(latticeTwo, domain, (U) 0.1, zeroVelocity);
+            std::vector<plb::MultiBlockLattice3D<U, Descriptor> *> shanChenLattices{&latticeTwo, &latticeOne};
+            plb::integrateProcessingFunctional(new plb::ShanChenMultiComponentProcessor3D<U, Descriptor>(gc, omegas),
+                    domain, shanChenLattices, 1);
+            latticeOne.initialize();
+            latticeTwo.initialize();
+
+            std::vector<plb::MultiBlockLattice3D<U, Descriptor> *> species{&latticeOne, &latticeTwo};
+            plb::collideAndStream(species);
+            plb::global::mpi().barrier();
+            plb::global::timer("decomposition").restart();
+            for (plb::plint iStep = 0; iStep < numSteps; ++iStep) {
+                plb::collideAndStream(species);
+            }
+            plb::global::mpi().barrier();
+            double time = plb::global::timer("decomposition").stop();
+# ifdef PLB_MPI_PARALLEL
+            plb::global::mpi().reduceAndBcast(time, MPI_MAX);
+# endif
+            return time;
+        }
+
+        // the tags are read slice by slice into the default distribution (the geometry file runs
+        // along z fastest, then y, then x); active cells are everything but interior solids (tag 2),
+        // which carry no dynamics, and are counted per x slice over all ranks
+        void readTags(std::string const & geometryFile) {
+            std::string extension = geometryFile.size() > 4 ? geometryFile.substr(geometryFile.size() - 4) : "";
+            plb::plb_ifstream geometry(geometryFile.c_str());
+            if (extension == ".stl" || extension == ".STL" || !geometry.is_open()) {
+                plb::pcout << "decomposition: could not read " << geometryFile
+                           << ", candidates are timed without solid cells" << std::endl;
+                return;
+            }
+            std::unique_ptr<plb::MultiScalarField3D<int>> tags(new plb::MultiScalarField3D<int>(nx_, ny_, nz_));
+            plb::Box3D sliceBox(0, 0, 0, ny_ - 1, 0, nz_ - 1);
+            std::unique_ptr<plb::MultiScalarField3D<int>> slice = plb::generateMultiScalarField<int>(*tags, sliceBox);
+            for (plb::plint iX = 0; iX < nx_; ++iX) {
+                geometry >> *slice;
+                plb::copy(*slice, slice->getBoundingBox(), *tags, plb::Box3D(iX, iX, 0, ny_ - 1, 0, nz_ - 1));
+            }
+            int isRead = geometry.getOriginalStream().fail() ? 0 : 1;
+            plb::global::mpi().bCast(&isRead, 1);
+            if (!isRead) {
+                plb::pcout << "decomposition: could not read " << geometryFile
+                           << ", candidates are timed without solid cells" << std::endl;
+                return;
+            }
+            activePerSlice_.assign(nx_, 0);
+            plb::applyProcessingFunctional(new CountActivePerSlice3D(&activePerSlice_), tags->getBoundingBox(), *tags);
+# ifdef PLB_MPI_PARALLEL
+            plb::global::mpi().allReduceVect(activePerSlice_, MPI_SUM);
+# endif
+            tags_.swap(tags);
+        }
+
+        std::string cacheKey() const {
+            std::ostringstream key;
+            key << nx_ << " " << ny_ << " " << nz_ << " " << plb::global::mpi().getSize();
+            return key.str();
+        }
+
+        // the main processor reads the cache; the layout found (if any) is broadcast
+        bool readCache(std::string const & cacheFile, Layout & layout) const {
+            std::string cached;
+            if (plb::global::mpi().isMainProcessor()) {
+                std::ifstream cache(cacheFile.c_str());
+                std::string line;
+                std::string key = cacheKey() + " ";
+                while (std::getline(cache, line)) {
+                    if (line.compare(0, key.size(), key) == 0) {
+                        // the last entry of a key wins
+                        cached = line.substr(key.size());
+                    }
+                }
+            }
+            plb::global::mpi().bCast(cached);
+            if (cached.empty()) {
+                return false;
+            }
+            std::istringstream entry(cached);
+            entry >> layout.shape >> layout.blocksPerRank;
+            if (!entry || layout.blocksPerRank <= 0) {
+                return false;
+            }
+            if (layout.shape == "xsliced" && !tags_) {
+                return false;
+            }
+            return true;
+        }
+
+        void writeCache(std::string const & cacheFile, Layout const & layout) const {
+            if (plb::global::mpi().isMainProcessor()) {
+                std::ofstream cache(cacheFile.c_str(), std::ios::app);
+                cache << cacheKey() << " " << layout.shape << " " << layout.blocksPerRank << std::endl;
+            }
+        }
+
+        plb::plint nx_{0}, ny_{0}, nz_{0};
+        std::unique_ptr<plb::MultiScalarField3D<int>> tags_;
+        std::vector<plb::plint> activePerSlice_;
+};
+
+}
+
+# endif
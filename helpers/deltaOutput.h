@@ -0,0 +1,345 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// incremental (delta) output of the fluid densities
+// at every output step only the blocks that changed by more than a tolerance since their
+// last written version are appended to the binary stream delta_fields.bin; the text index
+// delta_index.dat references, for every step, the record of each block that holds its
+// current values, so that any step can be reconstructed from the stream
+// record: int64 step, int64 number of pieces; per piece int64 block id, int64 x0 x1 y0 y1 z0 z1
+// followed by float64 values of fluid one and then of fluid two (x fastest, then y, then z)
+// index: the domain and the block boxes, then per step a line "step <step> <written pieces>"
+// followed by one line with the step of the version and the piece offset of every block
+# ifndef DELTAOUTPUT_H_
+# define DELTAOUTPUT_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+
+# include <string>
+# include <vector>
+# include <map>
+# include <fstream>
+# include <sstream>
+# include <cstdint>
+# include <cstring>
+# include <cmath>
+# include <algorithm>
+# include <stdexcept>
+
+namespace deltaoutput {
+
+template <typename V>
+void appendValue(std::vector<char> & buffer, V value) {
+    std::size_t pos = buffer.size();
+    buffer.resize(pos + sizeof(V));
+    std::memcpy(&buffer[pos], &value, sizeof(V));
+}
+
+# ifdef PLB_MPI_PARALLEL
+// collective write of the local buffer at the given offset, in pieces of at most 1 GiB
+// (the count of MPI_File_write_at_all is an int); every process takes part in as many
+// writes as the process with the largest buffer
+inline void writeAtAll(MPI_File file, MPI_Offset offset, std::vector<char> & buffer) {
+    long long const maxPiece = 1LL << 30;
+    long long localSize = (long long) buffer.size();
+    long long numWrites = (localSize + maxPiece - 1) / maxPiece;
+    MPI_Allreduce(MPI_IN_PLACE, &numWrites, 1, MPI_LONG_LONG, MPI_MAX, plb::global::mpi().getGlobalCommunicator());
+    char dummy{0};
+    for (long long iWrite = 0; iWrite < numWrites; ++iWrite) {
+        long long begin = std::min(iWrite*maxPiece, localSize);
+        int count = (int) std::min(maxPiece, localSize - begin);
+        MPI_File_write_at_all(file, offset + (MPI_Offset) begin, count > 0 ? &buffer[begin] : &dummy,
+                              count, MPI_CHAR, MPI_STATUS_IGNORE);
+    }
+}
+# endif
+
+// bulk values of one block of a scalar field, x fastest
+template <typename U>
+void extractBulk(plb::MultiScalarField3D<U> & field, plb::plint blockId, plb::Box3D const & bulk,
+        std::vector<double> & values) {
+    plb::ScalarField3D<U> const & block = field.getComponent(blockId);
+    plb::Dot3D location = block.getLocation();
+    for (plb::plint iZ = bulk.z0; iZ <= bulk.z1; ++iZ) {
+        for (plb::plint iY = bulk.y0; iY <= bulk.y1; ++iY) {
+            for (plb::plint iX = bulk.x0; iX <= bulk.x1; ++iX) {
+                values.push_back((double) block.get(iX - location.x, iY - location.y, iZ - location.z));
+            }
+        }
+    }
+}
+
+// the delta stream of one simulation; the densities must share the block structure given
+// to the constructor
+class DeltaStream {
+    public:
+        DeltaStream(std::string const & outputDir, plb::MultiBlockManagement3D const & management, double tolerance):
+                        tolerance_{tolerance} {
+            std::map<plb::plint, plb::Box3D> const & bulks = management.getSparseBlockStructure().getBulks();
+            for (std::map<plb::plint, plb::Box3D>::const_iterator it = bulks.begin(); it != bulks.end(); ++it) {
+                position_[it->first] = (plb::plint) blockIds_.size();
+                blockIds_.push_back(it->first);
+                boxes_.push_back(it->second);
+            }
+            localBlocks_ = management.getLocalInfo().getBlocks();
+            version_.assign(blockIds_.size(), -1);
+            offset_.assign(blockIds_.size(), -1);
+
+            std::string fileName = outputDir + "delta_fields.bin";
+# ifdef PLB_MPI_PARALLEL
+            MPI_Comm comm = plb::global::mpi().getGlobalCommunicator();
+            if (plb::global::mpi().isMainProcessor()) {
+                MPI_File_delete(fileName.c_str(), MPI_INFO_NULL);
+            }
+            plb::global::mpi().barrier();
+            int err = MPI_File_open(comm, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file_);
+            if (err != MPI_SUCCESS) {
+                throw std::runtime_error("could not open delta stream " + fileName);
+            }
+# else
+            file_.open(fileName.c_str(), std::ios::binary | std::ios::trunc);
+# endif
+            writeIndexHeader(outputDir + "delta_index.dat", management.getBoundingBox());
+        }
+        DeltaStream(const DeltaStream &) = delete;
+        DeltaStream & operator=(const DeltaStream &) = delete;
+        ~DeltaStream() {
+# ifdef PLB_MPI_PARALLEL
+            MPI_File_close(&file_);
+# endif
+        }
+
+        // collective: appends the changed blocks of this step and its line of the index
+        template <typename U>
+        void write(plb::plint step, plb::MultiScalarField3D<U> & densityOne, plb::MultiScalarField3D<U> & densityTwo) {
+            std::vector<char> buffer;
+            std::vector<plb::plint> pieceStart, piecePosition;
+            bool isMain = plb::global::mpi().isMainProcessor();
+            if (isMain) {
+                appendValue<std::int64_t>(buffer, step);
+                appendValue<std::int64_t>(buffer, 0);
+            }
+            for (plb::pluint iBlock = 0; iBlock < localBlocks_.size(); ++iBlock) {
+                plb::plint blockId = localBlocks_[iBlock];
+                plb::Box3D const & bulk = boxes_[position_[blockId]];
+                std::vector<double> values;
+                extractBulk(densityOne, blockId, bulk, values);
+                extractBulk(densityTwo, blockId, bulk, values);
+                std::vector<double> & written = written_[blockId];
+                if (!written.empty() && maxDelta(values, written) <= tolerance_) {
+                    continue;
+                }
+                written.swap(values);
+                pieceStart.push_back((plb::plint) buffer.size());
+                piecePosition.push_back(position_[blockId]);
+                appendValue<std::int64_t>(buffer, blockId);
+                appendValue<std::int64_t>(buffer, bulk.x0);
+                appendValue<std::int64_t>(buffer, bulk.x1);
+                appendValue<std::int64_t>(buffer, bulk.y0);
+                appendValue<std::int64_t>(buffer, bulk.y1);
+                appendValue<std::int64_t>(buffer, bulk.z0);
+                appendValue<std::int64_t>(buffer, bulk.z1);
+                for (plb::pluint iV = 0; iV < written.size(); ++iV) {
+                    appendValue<double>(buffer, written[iV]);
+                }
+                version_[position_[blockId]] = step;
+            }
+            plb::plint numPieces = (plb::plint) pieceStart.size();
+# ifdef PLB_MPI_PARALLEL
+            plb::global::mpi().reduceAndBcast(numPieces, MPI_SUM);
+# endif
+            if (isMain) {
+                std::int64_t totalPieces = numPieces;
+                std::memcpy(&buffer[sizeof(std::int64_t)], &totalPieces, sizeof(std::int64_t));
+            }
+
+            long long localOffset{0};
+# ifdef PLB_MPI_PARALLEL
+            long long localSize = (long long) buffer.size(), recordSize{localSize};
+            MPI_Comm comm = plb::global::mpi().getGlobalCommunicator();
+            MPI_Exscan(&localSize, &localOffset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+            if (isMain) {
+                localOffset = 0;
+            }
+            MPI_Allreduce(&localSize, &recordSize, 1, MPI_LONG_LONG, MPI_SUM, comm);
+            writeAtAll(file_, (MPI_Offset) (streamOffset_ + localOffset), buffer);
+# else
+            long long recordSize = (long long) buffer.size();
+            file_.write(&buffer[0], buffer.size());
+            file_.flush();
+# endif
+            for (plb::pluint iPiece = 0; iPiece < pieceStart.size(); ++iPiece) {
+                offset_[piecePosition[iPiece]] = streamOffset_ + localOffset + pieceStart[iPiece];
+            }
+            streamOffset_ += recordSize;
+            writeIndexStep(step, numPieces);
+        }
+
+    private:
+        static double maxDelta(std::vector<double> const & values, std::vector<double> const & written) {
+            double delta{0};
+            for (plb::pluint iV = 0; iV < values.size(); ++iV) {
+                delta = std::max(delta, std::fabs(values[iV] - written[iV]));
+            }
+            return delta;
+        }
+
+        void writeIndexHeader(std::string const & fileName, plb::Box3D const & domain) {
+            if (plb::global::mpi().isMainProcessor()) {
+                index_.open(fileName.c_str(), std::ios::trunc);
+                index_ << "domain: " << domain.getNx() << " " << domain.getNy() << " " << domain.getNz() << std::endl;
+                index_ << "fields: f1_density f2_density" << std::endl;
+                index_ << "tolerance: " << tolerance_ << std::endl;
+                index_ << "blocks: " << blockIds_.size() << std::endl;
+                for (plb::pluint iB = 0; iB < boxes_.size(); ++iB) {
+                    plb::Box3D const & box = boxes_[iB];
+                    index_ << blockIds_[iB] << " " << box.x0 << " " << box.x1 << " " << box.y0 << " " << box.y1
+                           << " " << box.z0 << " " << box.z1 << std::endl;
+                }
+            }
+        }
+
+        // the versions and offsets of the blocks are gathered on the main process
+        void writeIndexStep(plb::plint step, plb::plint numPieces) {
+            std::vector<long long> local(2*blockIds_.size(), 0), global(2*blockIds_.size(), 0);
+            for (plb::pluint iBlock = 0; iBlock < localBlocks_.size(); ++iBlock) {
+                plb::plint pos = position_[localBlocks_[iBlock]];
+                local[2*pos] = version_[pos];
+                local[2*pos + 1] = offset_[pos];
+            }
+# ifdef PLB_MPI_PARALLEL
+            plb::global::mpi().reduceVect(local, global, MPI_SUM);
+# else
+            global = local;
+# endif
+            if (plb::global::mpi().isMainProcessor()) {
+                index_ << "step " << step << " " << numPieces << std::endl;
+                for (plb::pluint iB = 0; iB < blockIds_.size(); ++iB) {
+                    index_ << (iB > 0 ? " " : "") << global[2*iB] << " " << global[2*iB + 1];
+                }
+                index_ << std::endl;
+            }
+        }
+
+        double tolerance_;
+        std::vector<plb::plint> blockIds_, localBlocks_;
+        std::vector<plb::Box3D> boxes_;
+        std::map<plb::plint, plb::plint> position_;
+        // step and stream offset of the last written version of every block (local blocks only)
+        std::vector<plb::plint> version_;
+        std::vector<long long> offset_;
+        std::map<plb::plint, std::vector<double> > written_;
+        long long streamOffset_{0};
+        std::ofstream index_;
+# ifdef PLB_MPI_PARALLEL
+        MPI_File file_;
+# else
+        std::ofstream file_;
+# endif
+};
+
+// one step of delta_index.dat: the box and the piece offset of every block
+struct StepIndex {
+    plb::plint nx{0}, ny{0}, nz{0};
+    std::vector<plb::Box3D> boxes;
+    std::vector<long long> offsets;
+};
+
+// reads the index entry of a step (the last one if the step was written more than once);
+// returns false if the step was not written
+inline bool readStepIndex(std::string const & fileName, plb::plint step, StepIndex & stepIndex) {
+    std::ifstream index(fileName.c_str());
+    std::string word;
+    plb::plint numBlocks{0};
+    index >> word >> stepIndex.nx >> stepIndex.ny >> stepIndex.nz;
+    std::getline(index, word);
+    std::getline(index, word);
+    std::getline(index, word);
+    index >> word >> numBlocks;
+    stepIndex.boxes.resize(numBlocks);
+    for (plb::plint iB = 0; iB < numBlocks; ++iB) {
+        plb::plint blockId;
+        plb::Box3D & box = stepIndex.boxes[iB];
+        index >> blockId >> box.x0 >> box.x1 >> box.y0 >> box.y1 >> box.z0 >> box.z1;
+    }
+    plb::plint currentStep{0}, numPieces{0};
+    bool found{false};
+    std::vector<long long> offsets(numBlocks);
+    while (index >> word >> currentStep >> numPieces) {
+        for (plb::plint iB = 0; iB < numBlocks; ++iB) {
+            long long version;
+            index >> version >> offsets[iB];
+        }
+        if (currentStep == step) {
+            stepIndex.offsets = offsets;
+            found = true;
+        }
+    }
+    return found;
+}
+
+// fills the densities of one step from the pieces that overlap each block of the output fields
+// (every process reads the pieces of its own blocks)
+template <typename U>
+class ReadDeltaStep3D : public plb::BoxProcessingFunctional3D_SS<U, U> {
+    public:
+        ReadDeltaStep3D(std::string const & fileName, StepIndex const & stepIndex):
+                        fileName_(fileName), stepIndex_(stepIndex) {};
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<U> & densityOne, plb::ScalarField3D<U> & densityTwo) {
+            std::ifstream file(fileName_.c_str(), std::ios::binary);
+            plb::Dot3D location = densityOne.getLocation();
+            plb::Dot3D ofsTwo = plb::computeRelativeDisplacement(densityOne, densityTwo);
+            plb::Box3D absolute = domain.shift(location.x, location.y, location.z);
+            for (plb::pluint iB = 0; iB < stepIndex_.boxes.size(); ++iB) {
+                plb::Box3D const & box = stepIndex_.boxes[iB];
+                plb::Box3D overlap;
+                if (!plb::intersect(box, absolute, overlap)) {
+                    continue;
+                }
+                plb::plint numCells = box.nCells();
+                std::vector<double> values(2*numCells);
+                file.seekg((std::streamoff) (stepIndex_.offsets[iB] + 7*sizeof(std::int64_t)));
+                file.read((char *) &values[0], (std::streamsize) (values.size()*sizeof(double)));
+                for (plb::plint iZ = overlap.z0; iZ <= overlap.z1; ++iZ) {
+                    for (plb::plint iY = overlap.y0; iY <= overlap.y1; ++iY) {
+                        for (plb::plint iX = overlap.x0; iX <= overlap.x1; ++iX) {
+                            plb::plint iV = ((iZ - box.z0)*box.getNy() + (iY - box.y0))*box.getNx() + (iX - box.x0);
+                            plb::plint lX = iX - location.x, lY = iY - location.y, lZ = iZ - location.z;
+                            densityOne.get(lX, lY, lZ) = (U) values[iV];
+                            densityTwo.get(lX + ofsTwo.x, lY + ofsTwo.y, lZ + ofsTwo.z) = (U) values[numCells + iV];
+                        }
+                    }
+                }
+            }
+        }
+        virtual ReadDeltaStep3D<U> * clone() const {
+            return new ReadDeltaStep3D<U>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::staticVariables;
+        }
+    private:
+        std::string fileName_;
+        StepIndex stepIndex_;
+};
+
+}
+
+# endif
@@ -0,0 +1,77 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// per-block fluid-cell lists for porous blocks
+// interior solid nodes (tag 2) carry no dynamics and only touch solid nodes, so their populations
+// never reach a fluid node: in blocks with little pore space, collision-streaming and the Shan-Chen
+// coupling iterate over a list of the void and surface nodes instead of the whole block
+// (see BlockLattice3D::setActiveCells). the list is read off the dynamics the tags assigned, which
+// also covers the envelope of each block
+# ifndef FLUIDCELLLISTS_H_
+# define FLUIDCELLLISTS_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+
+# include <vector>
+
+namespace fluidcells {
+
+// sets the list of active cells on every local block whose fraction of active cells is at most
+// maxFraction (all lattices share one block decomposition and their solid nodes); the other blocks
+// keep the loops over all cells. returns the number of blocks (on all processes) with a list
+template <typename U, template<typename V> class Descriptor>
+plb::plint setFluidCellLists(std::vector<plb::MultiBlockLattice3D<U, Descriptor> *> const & lattices, U maxFraction) {
+    plb::MultiBlockLattice3D<U, Descriptor> & first = *lattices[0];
+    std::vector<plb::plint> const & blocks = first.getLocalInfo().getBlocks();
+    plb::plint numListBlocks{0};
+    for (plb::pluint iBlock = 0; iBlock < blocks.size(); ++iBlock) {
+        plb::plint blockId = blocks[iBlock];
+        plb::BlockLattice3D<U, Descriptor> & block = first.getComponent(blockId);
+        std::vector<plb::Dot3D> cells;
+        for (plb::plint iX = 0; iX < block.getNx(); ++iX) {
+            for (plb::plint iY = 0; iY < block.getNy(); ++iY) {
+                for (plb::plint iZ = 0; iZ < block.getNz(); ++iZ) {
+                    if (!dynamic_cast<plb::NoDynamics<U, Descriptor> const *>(&block.get(iX, iY, iZ).getDynamics())) {
+                        cells.push_back(plb::Dot3D(iX, iY, iZ));
+                    }
+                }
+            }
+        }
+        bool useList = (U) cells.size() <= maxFraction*(U) (block.getNx()*block.getNy()*block.getNz());
+        for (plb::pluint iL = 0; iL < lattices.size(); ++iL) {
+            if (useList) {
+                lattices[iL]->getComponent(blockId).setActiveCells(cells);
+            }
+            else {
+                lattices[iL]->getComponent(blockId).clearActiveCells();
+            }
+        }
+        if (useList) {
+            ++numListBlocks;
+        }
+    }
+# ifdef PLB_MPI_PARALLEL
+    plb::global::mpi().reduceAndBcast(numListBlocks, MPI_SUM);
+# endif
+    return numListBlocks;
+}
+
+}
+
+# endif
@@ -0,0 +1,112 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// helpers of the single-lattice free-surface engine: free-surface flags from the tag field and
+// the liquid reservoirs at the boundary planes
+// tag convention as in mpFunctionals.h: 0 void, 1 surface solid, 2 interior solid, 3 invading fluid
+# ifndef FREESURFACEFUNCTIONALS_H_
+# define FREESURFACEFUNCTIONALS_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+# include "./mpFunctionals.h"
+
+# include <algorithm>
+# include <vector>
+
+namespace freesurface {
+
+// free-surface flags: solid nodes (1 and 2) are walls, nodes with the liquid tag are fluid and
+// all other void nodes are gas (empty); the interface layer is added by
+// FreeSurfaceFields3D::defaultInitialize()
+// blocks: tag field, flag field
+class FlagsFromTags3D : public plb::BoxProcessingFunctional3D_SS<int, int> {
+    public:
+        FlagsFromTags3D(int liquidTag):liquidTag_{liquidTag}{};
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<int> & tags, plb::ScalarField3D<int> & flag) {
+            plb::Dot3D ofs = plb::computeRelativeDisplacement(tags, flag);
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        int tag = tags.get(iX, iY, iZ);
+                        int & nodeFlag = flag.get(iX + ofs.x, iY + ofs.y, iZ + ofs.z);
+                        if (mpfunctionals::isSolidTag(tag)) {
+                            nodeFlag = plb::freeSurfaceFlag::wall;
+                        }
+                        else if (tag == liquidTag_) {
+                            nodeFlag = plb::freeSurfaceFlag::fluid;
+                        }
+                        else {
+                            nodeFlag = plb::freeSurfaceFlag::empty;
+                        }
+                    }
+                }
+            }
+        }
+        virtual FlagsFromTags3D * clone() const {
+            return new FlagsFromTags3D(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::nothing;
+            modified[1] = plb::modif::staticVariables;
+        }
+    private:
+        int liquidTag_;
+};
+
+// liquid reservoir at a fixed density: the fluid nodes of the domain are reset to equilibrium at
+// rho with their current momentum; interface and gas nodes are left to the free-surface model
+// blocks: the free-surface arguments (FreeSurfaceFields3D::freeSurfaceArgs)
+template <typename U, template<typename V> class Descriptor>
+class FixedLiquidDensity3D : public plb::BoxProcessingFunctional3D {
+    public:
+        FixedLiquidDensity3D(U rho):rho_{rho}{};
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            plb::FreeSurfaceProcessorParam3D<U, Descriptor> param(blocks);
+            U rhoBar = Descriptor<U>::rhoBar(rho_);
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (param.flag(iX, iY, iZ) != plb::freeSurfaceFlag::fluid) {
+                            continue;
+                        }
+                        plb::Array<U, 3> j = param.getMomentum(iX, iY, iZ);
+                        plb::Cell<U, Descriptor> & cell = param.cell(iX, iY, iZ);
+                        cell.getDynamics().computeEquilibria(cell.getRawPopulations(), rhoBar, j, plb::normSqr(j), U());
+                        param.setDensity(iX, iY, iZ, rho_);
+                        param.mass(iX, iY, iZ) = rho_;
+                    }
+                }
+            }
+        }
+        virtual FixedLiquidDensity3D<U, Descriptor> * clone() const {
+            return new FixedLiquidDensity3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            std::fill(modified.begin(), modified.end(), plb::modif::nothing);
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::staticVariables;
+            modified[3] = plb::modif::staticVariables;
+        }
+    private:
+        U rho_;
+};
+
+}
+
+# endif
@@ -24,5 +24,9 @@
 
 int runMultiPhaseMultiComponent(const std::string &);
 int runMultiPhaseSingleComponent(const std::string &);
+// rebuilds one step of the delta output in an output directory
+int reconstructDeltaOutput(const std::string &, plint);
+// compares the vectorized and the cell-by-cell fluid collision on a random block
+int checkVectorizedCollision();
 
 # endif 
\ No newline at end of file
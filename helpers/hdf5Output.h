@@ -0,0 +1,263 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// parallel HDF5 output of one output step: all fields go into a single file written
+// collectively by the processes that own the blocks, plus an XDMF sidecar for ParaView
+// datasets are stored x-fastest (dimensions nz, ny, nx) so the XDMF axes match the VTK output
+// available when the code is built with ENABLE_HDF5 (parallel HDF5 library)
+# ifndef HDF5OUTPUT_H_
+# define HDF5OUTPUT_H_
+
+# ifdef HDF5
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+# include "hdf5.h"
+
+# include <string>
+# include <vector>
+# include <fstream>
+# include <stdexcept>
+# include <limits>
+# include <map>
+# include <algorithm>
+
+namespace hdf5output {
+
+template <typename U> hid_t nativeType();
+template <> inline hid_t nativeType<double>() { return H5T_NATIVE_DOUBLE; }
+template <> inline hid_t nativeType<float>() { return H5T_NATIVE_FLOAT; }
+template <> inline hid_t nativeType<int>() { return H5T_NATIVE_INT; }
+
+// cell data of one field on the blocks owned by this process
+struct LocalField {
+    std::string name;
+    plb::plint dim{1};
+    hid_t type{0};
+    plb::plint elementSize{0};
+    std::string numberType{"Float"};
+    std::vector<plb::Box3D> boxes;
+    std::vector<std::vector<char> > data;
+};
+
+template <typename U>
+void initLocalField(LocalField & local, std::string const & name, plb::plint dim) {
+    local.name = name;
+    local.dim = dim;
+    local.type = nativeType<U>();
+    local.elementSize = sizeof(U);
+    local.numberType = std::numeric_limits<U>::is_integer ? "Int" : "Float";
+}
+
+template <typename U>
+LocalField extractLocalField(plb::MultiScalarField3D<U> & field, std::string const & name) {
+    LocalField local;
+    initLocalField<U>(local, name, 1);
+    plb::MultiBlockManagement3D const & management = field.getMultiBlockManagement();
+    std::vector<plb::plint> const & blocks = management.getLocalInfo().getBlocks();
+    for (plb::pluint iBlock = 0; iBlock < blocks.size(); ++iBlock) {
+        plb::Box3D bulk;
+        management.getSparseBlockStructure().getBulk(blocks[iBlock], bulk);
+        plb::ScalarField3D<U> const & block = field.getComponent(blocks[iBlock]);
+        plb::Dot3D location = block.getLocation();
+        std::vector<char> buffer(bulk.nCells() * sizeof(U));
+        U * values = reinterpret_cast<U *>(&buffer[0]);
+        for (plb::plint iZ = bulk.z0; iZ <= bulk.z1; ++iZ) {
+            for (plb::plint iY = bulk.y0; iY <= bulk.y1; ++iY) {
+                for (plb::plint iX = bulk.x0; iX <= bulk.x1; ++iX) {
+                    *values++ = block.get(iX - location.x, iY - location.y, iZ - location.z);
+                }
+            }
+        }
+        local.boxes.push_back(bulk);
+        local.data.push_back(buffer);
+    }
+    return local;
+}
+
+template <typename U, int nDim>
+LocalField extractLocalField(plb::MultiTensorField3D<U, nDim> & field, std::string const & name) {
+    LocalField local;
+    initLocalField<U>(local, name, nDim);
+    plb::MultiBlockManagement3D const & management = field.getMultiBlockManagement();
+    std::vector<plb::plint> const & blocks = management.getLocalInfo().getBlocks();
+    for (plb::pluint iBlock = 0; iBlock < blocks.size(); ++iBlock) {
+        plb::Box3D bulk;
+        management.getSparseBlockStructure().getBulk(blocks[iBlock], bulk);
+        plb::TensorField3D<U, nDim> const & block = field.getComponent(blocks[iBlock]);
+        plb::Dot3D location = block.getLocation();
+        std::vector<char> buffer(bulk.nCells() * nDim * sizeof(U));
+        U * values = reinterpret_cast<U *>(&buffer[0]);
+        for (plb::plint iZ = bulk.z0; iZ <= bulk.z1; ++iZ) {
+            for (plb::plint iY = bulk.y0; iY <= bulk.y1; ++iY) {
+                for (plb::plint iX = bulk.x0; iX <= bulk.x1; ++iX) {
+                    plb::Array<U, nDim> const & value = block.get(iX - location.x, iY - location.y, iZ - location.z);
+                    for (int iD = 0; iD < nDim; ++iD) {
+                        *values++ = value[iD];
+                    }
+                }
+            }
+        }
+        local.boxes.push_back(bulk);
+        local.data.push_back(buffer);
+    }
+    return local;
+}
+
+// file dimensions of a field: slowest first, the component index last
+inline std::vector<hsize_t> fieldDims(LocalField const & field, plb::Box3D const & domain) {
+    std::vector<hsize_t> dims = {(hsize_t) domain.getNz(), (hsize_t) domain.getNy(), (hsize_t) domain.getNx()};
+    if (field.dim > 1) {
+        dims.push_back((hsize_t) field.dim);
+    }
+    return dims;
+}
+
+inline std::string fileBaseName(std::string const & path) {
+    std::string::size_type pos = path.find_last_of('/');
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+// the XDMF sidecar (written by the main process only)
+inline void writeXdmf(std::string const & xdmfFile, std::string const & h5File,
+        std::vector<LocalField> const & fields, plb::Box3D const & domain) {
+    if (!plb::global::mpi().isMainProcessor()) {
+        return;
+    }
+    std::ofstream xdmf(xdmfFile.c_str());
+    xdmf << "<?xml version=\"1.0\" ?>\n";
+    xdmf << "<Xdmf Version=\"2.0\">\n";
+    xdmf << "  <Domain>\n";
+    xdmf << "    <Grid Name=\"fields\" GridType=\"Uniform\">\n";
+    xdmf << "      <Topology TopologyType=\"3DCoRectMesh\" Dimensions=\""
+         << domain.getNz() + 1 << " " << domain.getNy() + 1 << " " << domain.getNx() + 1 << "\"/>\n";
+    xdmf << "      <Geometry GeometryType=\"ORIGIN_DXDYDZ\">\n";
+    xdmf << "        <DataItem Dimensions=\"3\" NumberType=\"Float\" Format=\"XML\">0 0 0</DataItem>\n";
+    xdmf << "        <DataItem Dimensions=\"3\" NumberType=\"Float\" Format=\"XML\">1 1 1</DataItem>\n";
+    xdmf << "      </Geometry>\n";
+    for (plb::pluint iField = 0; iField < fields.size(); ++iField) {
+        LocalField const & field = fields[iField];
+        std::vector<hsize_t> dims = fieldDims(field, domain);
+        xdmf << "      <Attribute Name=\"" << field.name << "\" AttributeType=\""
+             << (field.dim > 1 ? "Vector" : "Scalar") << "\" Center=\"Cell\">\n";
+        xdmf << "        <DataItem Dimensions=\"";
+        for (plb::pluint iD = 0; iD < dims.size(); ++iD) {
+            xdmf << (iD > 0 ? " " : "") << dims[iD];
+        }
+        xdmf << "\" NumberType=\"" << field.numberType << "\" Precision=\"" << field.elementSize
+             << "\" Format=\"HDF\">" << fileBaseName(h5File) << ":/" << field.name << "</DataItem>\n";
+        xdmf << "      </Attribute>\n";
+    }
+    xdmf << "    </Grid>\n";
+    xdmf << "  </Domain>\n";
+    xdmf << "</Xdmf>\n";
+}
+
+// writes fileName.h5 and fileName.xmf; collective over all processes
+// the chunks of every dataset have the extent of the largest block, so that a
+// block is written to (at most a few) whole chunks
+inline void writeStep(std::string const & fileName, plb::MultiBlockManagement3D const & management,
+        std::vector<LocalField> const & fields) {
+    std::string h5File = fileName + ".h5";
+    plb::Box3D domain = management.getBoundingBox();
+    MPI_Comm comm = plb::global::mpi().getGlobalCommunicator();
+
+    std::map<plb::plint, plb::Box3D> const & bulks = management.getSparseBlockStructure().getBulks();
+    hsize_t chunk[3] = {1, 1, 1};
+    for (std::map<plb::plint, plb::Box3D>::const_iterator it = bulks.begin(); it != bulks.end(); ++it) {
+        chunk[0] = std::max(chunk[0], (hsize_t) it->second.getNz());
+        chunk[1] = std::max(chunk[1], (hsize_t) it->second.getNy());
+        chunk[2] = std::max(chunk[2], (hsize_t) it->second.getNx());
+    }
+
+    // every process takes part in each collective write, also with fewer (or no) blocks
+    int numWrites{0};
+    for (plb::pluint iField = 0; iField < fields.size(); ++iField) {
+        numWrites = std::max(numWrites, (int) fields[iField].boxes.size());
+    }
+    plb::global::mpi().reduceAndBcast(numWrites, MPI_MAX);
+
+    hid_t accessList = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(accessList, comm, MPI_INFO_NULL);
+    hid_t file = H5Fcreate(h5File.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, accessList);
+    H5Pclose(accessList);
+    if (file < 0) {
+        throw std::runtime_error("could not create HDF5 file " + h5File);
+    }
+    hid_t transferList = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(transferList, H5FD_MPIO_COLLECTIVE);
+
+    for (plb::pluint iField = 0; iField < fields.size(); ++iField) {
+        LocalField const & field = fields[iField];
+        std::vector<hsize_t> dims = fieldDims(field, domain);
+        std::vector<hsize_t> chunkDims(chunk, chunk + 3);
+        for (plb::pluint iD = 0; iD < 3; ++iD) {
+            chunkDims[iD] = std::min(chunkDims[iD], dims[iD]);
+        }
+        if (field.dim > 1) {
+            chunkDims.push_back((hsize_t) field.dim);
+        }
+        hid_t fileSpace = H5Screate_simple((int) dims.size(), &dims[0], NULL);
+        hid_t createList = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(createList, (int) chunkDims.size(), &chunkDims[0]);
+        hid_t dataset = H5Dcreate2(file, field.name.c_str(), field.type, fileSpace,
+                                   H5P_DEFAULT, createList, H5P_DEFAULT);
+        H5Pclose(createList);
+
+        char dummy{0};
+        for (int iWrite = 0; iWrite < numWrites; ++iWrite) {
+            hid_t memSpace;
+            void const * buffer = &dummy;
+            if (iWrite < (int) field.boxes.size()) {
+                plb::Box3D const & box = field.boxes[iWrite];
+                std::vector<hsize_t> offset = {(hsize_t) (box.z0 - domain.z0), (hsize_t) (box.y0 - domain.y0),
+                                               (hsize_t) (box.x0 - domain.x0)};
+                std::vector<hsize_t> count = {(hsize_t) box.getNz(), (hsize_t) box.getNy(), (hsize_t) box.getNx()};
+                if (field.dim > 1) {
+                    offset.push_back(0);
+                    count.push_back((hsize_t) field.dim);
+                }
+                H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &offset[0], NULL, &count[0], NULL);
+                memSpace = H5Screate_simple((int) count.size(), &count[0], NULL);
+                buffer = &field.data[iWrite][0];
+            }
+            else {
+                H5Sselect_none(fileSpace);
+                memSpace = H5Screate_simple((int) dims.size(), &dims[0], NULL);
+                H5Sselect_none(memSpace);
+            }
+            herr_t status = H5Dwrite(dataset, field.type, memSpace, fileSpace, transferList, buffer);
+            H5Sclose(memSpace);
+            if (status < 0) {
+                plb::pcout << "Error: HDF5 write of " << field.name << " to " << h5File << " failed" << std::endl;
+            }
+        }
+        H5Dclose(dataset);
+        H5Sclose(fileSpace);
+    }
+    H5Pclose(transferList);
+    H5Fclose(file);
+
+    writeXdmf(fileName + ".xmf", h5File, fields, domain);
+}
+
+}
+
+# endif
+
+# endif
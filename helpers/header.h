@@ -44,4 +44,5 @@ const double sigma = 0.15;
 
 # define MPDESCRIPTOR descriptors::ForcedShanChenD3Q19Descriptor
 # define SPDESCRIPTOR descriptors::D3Q19Descriptor 
+# define FSDESCRIPTOR descriptors::ForcedD3Q19Descriptor
 # endif 
\ No newline at end of file
@@ -0,0 +1,140 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// preprocessing of segmented tomography images into solver-ready tag fields
+// tag convention as in mpFunctionals.h: 0 void, 1 surface solid, 2 interior solid, 3 invading fluid
+# ifndef MICROSTRUCTUREPREP_H_
+# define MICROSTRUCTUREPREP_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+
+# include <fstream>
+# include <string>
+# include <vector>
+
+namespace microstructure {
+
+// raw volume of unsigned 8 or 16 bit voxels without header, x fastest, then y, then z;
+// 16 bit voxels are little endian
+struct RawImage {
+    std::string fileName{};
+    plb::plint nx{0}, ny{0}, nz{0};
+    plb::plint bytesPerVoxel{1};
+};
+
+// true on all processes if the image file holds at least nx*ny*nz voxels (checked by the main process)
+inline bool isReadable(RawImage const & image) {
+    int readable{0};
+    if (plb::global::mpi().isMainProcessor()) {
+        std::ifstream file(image.fileName.c_str(), std::ios::binary | std::ios::ate);
+        if (file.is_open()) {
+            std::streamoff fileSize = (std::streamoff) file.tellg();
+            readable = fileSize >= (std::streamoff) (image.nx*image.ny*image.nz*image.bytesPerVoxel) ? 1 : 0;
+        }
+    }
+    plb::global::mpi().bCast(&readable, 1);
+    return readable == 1;
+}
+
+// reads the part of a raw image that falls onto each block, segments it by a threshold
+// and downsamples it by an integer factor: an output node is solid (2) if more than half
+// of its factor^3 voxels are solid, void (0) otherwise
+// every process reads only the voxel rows of its own blocks; the file must be checked with
+// isReadable() first, and blocks whose rows cannot be read are counted in failures
+// the image origin (crop corner) maps to the output node origin, shifted along x
+class ReadSegmentedImage3D : public plb::BoxProcessingFunctional3D_S<int> {
+    public:
+        ReadSegmentedImage3D(RawImage const & image, plb::Dot3D cropOrigin, plb::plint factor,
+                plb::plint threshold, bool solidAboveThreshold, plb::plint xShift, int * failures):
+                image_(image), cropOrigin_(cropOrigin), factor_{factor},
+                threshold_{threshold}, solidAboveThreshold_{solidAboveThreshold}, xShift_{xShift},
+                failures_(failures) {};
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<int> & tags) {
+            std::ifstream file(image_.fileName.c_str(), std::ios::binary);
+            if (!file.is_open()) {
+                ++(*failures_);
+                return;
+            }
+            plb::Dot3D location = tags.getLocation();
+            plb::plint rowLength = domain.getNx()*factor_;
+            std::vector<unsigned char> row(rowLength*image_.bytesPerVoxel);
+            std::vector<plb::plint> solidCount(domain.getNx());
+            plb::plint majority = factor_*factor_*factor_/2;
+            plb::plint vx0 = cropOrigin_.x + (domain.x0 + location.x - xShift_)*factor_;
+
+            for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                    std::fill(solidCount.begin(), solidCount.end(), 0);
+                    for (plb::plint dy = 0; dy < factor_; ++dy) {
+                        for (plb::plint dz = 0; dz < factor_; ++dz) {
+                            plb::plint vy = cropOrigin_.y + (iY + location.y)*factor_ + dy;
+                            plb::plint vz = cropOrigin_.z + (iZ + location.z)*factor_ + dz;
+                            std::streamoff offset = (std::streamoff) ((vz*image_.ny + vy)*image_.nx + vx0)*image_.bytesPerVoxel;
+                            file.seekg(offset);
+                            file.read((char *) &row[0], (std::streamsize) row.size());
+                            if (!file) {
+                                ++(*failures_);
+                                return;
+                            }
+                            for (plb::plint iV = 0; iV < rowLength; ++iV) {
+                                plb::plint value = image_.bytesPerVoxel == 1 ? (plb::plint) row[iV] :
+                                        (plb::plint) row[2*iV] + 256*(plb::plint) row[2*iV + 1];
+                                bool isSolid = solidAboveThreshold_ ? value >= threshold_ : value < threshold_;
+                                if (isSolid) {
+                                    ++solidCount[iV/factor_];
+                                }
+                            }
+                        }
+                    }
+                    for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                        tags.get(iX, iY, iZ) = solidCount[iX - domain.x0] > majority ? 2 : 0;
+                    }
+                }
+            }
+        }
+        virtual ReadSegmentedImage3D * clone() const {
+            return new ReadSegmentedImage3D(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+        }
+    private:
+        RawImage image_;
+        plb::Dot3D cropOrigin_;
+        plb::plint factor_, threshold_;
+        bool solidAboveThreshold_;
+        plb::plint xShift_;
+        int * failures_;
+};
+
+// true on all processes if every process could read its part of the image
+inline bool readSegmentedImage(plb::MultiScalarField3D<int> & tags, plb::Box3D domain, RawImage const & image,
+        plb::Dot3D cropOrigin, plb::plint factor, plb::plint threshold, bool solidAboveThreshold) {
+    int failures{0};
+    plb::applyProcessingFunctional(new ReadSegmentedImage3D(image, cropOrigin, factor, threshold, solidAboveThreshold,
+            domain.x0, &failures), domain, tags);
+# ifdef PLB_MPI_PARALLEL
+    plb::global::mpi().reduceAndBcast(failures, MPI_SUM);
+# endif
+    return failures == 0;
+}
+
+}
+
+# endif
@@ -0,0 +1,396 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// data processing functionals used by the multiphase flow models
+// tag convention: 0 void, 1 surface solid, 2 interior solid, 3 invading fluid
+# ifndef MPFUNCTIONALS_H_
+# define MPFUNCTIONALS_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+
+namespace mpfunctionals {
+
+inline bool isSolidTag(int tag) {
+    return tag == 1 || tag == 2;
+}
+
+// mask for plb::count: true on fluid nodes
+struct IsFluidTag {
+    bool operator()(int tag) const {
+        return !isSolidTag(tag);
+    }
+};
+
+// re-classifies solid nodes: solids touching a fluid node (26 neighbors) become
+// surface nodes (1), all other solids interior nodes (2)
+// only 1 <-> 2 changes are made, so the field can be processed in place
+class ClassifySolidTags3D : public plb::BoxProcessingFunctional3D_S<int> {
+    public:
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<int> & tags) {
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        int & tag = tags.get(iX, iY, iZ);
+                        if (!isSolidTag(tag)) {
+                            continue;
+                        }
+                        bool touchesFluid{false};
+                        for (plb::plint dx = -1; dx <= 1 && !touchesFluid; ++dx) {
+                            for (plb::plint dy = -1; dy <= 1 && !touchesFluid; ++dy) {
+                                for (plb::plint dz = -1; dz <= 1 && !touchesFluid; ++dz) {
+                                    touchesFluid = !isSolidTag(tags.get(iX + dx, iY + dy, iZ + dz));
+                                }
+                            }
+                        }
+                        tag = touchesFluid ? 1 : 2;
+                    }
+                }
+            }
+        }
+        virtual ClassifySolidTags3D * clone() const {
+            return new ClassifySolidTags3D(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+        }
+};
+
+inline void classifySolidTags(plb::MultiScalarField3D<int> & tags, plb::Box3D domain) {
+    plb::applyProcessingFunctional(new ClassifySolidTags3D, domain, tags);
+}
+
+// initializes fluid nodes (tag 0 and 3) at equilibrium with zero velocity and
+// the density taken from a scalar field; the density is clipped to [rhoMin, rhoMax]
+// blocks: lattice, density field, tag field
+template <typename U, template<typename V> class Descriptor>
+class IniEquilibriumFromDensity3D : public plb::BoxProcessingFunctional3D {
+    public:
+        IniEquilibriumFromDensity3D(U rhoMin, U rhoMax):rhoMin_{rhoMin}, rhoMax_{rhoMax}{};
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 3);
+            plb::BlockLattice3D<U, Descriptor> & lattice = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[0]);
+            plb::ScalarField3D<U> & rho = dynamic_cast<plb::ScalarField3D<U> &>(*blocks[1]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[2]);
+            plb::Dot3D ofsR = plb::computeRelativeDisplacement(lattice, rho);
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(lattice, tags);
+            plb::Array<U, Descriptor<U>::d> zeroJ((U) 0., (U) 0., (U) 0.);
+
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        int tag = tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z);
+                        if (isSolidTag(tag)) {
+                            continue;
+                        }
+                        U rhoValue = rho.get(iX + ofsR.x, iY + ofsR.y, iZ + ofsR.z);
+                        rhoValue = std::max(rhoMin_, std::min(rhoMax_, rhoValue));
+                        plb::Cell<U, Descriptor> & cell = lattice.get(iX, iY, iZ);
+                        cell.getDynamics().computeEquilibria(cell.getRawPopulations(),
+                                Descriptor<U>::rhoBar(rhoValue), zeroJ, U(), U());
+                    }
+                }
+            }
+        }
+        virtual IniEquilibriumFromDensity3D<U, Descriptor> * clone() const {
+            return new IniEquilibriumFromDensity3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::nothing;
+            modified[2] = plb::modif::nothing;
+        }
+    private:
+        U rhoMin_, rhoMax_;
+};
+
+// phase flags used by the cluster labelling: 0 on solid nodes, 1 where fluid one
+// dominates and 2 where fluid two dominates
+// blocks: flag field, fluid one lattice, fluid two lattice, tag field
+template <typename U, template<typename V> class Descriptor>
+class DominantPhaseFlags3D : public plb::BoxProcessingFunctional3D {
+    public:
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 4);
+            plb::ScalarField3D<int> & flags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[0]);
+            plb::BlockLattice3D<U, Descriptor> & latticeOne = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[1]);
+            plb::BlockLattice3D<U, Descriptor> & latticeTwo = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[2]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[3]);
+            plb::Dot3D ofsOne = plb::computeRelativeDisplacement(flags, latticeOne);
+            plb::Dot3D ofsTwo = plb::computeRelativeDisplacement(flags, latticeTwo);
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(flags, tags);
+
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (isSolidTag(tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z))) {
+                            flags.get(iX, iY, iZ) = 0;
+                            continue;
+                        }
+                        U rhoOne = latticeOne.get(iX + ofsOne.x, iY + ofsOne.y, iZ + ofsOne.z).computeDensity();
+                        U rhoTwo = latticeTwo.get(iX + ofsTwo.x, iY + ofsTwo.y, iZ + ofsTwo.z).computeDensity();
+                        flags.get(iX, iY, iZ) = rhoOne >= rhoTwo ? 1 : 2;
+                    }
+                }
+            }
+        }
+        virtual DominantPhaseFlags3D<U, Descriptor> * clone() const {
+            return new DominantPhaseFlags3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::nothing;
+            modified[2] = plb::modif::nothing;
+            modified[3] = plb::modif::nothing;
+        }
+};
+
+// hash of the absolute node coordinates mapped to [0, 1): reproducible pseudo-random
+// numbers that do not depend on the block decomposition
+inline double nodeHash(plb::plint iX, plb::plint iY, plb::plint iZ) {
+    unsigned long long h = (unsigned long long) iX * 0x9E3779B97F4A7C15ULL;
+    h ^= (unsigned long long) iY * 0xC2B2AE3D27D4EB4FULL + (h << 6) + (h >> 2);
+    h ^= (unsigned long long) iZ * 0x165667B19E3779F9ULL + (h << 6) + (h >> 2);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return (double) (h >> 11) / (double) (1ULL << 53);
+}
+
+// distributes the two fluids randomly over the fluid nodes (tag 0 and 3) so that fluid one
+// fills the fraction saturation of the pore space; the nodes are reset to equilibrium at rest
+// blocks: fluid one lattice, fluid two lattice, tag field
+template <typename U, template<typename V> class Descriptor>
+class IniRandomSaturation3D : public plb::BoxProcessingFunctional3D {
+    public:
+        IniRandomSaturation3D(U saturation, U rhoF1, U rhoF2, U rhoNoFluid):saturation_{saturation},
+            rhoF1_{rhoF1}, rhoF2_{rhoF2}, rhoNoFluid_{rhoNoFluid}{};
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 3);
+            plb::BlockLattice3D<U, Descriptor> & latticeOne = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[0]);
+            plb::BlockLattice3D<U, Descriptor> & latticeTwo = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[1]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[2]);
+            plb::Dot3D ofsTwo = plb::computeRelativeDisplacement(latticeOne, latticeTwo);
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(latticeOne, tags);
+            plb::Dot3D location = latticeOne.getLocation();
+            plb::Array<U, Descriptor<U>::d> zeroJ((U) 0., (U) 0., (U) 0.);
+
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (isSolidTag(tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z))) {
+                            continue;
+                        }
+                        bool isFluidOne = nodeHash(iX + location.x, iY + location.y, iZ + location.z) < saturation_;
+                        plb::Cell<U, Descriptor> & cellOne = latticeOne.get(iX, iY, iZ);
+                        plb::Cell<U, Descriptor> & cellTwo = latticeTwo.get(iX + ofsTwo.x, iY + ofsTwo.y, iZ + ofsTwo.z);
+                        cellOne.getDynamics().computeEquilibria(cellOne.getRawPopulations(),
+                                Descriptor<U>::rhoBar(isFluidOne ? rhoF1_ : rhoNoFluid_), zeroJ, U(), U());
+                        cellTwo.getDynamics().computeEquilibria(cellTwo.getRawPopulations(),
+                                Descriptor<U>::rhoBar(isFluidOne ? rhoNoFluid_ : rhoF2_), zeroJ, U(), U());
+                    }
+                }
+            }
+        }
+        virtual IniRandomSaturation3D<U, Descriptor> * clone() const {
+            return new IniRandomSaturation3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::staticVariables;
+            modified[2] = plb::modif::nothing;
+        }
+    private:
+        U saturation_, rhoF1_, rhoF2_, rhoNoFluid_;
+};
+
+// block-wise version of MultiPhaseBase::initializeLatticeDensities: fluid one fills the invading
+// fluid nodes (tag 3) and fluid two the void nodes (tag 0), each with the dissolved density
+// rhoNoFluid of the other fluid; the nodes are set to equilibrium at rest
+// blocks: fluid one lattice, fluid two lattice, tag field
+template <typename U, template<typename V> class Descriptor>
+class IniEquilibriumFromTags3D : public plb::BoxProcessingFunctional3D {
+    public:
+        IniEquilibriumFromTags3D(U rhoF1, U rhoF2, U rhoNoFluid):rhoF1_{rhoF1}, rhoF2_{rhoF2}, rhoNoFluid_{rhoNoFluid}{};
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 3);
+            plb::BlockLattice3D<U, Descriptor> & latticeOne = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[0]);
+            plb::BlockLattice3D<U, Descriptor> & latticeTwo = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[1]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[2]);
+            plb::Dot3D ofsTwo = plb::computeRelativeDisplacement(latticeOne, latticeTwo);
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(latticeOne, tags);
+            plb::Array<U, Descriptor<U>::d> zeroJ((U) 0., (U) 0., (U) 0.);
+
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        int tag = tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z);
+                        if (tag != 0 && tag != 3) {
+                            continue;
+                        }
+                        plb::Cell<U, Descriptor> & cellOne = latticeOne.get(iX, iY, iZ);
+                        plb::Cell<U, Descriptor> & cellTwo = latticeTwo.get(iX + ofsTwo.x, iY + ofsTwo.y, iZ + ofsTwo.z);
+                        cellOne.getDynamics().computeEquilibria(cellOne.getRawPopulations(),
+                                Descriptor<U>::rhoBar(tag == 3 ? rhoF1_ : rhoNoFluid_), zeroJ, U(), U());
+                        cellTwo.getDynamics().computeEquilibria(cellTwo.getRawPopulations(),
+                                Descriptor<U>::rhoBar(tag == 3 ? rhoNoFluid_ : rhoF2_), zeroJ, U(), U());
+                    }
+                }
+            }
+        }
+        virtual IniEquilibriumFromTags3D<U, Descriptor> * clone() const {
+            return new IniEquilibriumFromTags3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::staticVariables;
+            modified[2] = plb::modif::nothing;
+        }
+    private:
+        U rhoF1_, rhoF2_, rhoNoFluid_;
+};
+
+// one reduction for the relative permeability runs: the saturation of fluid one in the pore
+// space and the volumetric flux of each fluid through cross-sections normal to axis
+// the flux of a fluid is its phase fraction times the common velocity (sum of the species
+// momenta with the half body-force correction over the total density); the phase fraction
+// of a node is its share of the densities in excess of the dissolved density rhoNoFluid,
+// each scaled by the bulk density of the fluid
+// blocks: fluid one lattice, fluid two lattice, tag field
+template <typename U, template<typename V> class Descriptor>
+class PhaseFluxes3D : public plb::PlainReductiveBoxProcessingFunctional3D {
+    public:
+        PhaseFluxes3D(plb::plint axis, std::vector<plb::plint> const & sections, U rhoF1, U rhoF2, U rhoNoFluid):
+                axis_{axis}, sections_(sections), rhoF1_{rhoF1}, rhoF2_{rhoF2}, rhoNoFluid_{rhoNoFluid} {
+            fractionId_ = this->getStatistics().subscribeSum();
+            poreNodesId_ = this->getStatistics().subscribeSum();
+            for (plb::pluint iS = 0; iS < sections_.size(); ++iS) {
+                fluxOneIds_.push_back(this->getStatistics().subscribeSum());
+                fluxTwoIds_.push_back(this->getStatistics().subscribeSum());
+            }
+        };
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 3);
+            plb::BlockLattice3D<U, Descriptor> & latticeOne = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[0]);
+            plb::BlockLattice3D<U, Descriptor> & latticeTwo = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[1]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[2]);
+            plb::Dot3D ofsTwo = plb::computeRelativeDisplacement(latticeOne, latticeTwo);
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(latticeOne, tags);
+            plb::Dot3D location = latticeOne.getLocation();
+            plb::BlockStatistics & statistics = this->getStatistics();
+
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (isSolidTag(tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z))) {
+                            continue;
+                        }
+                        plb::Cell<U, Descriptor> & cellOne = latticeOne.get(iX, iY, iZ);
+                        plb::Cell<U, Descriptor> & cellTwo = latticeTwo.get(iX + ofsTwo.x, iY + ofsTwo.y, iZ + ofsTwo.z);
+                        U rhoBarOne, rhoBarTwo;
+                        plb::Array<U, Descriptor<U>::d> jOne, jTwo;
+                        plb::momentTemplates<U, Descriptor>::get_rhoBar_j(cellOne, rhoBarOne, jOne);
+                        plb::momentTemplates<U, Descriptor>::get_rhoBar_j(cellTwo, rhoBarTwo, jTwo);
+                        U rhoOne = Descriptor<U>::fullRho(rhoBarOne);
+                        U rhoTwo = Descriptor<U>::fullRho(rhoBarTwo);
+                        U volumeOne = std::max(rhoOne - rhoNoFluid_, (U) 0.)/(rhoF1_ - rhoNoFluid_);
+                        U volumeTwo = std::max(rhoTwo - rhoNoFluid_, (U) 0.)/(rhoF2_ - rhoNoFluid_);
+                        U fractionOne = volumeOne + volumeTwo > (U) 0. ? volumeOne/(volumeOne + volumeTwo) : (U) 0.5;
+                        statistics.gatherSum(fractionId_, (double) fractionOne);
+                        statistics.gatherSum(poreNodesId_, 1.);
+
+                        plb::plint position = axis_ == 0 ? iX + location.x : (axis_ == 1 ? iY + location.y : iZ + location.z);
+                        for (plb::pluint iS = 0; iS < sections_.size(); ++iS) {
+                            if (position != sections_[iS]) {
+                                continue;
+                            }
+                            U forceOne = cellOne.getExternal(Descriptor<U>::ExternalField::forceBeginsAt)[axis_];
+                            U forceTwo = cellTwo.getExternal(Descriptor<U>::ExternalField::forceBeginsAt)[axis_];
+                            U velocity = (jOne[axis_] + jTwo[axis_] + (U) 0.5*(rhoOne*forceOne + rhoTwo*forceTwo))
+                                    /(rhoOne + rhoTwo);
+                            statistics.gatherSum(fluxOneIds_[iS], (double) (fractionOne*velocity));
+                            statistics.gatherSum(fluxTwoIds_[iS], (double) (((U) 1. - fractionOne)*velocity));
+                        }
+                    }
+                }
+            }
+        }
+        virtual PhaseFluxes3D<U, Descriptor> * clone() const {
+            return new PhaseFluxes3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::nothing;
+            modified[1] = plb::modif::nothing;
+            modified[2] = plb::modif::nothing;
+        }
+        U getSaturation() const {
+            double poreNodes = this->getStatistics().getSum(poreNodesId_);
+            return poreNodes > 0. ? (U) (this->getStatistics().getSum(fractionId_)/poreNodes) : (U) 0.;
+        }
+        // flux of fluid one (phase 0) or fluid two (phase 1), averaged over the sections
+        U getFlux(plb::plint phase) const {
+            std::vector<plb::plint> const & ids = phase == 0 ? fluxOneIds_ : fluxTwoIds_;
+            double flux{0.};
+            for (plb::pluint iS = 0; iS < ids.size(); ++iS) {
+                flux += this->getStatistics().getSum(ids[iS]);
+            }
+            return ids.empty() ? (U) 0. : (U) (flux/(double) ids.size());
+        }
+    private:
+        plb::plint axis_;
+        std::vector<plb::plint> sections_;
+        U rhoF1_, rhoF2_, rhoNoFluid_;
+        plb::plint fractionId_, poreNodesId_;
+        std::vector<plb::plint> fluxOneIds_, fluxTwoIds_;
+};
+
+template <typename U, template<typename V> class Descriptor>
+void iniEquilibriumFromDensity(plb::MultiBlockLattice3D<U, Descriptor> & lattice, plb::MultiScalarField3D<U> & rho,
+        plb::MultiScalarField3D<int> & tags, plb::Box3D domain, U rhoMin, U rhoMax) {
+    std::vector<plb::MultiBlock3D *> blocks;
+    blocks.push_back(& lattice);
+    blocks.push_back(& rho);
+    blocks.push_back(& tags);
+    plb::applyProcessingFunctional(new IniEquilibriumFromDensity3D<U, Descriptor>(rhoMin, rhoMax), domain, blocks);
+}
+
+template <typename U, template<typename V> class Descriptor>
+void iniRandomSaturation(plb::MultiBlockLattice3D<U, Descriptor> & latticeOne, plb::MultiBlockLattice3D<U, Descriptor> & latticeTwo,
+        plb::MultiScalarField3D<int> & tags, U saturation, U rhoF1, U rhoF2, U rhoNoFluid) {
+    std::vector<plb::MultiBlock3D *> blocks;
+    blocks.push_back(& latticeOne);
+    blocks.push_back(& latticeTwo);
+    blocks.push_back(& tags);
+    plb::applyProcessingFunctional(new IniRandomSaturation3D<U, Descriptor>(saturation, rhoF1, rhoF2, rhoNoFluid),
+            latticeOne.getBoundingBox(), blocks);
+}
+
+template <typename U, template<typename V> class Descriptor>
+void iniEquilibriumFromTags(plb::MultiBlockLattice3D<U, Descriptor> & latticeOne, plb::MultiBlockLattice3D<U, Descriptor> & latticeTwo,
+        plb::MultiScalarField3D<int> & tags, U rhoF1, U rhoF2, U rhoNoFluid) {
+    std::vector<plb::MultiBlock3D *> blocks;
+    blocks.push_back(& latticeOne);
+    blocks.push_back(& latticeTwo);
+    blocks.push_back(& tags);
+    plb::applyProcessingFunctional(new IniEquilibriumFromTags3D<U, Descriptor>(rhoF1, rhoF2, rhoNoFluid),
+            latticeOne.getBoundingBox(), blocks);
+}
+
+}
+
+# endif
@@ -43,6 +43,37 @@ struct FileParams
 };
 
 
+// triangle-mesh (stl) microstructure: the mesh is given in its own length units,
+// lattice node (0,0,0) sits at origin and nodes are voxelSize apart; the first
+// inletLayers x-layers are set to invading fluid
+template <typename U>
+struct MeshParams {
+    U voxelSize{1.};
+    std::vector<U> origin{0., 0., 0.};
+    plint inletLayers{0};
+    MeshParams() = default;
+    MeshParams(U voxelsize, std::vector<U> const & orig, plint inletlayers):voxelSize{voxelsize},
+            origin(orig), inletLayers{inletlayers}{};
+};
+
+// octree multi-level lattices (imbibition): levels coarser grid levels below the voxel
+// resolution, octree blocks of blockSize^3 nodes; pores of local radius r (voxels) run
+// on the grid coarsened 2^k times with r >= minRadius*2^k
+struct OctreeParams {
+    plint levels{0}, blockSize{12}, minRadius{3};
+    OctreeParams() = default;
+    OctreeParams(plint lvls, plint blocksize, plint minradius):levels{lvls}, blockSize{blocksize},
+        minRadius{minradius}{};
+};
+
+// free-surface engine: surface tension in lattice units, contact angle of the liquid in degrees
+template <typename U>
+struct FreeSurfaceParams {
+    U surfaceTension{0}, contactAngle{0};
+    FreeSurfaceParams() = default;
+    FreeSurfaceParams(U tension, U angle):surfaceTension{tension}, contactAngle{angle}{};
+};
+
 struct SingleCompFileParams
 {
     std::string geoName{}, outName{}, rhoName{};
@@ -120,6 +151,19 @@ struct DryingDensityParams {
 };
 
 
+// quasi-steady vapor solve of the drying models
+// solver: none, cg or bicgstab; the solve runs every frequency iterations of the ramp
+// tolerance: relative residual of each block solve; sweepTolerance: largest update between two sweeps
+template <typename U>
+struct VaporSolverParams {
+    std::string solver{"none"};
+    plint frequency{0}, maxSweeps{0};
+    U tolerance{}, sweepTolerance{};
+    VaporSolverParams() = default;
+    VaporSolverParams(std::string solv, plint freq, plint sweeps, U tol, U sweepTol):solver{solv}, frequency{freq},
+        maxSweeps{sweeps}, tolerance{tol}, sweepTolerance{sweepTol}{};
+};
+
 struct CoordinateParams {
     plint fX1{0}, fX2{0}, fY1{0}, fY2{0}, fZ1{0}, fZ2{0};
     CoordinateParams() = default;
@@ -127,5 +171,26 @@ struct CoordinateParams {
         fX1{fx1}, fX2{fx2}, fY1{fy1}, fY2{fy2}, fZ1{fz1}, fZ2{fz2}{};
 };
 
+// relative permeability sweep: saturations k/numSaturations for k = numSaturations..0,
+// fluxes are measured on the planes at the given positions along the force direction
+struct RelPermParams {
+    plint numSaturations{10};
+    std::vector<plint> sections;
+    RelPermParams() = default;
+    RelPermParams(plint numsat, std::vector<plint> sects):numSaturations{numsat}, sections{sects}{};
+};
+
+// probe of the multiphase models: type slice, box or point with its domain in lattice
+// coordinates; the fields are sampled every frequency time steps
+struct ProbeParams {
+    std::string name{}, type{};
+    Box3D domain{};
+    plint frequency{0};
+    std::vector<std::string> fields;
+    ProbeParams() = default;
+    ProbeParams(std::string nam, std::string typ, Box3D dom, plint freq, std::vector<std::string> flds):
+        name{nam}, type{typ}, domain{dom}, frequency{freq}, fields{flds}{};
+};
+
 
 # endif 
\ No newline at end of file
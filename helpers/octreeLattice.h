@@ -0,0 +1,290 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// helpers of the octree multi-level lattices: the geometric refinement criterion (local pore
+// radius from the tag field, written as a palabos grid density file) and the pieces the
+// level coupling needs for lattices with solid nodes
+// tag convention as in mpFunctionals.h: 0 void, 1 surface solid, 2 interior solid, 3 invading fluid
+# ifndef OCTREELATTICE_H_
+# define OCTREELATTICE_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+# include "./mpFunctionals.h"
+
+# include <algorithm>
+# include <memory>
+# include <string>
+# include <vector>
+
+namespace octree {
+
+// one relaxation sweep of the chebyshev (26 neighbor) distance of fluid nodes to the nearest
+// solid node, in place; solid nodes are set to 0 and nodes outside domain are ignored,
+// so the faces of the sample do not count as walls
+// blocks: distance field, tag field
+class PoreDistance3D : public plb::BoxProcessingFunctional3D_SS<int, int> {
+    public:
+        PoreDistance3D(plb::Box3D domain):domain_(domain){};
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<int> & distance, plb::ScalarField3D<int> & tags) {
+            plb::Dot3D location = distance.getLocation();
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(distance, tags);
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        int & d = distance.get(iX, iY, iZ);
+                        if (mpfunctionals::isSolidTag(tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z))) {
+                            d = 0;
+                            continue;
+                        }
+                        for (plb::plint dx = -1; dx <= 1; ++dx) {
+                            for (plb::plint dy = -1; dy <= 1; ++dy) {
+                                for (plb::plint dz = -1; dz <= 1; ++dz) {
+                                    if (plb::contained(iX + dx + location.x, iY + dy + location.y,
+                                            iZ + dz + location.z, domain_)) {
+                                        d = std::min(d, distance.get(iX + dx, iY + dy, iZ + dz) + 1);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        virtual PoreDistance3D * clone() const {
+            return new PoreDistance3D(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::nothing;
+        }
+    private:
+        plb::Box3D domain_;
+};
+
+// maximum (or minimum) of a field over the 27 nodes around each node; repeated k times
+// it gives the extremum over a (2k+1)^3 window
+// blocks: source field, result field
+class WindowExtremum3D : public plb::BoxProcessingFunctional3D_SS<int, int> {
+    public:
+        WindowExtremum3D(plb::Box3D domain, bool takeMax):domain_(domain), takeMax_{takeMax}{};
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<int> & source, plb::ScalarField3D<int> & result) {
+            plb::Dot3D location = source.getLocation();
+            plb::Dot3D ofsR = plb::computeRelativeDisplacement(source, result);
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        int value = source.get(iX, iY, iZ);
+                        for (plb::plint dx = -1; dx <= 1; ++dx) {
+                            for (plb::plint dy = -1; dy <= 1; ++dy) {
+                                for (plb::plint dz = -1; dz <= 1; ++dz) {
+                                    if (plb::contained(iX + dx + location.x, iY + dy + location.y,
+                                            iZ + dz + location.z, domain_)) {
+                                        int other = source.get(iX + dx, iY + dy, iZ + dz);
+                                        value = takeMax_ ? std::max(value, other) : std::min(value, other);
+                                    }
+                                }
+                            }
+                        }
+                        result.get(iX + ofsR.x, iY + ofsR.y, iZ + ofsR.z) = value;
+                    }
+                }
+            }
+        }
+        virtual WindowExtremum3D * clone() const {
+            return new WindowExtremum3D(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::nothing;
+            modified[1] = plb::modif::staticVariables;
+        }
+    private:
+        plb::Box3D domain_;
+        bool takeMax_;
+};
+
+// grid density of the octree generator from the local pore radius r: a pore may run on the
+// grid coarsened 2^k times if r >= minRadius*2^k (k <= levels); the density (levels - k)/levels
+// maps to the octree level maxLevel - k
+// blocks: pore radius field, grid density field
+template <typename U>
+class GridDensityFromRadius3D : public plb::BoxProcessingFunctional3D_SS<int, U> {
+    public:
+        GridDensityFromRadius3D(plb::plint levels, plb::plint minRadius):levels_{levels}, minRadius_{minRadius}{};
+        virtual void process(plb::Box3D domain, plb::ScalarField3D<int> & radius, plb::ScalarField3D<U> & density) {
+            plb::Dot3D ofsD = plb::computeRelativeDisplacement(radius, density);
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        plb::plint r = radius.get(iX, iY, iZ);
+                        plb::plint k{0};
+                        while (k < levels_ && (minRadius_ << (k + 1)) <= r) {
+                            ++k;
+                        }
+                        density.get(iX + ofsD.x, iY + ofsD.y, iZ + ofsD.z) = (U) (levels_ - k)/(U) levels_;
+                    }
+                }
+            }
+        }
+        virtual GridDensityFromRadius3D<U> * clone() const {
+            return new GridDensityFromRadius3D<U>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::nothing;
+            modified[1] = plb::modif::staticVariables;
+        }
+    private:
+        plb::plint levels_, minRadius_;
+};
+
+// writes the grid density file of plb::OctreeGridGenerator for a tag field in voxel units
+// the local pore radius of a fluid node is the largest pore distance within minRadius of it
+// (small in throats, large along the walls of wide pores); the density is sampled every
+// h <= blockSize/2 voxels (a power of 2) after taking the finest requirement over the
+// sampling window, and solid nodes ask for no refinement
+template <typename U>
+void writeGridDensity(plb::MultiScalarField3D<int> & tags, plb::plint levels, plb::plint minRadius,
+        plb::plint blockSize, std::string const & fileName) {
+    plb::Box3D domain = tags.getBoundingBox();
+    const int maxRadius = (int) (minRadius << levels);
+    std::unique_ptr<plb::MultiScalarField3D<int> > current = plb::generateMultiScalarField<int>(tags, domain);
+    std::unique_ptr<plb::MultiScalarField3D<int> > next = plb::generateMultiScalarField<int>(tags, domain);
+
+    plb::setToConstant(*current, domain, maxRadius);
+    for (int iPass = 0; iPass <= maxRadius; ++iPass) {
+        plb::applyProcessingFunctional(new PoreDistance3D(domain), domain, *current, tags);
+    }
+    for (plb::plint iPass = 0; iPass < minRadius; ++iPass) {
+        plb::applyProcessingFunctional(new WindowExtremum3D(domain, true), domain, *current, *next);
+        std::swap(current, next);
+    }
+    plb::setToConstant(*current, tags, 1, domain, maxRadius);
+    plb::setToConstant(*current, tags, 2, domain, maxRadius);
+
+    plb::plint sampling{1}, samplingLevels{0};
+    while (4*sampling <= blockSize) {
+        sampling *= 2;
+        ++samplingLevels;
+    }
+    for (plb::plint iPass = 0; iPass < sampling; ++iPass) {
+        plb::applyProcessingFunctional(new WindowExtremum3D(domain, false), domain, *current, *next);
+        std::swap(current, next);
+    }
+    std::unique_ptr<plb::MultiScalarField3D<int> > sampled = plb::coarsen(*current, 0, 0, samplingLevels, 0);
+    std::unique_ptr<plb::MultiScalarField3D<U> > density = plb::generateMultiScalarField<U>(*sampled,
+            sampled->getBoundingBox());
+    plb::applyProcessingFunctional(new GridDensityFromRadius3D<U>(levels, minRadius), sampled->getBoundingBox(),
+            *sampled, *density);
+
+    // header: sampled cuboid (x0 x1 y0 y1 z0 z1), sample spacing, number of samples
+    plb::plb_ofstream file(fileName.c_str());
+    file << 0 << " " << (density->getNx() - 1)*sampling << " " << 0 << " " << (density->getNy() - 1)*sampling
+         << " " << 0 << " " << (density->getNz() - 1)*sampling << std::endl;
+    file << sampling << " " << density->getNx() << " " << density->getNy() << " " << density->getNz() << std::endl;
+    file << *density << std::endl;
+    file.close();
+    plb::global::mpi().barrier();
+}
+
+// rescaling of the decomposed populations between grid levels for lattices with solid nodes:
+// bounce-back and no-dynamics nodes have no moments and no relaxation frequency, they are
+// written as zero vectors of the fluid layout (filled by FillSolidDecomposed3D); on fluid
+// nodes the non-equilibrium part follows the convective scaling and the body force, kept in
+// the external scalars, scales with the grid spacing
+template <typename U, template<typename V> class Descriptor>
+class WallSafeRescaler : public plb::ConvectiveNoForceRescaler<U, Descriptor> {
+    public:
+        virtual void rescale(const plb::Dynamics<U, Descriptor> & dyn, U xDt, std::vector<U> & rawData) const {
+            if (!dyn.hasMoments()) {
+                rawData.assign(1 + Descriptor<U>::d + Descriptor<U>::q + Descriptor<U>::ExternalField::numScalars, U());
+                return;
+            }
+            plb::ConvectiveNoForceRescaler<U, Descriptor>::rescale(dyn, xDt, rawData);
+            plb::plint force = 1 + Descriptor<U>::d + Descriptor<U>::q + Descriptor<U>::ExternalField::forceBeginsAt;
+            for (plb::plint iD = 0; iD < Descriptor<U>::d; ++iD) {
+                rawData[force + iD] *= xDt;
+            }
+        }
+        virtual WallSafeRescaler<U, Descriptor> * clone() const {
+            return new WallSafeRescaler<U, Descriptor>(*this);
+        }
+};
+
+// replaces the decomposed vectors of solid nodes by the average over their fluid neighbors
+// (or a fluid at rest of density rho if there are none), so that the interpolation between
+// grid levels does not mix the zero vectors of walls into the fluid nodes next to them
+// blocks: lattice, decomposed populations
+template <typename U, template<typename V> class Descriptor>
+class FillSolidDecomposed3D : public plb::BoxProcessingFunctional3D_LN<U, Descriptor, U> {
+    public:
+        FillSolidDecomposed3D(U rho):rho_{rho}{};
+        virtual void process(plb::Box3D domain, plb::BlockLattice3D<U, Descriptor> & lattice,
+                plb::NTensorField3D<U> & decomposed) {
+            plb::Dot3D ofs = plb::computeRelativeDisplacement(lattice, decomposed);
+            plb::plint nDim = decomposed.getNdim();
+            std::vector<U> average(nDim);
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (lattice.get(iX, iY, iZ).getDynamics().hasMoments()) {
+                            continue;
+                        }
+                        std::fill(average.begin(), average.end(), U());
+                        plb::plint numFluid{0};
+                        for (plb::plint dx = -1; dx <= 1; ++dx) {
+                            for (plb::plint dy = -1; dy <= 1; ++dy) {
+                                for (plb::plint dz = -1; dz <= 1; ++dz) {
+                                    plb::plint nX = iX + dx, nY = iY + dy, nZ = iZ + dz;
+                                    if (!plb::contained(nX, nY, nZ, lattice.getBoundingBox()) ||
+                                            !plb::contained(nX + ofs.x, nY + ofs.y, nZ + ofs.z, decomposed.getBoundingBox()) ||
+                                            !lattice.get(nX, nY, nZ).getDynamics().hasMoments()) {
+                                        continue;
+                                    }
+                                    U const * values = decomposed.get(nX + ofs.x, nY + ofs.y, nZ + ofs.z);
+                                    for (plb::plint iA = 0; iA < nDim; ++iA) {
+                                        average[iA] += values[iA];
+                                    }
+                                    ++numFluid;
+                                }
+                            }
+                        }
+                        U * values = decomposed.get(iX + ofs.x, iY + ofs.y, iZ + ofs.z);
+                        for (plb::plint iA = 0; iA < nDim; ++iA) {
+                            values[iA] = numFluid > 0 ? average[iA]/(U) numFluid : U();
+                        }
+                        if (numFluid == 0) {
+                            values[0] = Descriptor<U>::rhoBar(rho_);
+                        }
+                    }
+                }
+            }
+        }
+        virtual FillSolidDecomposed3D<U, Descriptor> * clone() const {
+            return new FillSolidDecomposed3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::nothing;
+            modified[1] = plb::modif::staticVariables;
+        }
+    private:
+        U rho_;
+};
+
+}
+
+# endif
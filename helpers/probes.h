@@ -0,0 +1,307 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// slice, box and point probes of the multiphase models
+// each probe is sampled by a data processing functional on the processes owning its
+// domain and appended to its own binary stream probe_<name>.bin; the layout of the
+// records is written to probe_<name>.txt
+// record: int64 time step, int64 number of pieces, then per piece int64 x0 x1 y0 y1 z0 z1
+// followed by float64 values (x fastest, then y, then z; field components innermost)
+# ifndef PROBES_H_
+# define PROBES_H_
+
+# include "palabos3D.h"
+# include "palabos3D.hh"
+# include "./mpParameterPacks.h"
+
+# include <string>
+# include <vector>
+# include <fstream>
+# include <cstdint>
+# include <cstring>
+# include <algorithm>
+# include <stdexcept>
+
+namespace probes {
+
+enum ProbeField { f1Density, f2Density, f1Velocity, f2Velocity, phase };
+
+inline ProbeField probeField(std::string const & name) {
+    if (name == "f1_density") return f1Density;
+    if (name == "f2_density") return f2Density;
+    if (name == "f1_velocity") return f1Velocity;
+    if (name == "f2_velocity") return f2Velocity;
+    if (name == "phase") return phase;
+    throw std::invalid_argument("unknown probe field " + name +
+            " (f1_density, f2_density, f1_velocity, f2_velocity or phase)");
+}
+
+inline plb::plint numComponents(ProbeField field) {
+    return (field == f1Velocity || field == f2Velocity) ? 3 : 1;
+}
+
+template <typename V>
+void appendValue(std::vector<char> & buffer, V value) {
+    std::size_t pos = buffer.size();
+    buffer.resize(pos + sizeof(V));
+    std::memcpy(&buffer[pos], &value, sizeof(V));
+}
+
+# ifdef PLB_MPI_PARALLEL
+// collective write of the local buffer at the given offset; the count of MPI_File_write_at_all
+// is an int, so the buffer is written in pieces of at most 1 GiB, and every process takes part
+// in as many writes as the process with the largest buffer
+inline void writeAtAll(MPI_File file, MPI_Offset offset, std::vector<char> & buffer) {
+    long long const maxPiece = 1LL << 30;
+    long long localSize = (long long) buffer.size();
+    long long numWrites = (localSize + maxPiece - 1) / maxPiece;
+    MPI_Allreduce(MPI_IN_PLACE, &numWrites, 1, MPI_LONG_LONG, MPI_MAX, plb::global::mpi().getGlobalCommunicator());
+    char dummy{0};
+    for (long long iWrite = 0; iWrite < numWrites; ++iWrite) {
+        long long begin = std::min(iWrite*maxPiece, localSize);
+        int count = (int) std::min(maxPiece, localSize - begin);
+        MPI_File_write_at_all(file, offset + (MPI_Offset) begin, count > 0 ? &buffer[begin] : &dummy,
+                              count, MPI_CHAR, MPI_STATUS_IGNORE);
+    }
+}
+# endif
+
+// appends one piece (the absolute box and the requested values) per block of the probe domain
+// the phase indicator is (rho1 - rho2) / (rho1 + rho2)
+// blocks: fluid one lattice, fluid two lattice
+template <typename U, template<typename V> class Descriptor>
+class ProbeSample3D : public plb::BoxProcessingFunctional3D {
+    public:
+        ProbeSample3D(std::vector<ProbeField> const & fields, std::vector<char> * buffer, plb::plint * numPieces):
+                        fields_{fields}, buffer_{buffer}, numPieces_{numPieces}{};
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 2);
+            plb::BlockLattice3D<U, Descriptor> & latticeOne = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[0]);
+            plb::BlockLattice3D<U, Descriptor> & latticeTwo = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[1]);
+            plb::Dot3D ofsTwo = plb::computeRelativeDisplacement(latticeOne, latticeTwo);
+            plb::Dot3D location = latticeOne.getLocation();
+
+            appendValue<std::int64_t>(*buffer_, domain.x0 + location.x);
+            appendValue<std::int64_t>(*buffer_, domain.x1 + location.x);
+            appendValue<std::int64_t>(*buffer_, domain.y0 + location.y);
+            appendValue<std::int64_t>(*buffer_, domain.y1 + location.y);
+            appendValue<std::int64_t>(*buffer_, domain.z0 + location.z);
+            appendValue<std::int64_t>(*buffer_, domain.z1 + location.z);
+            ++(*numPieces_);
+
+            plb::Array<U, 3> velocity;
+            for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                        plb::Cell<U, Descriptor> & cellOne = latticeOne.get(iX, iY, iZ);
+                        plb::Cell<U, Descriptor> & cellTwo = latticeTwo.get(iX + ofsTwo.x, iY + ofsTwo.y, iZ + ofsTwo.z);
+                        for (plb::pluint iField = 0; iField < fields_.size(); ++iField) {
+                            switch (fields_[iField]) {
+                                case f1Density:
+                                    appendValue<double>(*buffer_, cellOne.computeDensity());
+                                    break;
+                                case f2Density:
+                                    appendValue<double>(*buffer_, cellTwo.computeDensity());
+                                    break;
+                                case f1Velocity:
+                                case f2Velocity:
+                                    (fields_[iField] == f1Velocity ? cellOne : cellTwo).computeVelocity(velocity);
+                                    for (int iD = 0; iD < 3; ++iD) {
+                                        appendValue<double>(*buffer_, velocity[iD]);
+                                    }
+                                    break;
+                                case phase: {
+                                    U rhoOne = cellOne.computeDensity();
+                                    U rhoTwo = cellTwo.computeDensity();
+                                    U rhoSum = rhoOne + rhoTwo;
+                                    appendValue<double>(*buffer_, rhoSum != U() ? (rhoOne - rhoTwo) / rhoSum : U());
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        virtual ProbeSample3D<U, Descriptor> * clone() const {
+            return new ProbeSample3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::nothing;
+            modified[1] = plb::modif::nothing;
+        }
+    private:
+        std::vector<ProbeField> fields_;
+        std::vector<char> * buffer_;
+        plb::plint * numPieces_;
+};
+
+// the binary stream of one probe; each process writes its pieces of a record at its own
+// offset (collective write, no gather through the main process)
+class ProbeStream {
+    public:
+        ProbeStream(ProbeParams const & params, std::string const & outputDir):params_{params} {
+            for (plb::pluint iField = 0; iField < params_.fields.size(); ++iField) {
+                fields_.push_back(probeField(params_.fields[iField]));
+            }
+            std::string fileName = outputDir + "probe_" + params_.name + ".bin";
+# ifdef PLB_MPI_PARALLEL
+            MPI_Comm comm = plb::global::mpi().getGlobalCommunicator();
+            if (plb::global::mpi().isMainProcessor()) {
+                MPI_File_delete(fileName.c_str(), MPI_INFO_NULL);
+            }
+            plb::global::mpi().barrier();
+            int err = MPI_File_open(comm, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file_);
+            if (err != MPI_SUCCESS) {
+                throw std::runtime_error("could not open probe stream " + fileName);
+            }
+# else
+            file_.open(fileName.c_str(), std::ios::binary | std::ios::trunc);
+# endif
+            writeLayout(outputDir + "probe_" + params_.name + ".txt");
+        }
+        ProbeStream(const ProbeStream &) = delete;
+        ProbeStream & operator=(const ProbeStream &) = delete;
+        ~ProbeStream() {
+# ifdef PLB_MPI_PARALLEL
+            MPI_File_close(&file_);
+# endif
+        }
+
+        // collective: all processes call it at every time step
+        template <typename U, template<typename V> class Descriptor>
+        void sample(plb::plint step, plb::MultiBlockLattice3D<U, Descriptor> & latticeOne,
+                    plb::MultiBlockLattice3D<U, Descriptor> & latticeTwo) {
+            if (step % params_.frequency != 0) {
+                return;
+            }
+            std::vector<char> buffer;
+            plb::plint numPieces{0};
+            bool isMain = plb::global::mpi().isMainProcessor();
+            if (isMain) {
+                appendValue<std::int64_t>(buffer, step);
+                appendValue<std::int64_t>(buffer, 0);
+            }
+            std::vector<plb::MultiBlock3D *> lattices;
+            lattices.push_back(& latticeOne);
+            lattices.push_back(& latticeTwo);
+            plb::applyProcessingFunctional(new ProbeSample3D<U, Descriptor>(fields_, &buffer, &numPieces),
+                                           params_.domain, lattices);
+# ifdef PLB_MPI_PARALLEL
+            plb::global::mpi().reduceAndBcast(numPieces, MPI_SUM);
+# endif
+            if (isMain) {
+                std::int64_t totalPieces = numPieces;
+                std::memcpy(&buffer[sizeof(std::int64_t)], &totalPieces, sizeof(std::int64_t));
+            }
+# ifdef PLB_MPI_PARALLEL
+            long long localSize = (long long) buffer.size(), localOffset{0}, recordSize{localSize};
+            MPI_Comm comm = plb::global::mpi().getGlobalCommunicator();
+            MPI_Exscan(&localSize, &localOffset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+            if (isMain) {
+                localOffset = 0;
+            }
+            MPI_Allreduce(&localSize, &recordSize, 1, MPI_LONG_LONG, MPI_SUM, comm);
+            writeAtAll(file_, (MPI_Offset) (streamOffset_ + localOffset), buffer);
+            streamOffset_ += recordSize;
+# else
+            file_.write(&buffer[0], buffer.size());
+            file_.flush();
+# endif
+        }
+
+    private:
+        void writeLayout(std::string const & fileName) const {
+            plb::plb_ofstream layout(fileName.c_str());
+            plb::Box3D const & domain = params_.domain;
+            layout << "name: " << params_.name << std::endl;
+            layout << "type: " << params_.type << std::endl;
+            layout << "domain: " << domain.x0 << " " << domain.x1 << " " << domain.y0 << " " << domain.y1
+                   << " " << domain.z0 << " " << domain.z1 << std::endl;
+            layout << "frequency: " << params_.frequency << std::endl;
+            layout << "fields:";
+            for (plb::pluint iField = 0; iField < fields_.size(); ++iField) {
+                layout << " " << params_.fields[iField] << "(" << numComponents(fields_[iField]) << ")";
+            }
+            layout << std::endl;
+            layout << "record: int64 step, int64 number of pieces; per piece int64 x0 x1 y0 y1 z0 z1 and"
+                   << " float64 values (x fastest, then y, then z; field components innermost)" << std::endl;
+        }
+
+        ProbeParams params_;
+        std::vector<ProbeField> fields_;
+# ifdef PLB_MPI_PARALLEL
+        MPI_File file_;
+        long long streamOffset_{0};
+# else
+        std::ofstream file_;
+# endif
+};
+
+// reads one <probe> element of the output section; slices are given by an axis and a
+// position, boxes by x0 x1 y0 y1 z0 z1 and points by x y z
+inline ProbeParams readProbeParams(plb::XMLreaderProxy const & probe, plb::plint nx, plb::plint ny, plb::plint nz) {
+    ProbeParams params;
+    probe["name"].read(params.name);
+    probe["type"].read(params.type);
+    probe["frequency"].read(params.frequency);
+    probe["fields"].read(params.fields);
+    if (params.type == "slice") {
+        std::string axis;
+        plb::plint position{0};
+        probe["axis"].read(axis);
+        probe["position"].read(position);
+        params.domain = plb::Box3D(0, nx - 1, 0, ny - 1, 0, nz - 1);
+        if (axis == "x") {
+            params.domain.x0 = params.domain.x1 = position;
+        }
+        else if (axis == "y") {
+            params.domain.y0 = params.domain.y1 = position;
+        }
+        else if (axis == "z") {
+            params.domain.z0 = params.domain.z1 = position;
+        }
+        else {
+            throw std::invalid_argument("probe " + params.name + ": slice axis must be x, y or z");
+        }
+    }
+    else if (params.type == "box") {
+        std::vector<plb::plint> box;
+        probe["box"].read(box);
+        if (box.size() != 6) {
+            throw std::invalid_argument("probe " + params.name + ": box needs x0 x1 y0 y1 z0 z1");
+        }
+        params.domain = plb::Box3D(box[0], box[1], box[2], box[3], box[4], box[5]);
+    }
+    else if (params.type == "point") {
+        std::vector<plb::plint> point;
+        probe["point"].read(point);
+        if (point.size() != 3) {
+            throw std::invalid_argument("probe " + params.name + ": point needs x y z");
+        }
+        params.domain = plb::Box3D(point[0], point[0], point[1], point[1], point[2], point[2]);
+    }
+    else {
+        throw std::invalid_argument("probe " + params.name + ": type must be slice, box or point");
+    }
+    return params;
+}
+
+}
+
+# endif
@@ -22,6 +22,11 @@
 # define SIMUTILS_H_
 
 # include <math.h>
+# include <algorithm>
+# include <string>
+# include <cstdint>
+# include <fstream>
+# include <vector>
 
 namespace simutils {
 
@@ -56,6 +61,45 @@ bool hasConverged(U oldAvg, U newAvg, U checkFreq, U convCr) {
 }
 /*********************************/
 
+// flux stationarity: the change of both fluxes per time step, relative to the larger flux
+template <typename U>
+bool hasFluxConverged(U oldQ1, U oldQ2, U newQ1, U newQ2, U checkFreq, U convCr) {
+    U scale = std::max(std::fabs(newQ1), std::fabs(newQ2));
+    if (scale == (U) 0.) {
+        return false;
+    }
+    U relQ1 = std::fabs(oldQ1 - newQ1)*100.0/scale/checkFreq;
+    U relQ2 = std::fabs(oldQ2 - newQ2)*100.0/scale/checkFreq;
+    return relQ1 < convCr && relQ2 < convCr;
+}
+
+// 64-bit FNV-1a hash of a text, the same on every platform (used to name cache files)
+inline std::uint64_t hashText(std::string const & text) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::string::size_type i = 0; i < text.size(); ++i) {
+        hash ^= (std::uint64_t) (unsigned char) text[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// the same hash over the bytes of a file, read in chunks; an unreadable file hashes to 0
+inline std::uint64_t hashFile(std::string const & fileName) {
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        return 0;
+    }
+    std::uint64_t hash = 14695981039346656037ULL;
+    std::vector<char> chunk(1 << 20);
+    while (file.read(&chunk[0], chunk.size()) || file.gcount() > 0) {
+        for (std::streamsize i = 0; i < file.gcount(); ++i) {
+            hash ^= (std::uint64_t) (unsigned char) chunk[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
 
 }
 
@@ -0,0 +1,322 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// quasi-steady vapor diffusion for the drying models
+// the vapor is the fluid one density carried by the gas phase (fluid two dominant nodes)
+// the laplace problem is solved block by block with eigen (additive schwarz):
+// each atomic block takes the values of its envelope as dirichlet data and the
+// sweeps are repeated until the largest update falls below a tolerance of its own
+# ifndef VAPORDIFFUSION_H_
+# define VAPORDIFFUSION_H_
+
+# include <Eigen3/Sparse>
+# include "./mpFunctionals.h"
+
+namespace mpfunctionals {
+
+// node types of the vapor problem
+enum class VaporNode {solid, liquid, sink, interface, unknown};
+
+// blocks: vapor density (fluid one, updated in place), gas density (fluid two), tag field
+// inlet and outlet planes are sinks held at rhoSink, gas nodes touching the liquid keep
+// the saturation value resolved by the lattice
+template <typename U>
+class SolveVaporDiffusion3D : public plb::PlainReductiveBoxProcessingFunctional3D {
+    public:
+        SolveVaporDiffusion3D(plb::Box3D fullDomain, plb::Array<bool, 3> periodic, plb::Box3D inlet,
+                plb::Box3D outlet, U rhoSink, bool useBiCGSTAB, U tolerance):
+                    fullDomain_{fullDomain}, periodic_(periodic), inlet_{inlet}, outlet_{outlet},
+                        rhoSink_{rhoSink}, useBiCGSTAB_{useBiCGSTAB}, tolerance_{tolerance} {
+            maxChangeId_ = this->getStatistics().subscribeMax();
+        };
+
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 3);
+            plb::ScalarField3D<U> & vapor = dynamic_cast<plb::ScalarField3D<U> &>(*blocks[0]);
+            plb::ScalarField3D<U> & gas = dynamic_cast<plb::ScalarField3D<U> &>(*blocks[1]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[2]);
+            ofsG_ = plb::computeRelativeDisplacement(vapor, gas);
+            ofsT_ = plb::computeRelativeDisplacement(vapor, tags);
+            location_ = vapor.getLocation();
+
+            // number the unknowns of this block
+            plb::plint nY = domain.getNy(), nZ = domain.getNz();
+            std::vector<plb::plint> index(domain.nCells(), -1);
+            std::vector<U> oldValues;
+            plb::plint numUnknowns{0};
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (nodeType(vapor, gas, tags, iX, iY, iZ) == VaporNode::unknown) {
+                            index[((iX - domain.x0)*nY + (iY - domain.y0))*nZ + (iZ - domain.z0)] = numUnknowns++;
+                            oldValues.push_back(vapor.get(iX, iY, iZ));
+                        }
+                    }
+                }
+            }
+            if (numUnknowns == 0) {
+                return;
+            }
+
+            // 7-point laplacian, solids and non-periodic domain walls are zero-flux
+            std::vector<Eigen::Triplet<U>> triplets;
+            Eigen::Matrix<U, Eigen::Dynamic, 1> rhs = Eigen::Matrix<U, Eigen::Dynamic, 1>::Zero(numUnknowns);
+            Eigen::Matrix<U, Eigen::Dynamic, 1> guess(numUnknowns);
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        plb::plint row = index[((iX - domain.x0)*nY + (iY - domain.y0))*nZ + (iZ - domain.z0)];
+                        if (row < 0) {
+                            continue;
+                        }
+                        guess[row] = oldValues[row];
+                        U diagonal{0};
+                        for (plb::plint iN = 0; iN < 6; ++iN) {
+                            plb::plint nX = iX + (iN == 0) - (iN == 1);
+                            plb::plint nYn = iY + (iN == 2) - (iN == 3);
+                            plb::plint nZn = iZ + (iN == 4) - (iN == 5);
+                            if (!insideDomain(nX, nYn, nZn)) {
+                                continue;
+                            }
+                            VaporNode neighbor = nodeType(vapor, gas, tags, nX, nYn, nZn);
+                            if (neighbor == VaporNode::solid) {
+                                continue;
+                            }
+                            diagonal += (U) 1.;
+                            if (neighbor == VaporNode::sink) {
+                                rhs[row] += rhoSink_;
+                            }
+                            else if (plb::contained(nX, nYn, nZn, domain)) {
+                                plb::plint col = index[((nX - domain.x0)*nY + (nYn - domain.y0))*nZ + (nZn - domain.z0)];
+                                if (col >= 0) {
+                                    triplets.push_back(Eigen::Triplet<U>(row, col, (U) -1.));
+                                }
+                                else {
+                                    rhs[row] += vapor.get(nX, nYn, nZn);
+                                }
+                            }
+                            else {
+                                // envelope node: value of the neighboring block
+                                rhs[row] += vapor.get(nX, nYn, nZn);
+                            }
+                        }
+                        // isolated gas nodes keep their value
+                        if (diagonal == (U) 0.) {
+                            diagonal = (U) 1.;
+                            rhs[row] = oldValues[row];
+                        }
+                        triplets.push_back(Eigen::Triplet<U>(row, row, diagonal));
+                    }
+                }
+            }
+            Eigen::SparseMatrix<U> matrix(numUnknowns, numUnknowns);
+            matrix.setFromTriplets(triplets.begin(), triplets.end());
+
+            Eigen::Matrix<U, Eigen::Dynamic, 1> solution;
+            if (useBiCGSTAB_) {
+                Eigen::BiCGSTAB<Eigen::SparseMatrix<U>, Eigen::IncompleteLUT<U>> solver;
+                solver.setTolerance(tolerance_);
+                solver.compute(matrix);
+                solution = solver.solveWithGuess(rhs, guess);
+            }
+            else {
+                Eigen::ConjugateGradient<Eigen::SparseMatrix<U>, Eigen::Lower | Eigen::Upper,
+                        Eigen::IncompleteCholesky<U>> solver;
+                solver.setTolerance(tolerance_);
+                solver.compute(matrix);
+                solution = solver.solveWithGuess(rhs, guess);
+            }
+
+            U maxChange{0};
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        plb::plint row = index[((iX - domain.x0)*nY + (iY - domain.y0))*nZ + (iZ - domain.z0)];
+                        if (row < 0) {
+                            continue;
+                        }
+                        U value = std::max(solution[row], (U) 0.);
+                        maxChange = std::max(maxChange, std::abs(value - oldValues[row]));
+                        vapor.get(iX, iY, iZ) = value;
+                    }
+                }
+            }
+            this->getStatistics().gatherMax(maxChangeId_, (double) maxChange);
+        }
+
+        virtual SolveVaporDiffusion3D<U> * clone() const {
+            return new SolveVaporDiffusion3D<U>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::nothing;
+            modified[2] = plb::modif::nothing;
+        }
+        U getMaxChange() const {
+            return (U) this->getStatistics().getMax(maxChangeId_);
+        }
+
+    private:
+        // coordinates are local to the vapor block
+        VaporNode nodeType(plb::ScalarField3D<U> & vapor, plb::ScalarField3D<U> & gas,
+                plb::ScalarField3D<int> & tags, plb::plint iX, plb::plint iY, plb::plint iZ) const {
+            if (isSolidTag(tags.get(iX + ofsT_.x, iY + ofsT_.y, iZ + ofsT_.z))) {
+                return VaporNode::solid;
+            }
+            if (isLiquid(vapor, gas, iX, iY, iZ)) {
+                return VaporNode::liquid;
+            }
+            plb::Dot3D absPos(iX + location_.x, iY + location_.y, iZ + location_.z);
+            if (plb::contained(absPos, inlet_) || plb::contained(absPos, outlet_)) {
+                return VaporNode::sink;
+            }
+            for (plb::plint iN = 0; iN < 6; ++iN) {
+                plb::plint nX = iX + (iN == 0) - (iN == 1);
+                plb::plint nY = iY + (iN == 2) - (iN == 3);
+                plb::plint nZ = iZ + (iN == 4) - (iN == 5);
+                if (!insideEnvelope(vapor, nX, nY, nZ) || !insideDomain(nX, nY, nZ)) {
+                    continue;
+                }
+                if (!isSolidTag(tags.get(nX + ofsT_.x, nY + ofsT_.y, nZ + ofsT_.z)) &&
+                        isLiquid(vapor, gas, nX, nY, nZ)) {
+                    return VaporNode::interface;
+                }
+            }
+            return VaporNode::unknown;
+        }
+        bool isLiquid(plb::ScalarField3D<U> & vapor, plb::ScalarField3D<U> & gas, plb::plint iX, plb::plint iY, plb::plint iZ) const {
+            return vapor.get(iX, iY, iZ) >= gas.get(iX + ofsG_.x, iY + ofsG_.y, iZ + ofsG_.z);
+        }
+        bool insideEnvelope(plb::ScalarField3D<U> & vapor, plb::plint iX, plb::plint iY, plb::plint iZ) const {
+            return iX >= 0 && iX < vapor.getNx() && iY >= 0 && iY < vapor.getNy() && iZ >= 0 && iZ < vapor.getNz();
+        }
+        // false only across a non-periodic wall of the full domain
+        bool insideDomain(plb::plint iX, plb::plint iY, plb::plint iZ) const {
+            plb::Dot3D absPos(iX + location_.x, iY + location_.y, iZ + location_.z);
+            return (periodic_[0] || (absPos.x >= fullDomain_.x0 && absPos.x <= fullDomain_.x1)) &&
+                   (periodic_[1] || (absPos.y >= fullDomain_.y0 && absPos.y <= fullDomain_.y1)) &&
+                   (periodic_[2] || (absPos.z >= fullDomain_.z0 && absPos.z <= fullDomain_.z1));
+        }
+
+        plb::Box3D fullDomain_;
+        plb::Array<bool, 3> periodic_;
+        plb::Box3D inlet_, outlet_;
+        U rhoSink_;
+        bool useBiCGSTAB_;
+        U tolerance_;
+        plb::plint maxChangeId_;
+        plb::Dot3D ofsG_, ofsT_, location_;
+};
+
+// imposes the solved vapor density on the gas nodes of the fluid one lattice
+// the non-equilibrium part and the momentum of each node are kept
+// blocks: lattice (fluid one), vapor density, gas density, tag field
+template <typename U, template<typename V> class Descriptor>
+class ImposeVaporDensity3D : public plb::BoxProcessingFunctional3D {
+    public:
+        virtual void processGenericBlocks(plb::Box3D domain, std::vector<plb::AtomicBlock3D *> blocks) {
+            PLB_ASSERT(blocks.size() == 4);
+            plb::BlockLattice3D<U, Descriptor> & lattice = dynamic_cast<plb::BlockLattice3D<U, Descriptor> &>(*blocks[0]);
+            plb::ScalarField3D<U> & vapor = dynamic_cast<plb::ScalarField3D<U> &>(*blocks[1]);
+            plb::ScalarField3D<U> & gas = dynamic_cast<plb::ScalarField3D<U> &>(*blocks[2]);
+            plb::ScalarField3D<int> & tags = dynamic_cast<plb::ScalarField3D<int> &>(*blocks[3]);
+            plb::Dot3D ofsV = plb::computeRelativeDisplacement(lattice, vapor);
+            plb::Dot3D ofsG = plb::computeRelativeDisplacement(lattice, gas);
+            plb::Dot3D ofsT = plb::computeRelativeDisplacement(lattice, tags);
+            plb::Array<U, Descriptor<U>::q> fEqOld, fEqNew;
+            plb::Array<U, Descriptor<U>::d> j;
+
+            for (plb::plint iX = domain.x0; iX <= domain.x1; ++iX) {
+                for (plb::plint iY = domain.y0; iY <= domain.y1; ++iY) {
+                    for (plb::plint iZ = domain.z0; iZ <= domain.z1; ++iZ) {
+                        if (isSolidTag(tags.get(iX + ofsT.x, iY + ofsT.y, iZ + ofsT.z))) {
+                            continue;
+                        }
+                        plb::Cell<U, Descriptor> & cell = lattice.get(iX, iY, iZ);
+                        U rhoBar{0};
+                        cell.getDynamics().computeRhoBarJ(cell, rhoBar, j);
+                        U rho = Descriptor<U>::fullRho(rhoBar);
+                        if (rho >= gas.get(iX + ofsG.x, iY + ofsG.y, iZ + ofsG.z)) {
+                            continue;
+                        }
+                        U rhoNew = vapor.get(iX + ofsV.x, iY + ofsV.y, iZ + ofsV.z);
+                        U jSqr = plb::normSqr(j);
+                        cell.getDynamics().computeEquilibria(fEqOld, rhoBar, j, jSqr, U());
+                        cell.getDynamics().computeEquilibria(fEqNew, Descriptor<U>::rhoBar(rhoNew), j, jSqr, U());
+                        for (plb::plint iPop = 0; iPop < Descriptor<U>::q; ++iPop) {
+                            cell[iPop] += fEqNew[iPop] - fEqOld[iPop];
+                        }
+                    }
+                }
+            }
+        }
+        virtual ImposeVaporDensity3D<U, Descriptor> * clone() const {
+            return new ImposeVaporDensity3D<U, Descriptor>(*this);
+        }
+        virtual void getTypeOfModification(std::vector<plb::modif::ModifT> & modified) const {
+            modified[0] = plb::modif::staticVariables;
+            modified[1] = plb::modif::nothing;
+            modified[2] = plb::modif::nothing;
+            modified[3] = plb::modif::nothing;
+        }
+};
+
+// quasi-steady vapor solve on the fluid one lattice; returns the number of schwarz sweeps
+template <typename U, template<typename V> class Descriptor>
+plb::plint solveQuasiSteadyVapor(plb::MultiBlockLattice3D<U, Descriptor> & latticeVapor,
+        plb::MultiBlockLattice3D<U, Descriptor> & latticeGas, plb::MultiScalarField3D<int> & tags,
+        plb::Box3D inlet, plb::Box3D outlet, U rhoSink, bool useBiCGSTAB, U tolerance, U sweepTolerance,
+        plb::plint maxSweeps) {
+    plb::Box3D domain = latticeVapor.getBoundingBox();
+    std::unique_ptr<plb::MultiScalarField3D<U>> vapor = plb::computeDensity(latticeVapor);
+    std::unique_ptr<plb::MultiScalarField3D<U>> gas = plb::computeDensity(latticeGas);
+    plb::Array<bool, 3> periodic;
+    for (plb::plint iD = 0; iD < 3; ++iD) {
+        periodic[iD] = latticeVapor.periodicity().get(iD);
+        vapor->periodicity().toggle(iD, periodic[iD]);
+        gas->periodicity().toggle(iD, periodic[iD]);
+    }
+    vapor->duplicateOverlaps(plb::modif::staticVariables);
+    gas->duplicateOverlaps(plb::modif::staticVariables);
+
+    std::vector<plb::MultiBlock3D *> blocks;
+    blocks.push_back(vapor.get());
+    blocks.push_back(gas.get());
+    blocks.push_back(& tags);
+    plb::plint sweep{0};
+    for (sweep = 0; sweep < maxSweeps; ++sweep) {
+        SolveVaporDiffusion3D<U> functional(domain, periodic, inlet, outlet, rhoSink, useBiCGSTAB, tolerance);
+        plb::applyProcessingFunctional(functional, domain, blocks);
+        if (functional.getMaxChange() < sweepTolerance) {
+            ++sweep;
+            break;
+        }
+    }
+
+    std::vector<plb::MultiBlock3D *> imposeBlocks;
+    imposeBlocks.push_back(& latticeVapor);
+    imposeBlocks.push_back(vapor.get());
+    imposeBlocks.push_back(gas.get());
+    imposeBlocks.push_back(& tags);
+    plb::applyProcessingFunctional(new ImposeVaporDensity3D<U, Descriptor>, domain, imposeBlocks);
+    return sweep;
+}
+
+}
+
+# endif
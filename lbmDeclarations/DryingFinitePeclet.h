@@ -22,6 +22,7 @@
 # define DRYINGFINITEPECLET_H_ 
 
 # include "./MultiPhaseRunOut.h"
+# include "../helpers/vaporDiffusion.h"
 
 class DryingFinitePeclet: public MultiPhaseRunOut {
     // latticeFluidOne: water 
@@ -40,6 +41,8 @@ class DryingFinitePeclet: public MultiPhaseRunOut {
         DryingFinitePeclet& operator=(const DryingFinitePeclet &) = delete;
         
         // all virtual functions 
+        void setVaporSolver(const VaporSolverParams<T> &);
+        void solveVaporField();
         virtual void setFluidsProperties(const CohesionParams<T> &, const FluidsParams<T> &);
         virtual void setInletOutletDensities();
         virtual void setPressureBoundaryValues(T, T);
@@ -50,10 +53,14 @@ class DryingFinitePeclet: public MultiPhaseRunOut {
         virtual void operator()(plint, plint, plint, plint, T);
    
     protected:
+        // the shan-chen cohesion matrix, for the equilibrium cache
+        std::string cohesionKey() const;
         // vapor density
         bool pressureUpdate_{true};
         T terminalG_{0};
         std::vector<std::vector<T>> spG_;
+        // quasi-steady vapor solve (off by default)
+        VaporSolverParams<T> vaporSolver_;
 
 };
 
@@ -0,0 +1,76 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */  
+/*                                                                                  */                                                                                      
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */ 
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// drainage and drying on a single lattice: the liquid runs on palabos' free-surface model and the
+// gas is a pressure reservoir, so neither the gas lattice nor the shan-chen coupling is needed
+// drainage: the defending fluid (tag 0) is the liquid and the invading fluid (tag 3) the gas
+// drying: the water (tag 3) is the liquid and the air (tag 0) the gas
+// the gas pressure is ramped in steps as in MultiPhasePressure; the liquid leaves through
+// reservoirs at the reference density (outlet plane for drainage, both planes for drying) and
+// gas pockets that pinch off from the reservoir keep their own pressure (BubbleHistory3D)
+# ifndef FREESURFACEDISPLACEMENT_H_ 
+# define FREESURFACEDISPLACEMENT_H_ 
+
+# include "./MultiPhaseBase.h"
+# include "../helpers/freeSurfaceFunctionals.h"
+
+class FreeSurfaceDisplacement : public MultiPhaseBase {
+    public:
+        // the lattices passed in are placeholders: the free-surface lattice is built in setUp()
+        // on the decomposition of geometry, which must hold the full voxel domain
+        FreeSurfaceDisplacement(MultiBlockLattice3D<T, MPDESCRIPTOR> && latticeFluidOne,
+                     MultiBlockLattice3D<T, MPDESCRIPTOR> && latticeFluidTwo, MultiScalarField3D<int> && geometry,
+                     plint numruns, T minradius, const std::string & flowType):
+                        MultiPhaseBase(std::move(latticeFluidOne), std::move(latticeFluidTwo), std::move(geometry)),
+                        flowType_{flowType}, totalNumRuns_{numruns}, minRadius_{minradius} {};
+
+        FreeSurfaceDisplacement(const FreeSurfaceDisplacement &) = delete;
+        FreeSurfaceDisplacement& operator=(const FreeSurfaceDisplacement &) = delete;
+
+        void setFreeSurface(const FreeSurfaceParams<T> &);
+        // keeps the flags only: the placeholder lattices are not toggled, the free-surface fields in setUp()
+        void setPeriodicBCFlags(const PeriodicParams &);
+        void setGasDensities();
+        // liquid volume over the pore volume of the tag field
+        T computeSaturation();
+        // matches the gas pockets and sets their pressure (the reservoir keeps rhoGas)
+        void updateGasPressure(plint, T);
+        void writeVolumeFractionVTK(plint);
+
+        virtual void setUp();
+        virtual void writeSimulationDatFile();
+        virtual void operator()(plint, plint, plint, T);
+        virtual ~FreeSurfaceDisplacement() = default;
+
+    protected:
+        // flow type: "drainage" or "drying"
+        std::string flowType_{};
+        plint totalNumRuns_{0};
+        T minRadius_{};
+        FreeSurfaceParams<T> freeSurface_{};
+        // reference density of the liquid reservoirs and of the initial gas
+        T rhoLiquid_{1.0};
+        std::vector<T> gasRhoValues_;
+        std::vector<T> pressureValues_;
+        std::vector<T> saturationValues_;
+        std::unique_ptr<FreeSurfaceFields3D<T, FSDESCRIPTOR>> fields_;
+        std::unique_ptr<BubbleMatch3D> bubbleMatch_;
+        std::unique_ptr<BubbleHistory3D<T>> bubbleHistory_;
+};
+
+# endif 
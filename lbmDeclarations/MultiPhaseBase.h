@@ -21,6 +21,13 @@
 
 # include "../helpers/header.h"
 # include "../helpers/mpParameterPacks.h"
+# include "../helpers/mpFunctionals.h"
+# include "../helpers/hdf5Output.h"
+# include "../helpers/probes.h"
+# include "../helpers/blockActivity.h"
+# include "../helpers/deltaOutput.h"
+# include "../helpers/convergenceMonitor.h"
+# include "../helpers/fluidCellLists.h"
 
 class MultiPhaseBase {
 
@@ -40,19 +47,53 @@ class MultiPhaseBase {
         void setFileNames(const FileParams &);
         void setPeriodicBCFlags(const PeriodicParams &); 
         void setExternalForce(const ExternalForceParams<T> &);
+        void setWarmStart(const plint &, const plint &);
+        void setClusterAnalysis(const bool &);
+        void setOutputFormat(const std::string &);
+        // largest density change of a block that the delta output treats as unchanged
+        void setDeltaOutputTolerance(const T &);
+        void setProbes(const std::vector<ProbeParams> &);
+        // quiescent-block skipping: check interval in time steps (0 is off) and tolerance
+        void setQuiescentBlocks(const plint &, const T &);
+        // fluid-cell lists: blocks with at most this fraction of void and surface nodes iterate over
+        // a list of them (0 is off)
+        void setFluidCellLists(const T &);
+        // convergence measure: energy (stored average densities), l2 or linf (density residuals
+        // of both species) or saturation (saturation change)
+        void setConvergenceMeasure(const std::string &);
+        // placement of an stl microstructure (used if the microstructure file ends with .stl)
+        void setMicrostructureMesh(const MeshParams<T> &);
         // called by client code
         // computation methods
+        // reads the tagged microstructure file, or voxelizes an stl microstructure
         void readGeometry();
+        void voxelizeGeometry();
         void defineLatticeDynamics();
         // if fluids are not loaded from a geometry file
         // invading and defending fluids are specified by initial coordinates
         void addExternalForces();
+        // one time step of both species: their halos are exchanged together, one message per neighbour
+        void collideAndStream();
         void initializeLattices();
         void initializeLatticeDensities();
+        // coarse-to-fine warm start: solves on a lattice coarsened by 2^levels and
+        // prolongs the species densities to the fine lattices as the initial condition
+        void runWarmStart(plint, T);
+        // labels the clusters of the defending fluid (fluid two) and appends them to clusters.dat;
+        // returns false once no cluster is connected to the outlet (all of them are trapped)
+        bool analyzeClusters(plint);
         // is used to initialize lattices from file, such as files for contact angle measurements
         // main call(): with and without checks for convergence 
         // output methods 
+        // writes one output step in the selected format (vtk: density VTK and text files, hdf5: one file,
+        // delta: the changed density blocks)
+        void writeFields(plint, bool withVelocity = true);
+        void writeFieldsHDF5(plint);
+        void writeFieldsDelta(plint);
         void writeRhoVTK(plint);
+        void writeRhoPVTI(plint);
+        // called after every time step: appends the probes that are due to their streams
+        void sampleProbes();
         void writeVelocityComponentsDAT(plint);
         void writeRhoDistributionDAT(plint);
         void addSimulationGeneralInfo(plb_ofstream &) const;
@@ -70,8 +111,26 @@ class MultiPhaseBase {
 
     
     protected:
+        // lattice-explicit versions of the set up methods (used for the coarse warm start lattices)
+        void defineLatticeDynamics(MultiBlockLattice3D<T, MPDESCRIPTOR> &, MultiBlockLattice3D<T, MPDESCRIPTOR> &,
+                                    MultiScalarField3D<int> &);
+        void initializeLatticeDensities(MultiBlockLattice3D<T, MPDESCRIPTOR> &, MultiBlockLattice3D<T, MPDESCRIPTOR> &,
+                                    MultiScalarField3D<int> &);
+        void addExternalForces(MultiBlockLattice3D<T, MPDESCRIPTOR> &, MultiBlockLattice3D<T, MPDESCRIPTOR> &);
+        void collideAndStream(MultiBlockLattice3D<T, MPDESCRIPTOR> &, MultiBlockLattice3D<T, MPDESCRIPTOR> &);
+        // re-activates frozen quiescent blocks after boundary values or parameters changed
+        void activateAllBlocks();
+        // one convergence check on the selected measure (called every checkFreq time steps);
+        // report prints the measured values
+        bool checkConvergence(plint, T, bool report = false);
+        // the next check starts a new measurement (new run or new boundary values)
+        void resetConvergence();
+        // boundary conditions of the coarse warm start lattices: none for imbibition
+        virtual void initCoarseLevelBC(MultiBlockLattice3D<T, MPDESCRIPTOR> &, MultiBlockLattice3D<T, MPDESCRIPTOR> &);
+
         // file names and directory paths
         std::string geoFileName_{}, outputDir_{}, forceDir_{};
+        MeshParams<T> meshParams_{};
         // domain size
         plint nx_{0}, ny_{0}, nz_{0};
         // fluid region bounds
@@ -87,6 +146,29 @@ class MultiPhaseBase {
         T rhoF1_{0}, rhoF2_{0}, rhoInitInlet_{0}, rhoInitOutlet_{0}, rhoNoFluid_{0}; 
         // relaxation times
         std::vector<T> constOmegaValues_;
+        // coarse warm start: 0 is off, 1 and 2 coarsen the lattice 2x and 4x
+        plint warmStartLevels_{0}, warmStartMaxIter_{0};
+        // trapped-cluster analysis at every convergence check
+        bool clusterAnalysis_{false};
+        plint poreVolume_{0};
+        // field output format: vtk or hdf5
+        std::string outputFormat_{"vtk"};
+        T deltaOutputTolerance_{1e-6};
+        std::unique_ptr<deltaoutput::DeltaStream> deltaStream_;
+        // probes and the number of time steps run so far
+        std::vector<std::unique_ptr<probes::ProbeStream>> probes_;
+        plint probeStep_{0};
+        std::unique_ptr<MultiScalarField3D<int>> phaseFlags_;
+        std::unique_ptr<ClusterMatch3D> clusterMatch_;
+        std::unique_ptr<activity::QuiescentBlocks<T, MPDESCRIPTOR>> quiescentBlocks_;
+        plint quiescentInterval_{0};
+        T quiescentTolerance_{0};
+        T fluidCellFraction_{0};
+        // convergence measure, the energies of the last check and the residual monitor
+        std::string convergenceMeasure_{"energy"};
+        T oldAvgEnF1_{1.}, oldAvgEnF2_{1.};
+        bool hasEnergyReference_{false};
+        std::unique_ptr<convergence::ResidualMonitor<T, MPDESCRIPTOR>> residualMonitor_;
         // core lattices
         MultiBlockLattice3D<T, MPDESCRIPTOR> latticeFluidOne_;
         MultiBlockLattice3D<T, MPDESCRIPTOR> latticeFluidTwo_;
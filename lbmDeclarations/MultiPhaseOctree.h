@@ -0,0 +1,69 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */  
+/*                                                                                  */                                                                                      
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */ 
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// imbibition on octree multi-level lattices: the grid is refined by the local pore radius of
+// the tag field, so throats run at the voxel resolution and wide pores on coarser levels
+// the levels are coupled by palabos' grid refinement actions (one set per species); the
+// shan-chen coupling runs on every level with the relaxation frequencies of that level
+# ifndef MULTIPHASEOCTREE_H_ 
+# define MULTIPHASEOCTREE_H_ 
+
+# include "./MultiPhaseBase.h"
+# include "../helpers/octreeLattice.h"
+
+class MultiPhaseOctree : public MultiPhaseBase {
+    public:
+        // the lattices passed in are placeholders: the level lattices are built in setUp()
+        // from the octree, geometry must hold the full voxel domain
+        MultiPhaseOctree(MultiBlockLattice3D<T, MPDESCRIPTOR> && latticeFluidOne,
+                     MultiBlockLattice3D<T, MPDESCRIPTOR> && latticeFluidTwo, MultiScalarField3D<int> && geometry):
+                        MultiPhaseBase(std::move(latticeFluidOne), std::move(latticeFluidTwo), std::move(geometry)) {};
+
+        MultiPhaseOctree(const MultiPhaseOctree &) = delete;
+        MultiPhaseOctree& operator=(const MultiPhaseOctree &) = delete;
+
+        void setOctree(const OctreeParams &);
+        // one time step of the coarsest level, with the recursive sub-steps of the finer ones
+        void iterateLevel(plint);
+        void writeLevelsVTK(plint);
+
+        virtual void setUp();
+        virtual void writeSimulationDatFile();
+        virtual void operator()(plint, plint, plint, T);
+        virtual ~MultiPhaseOctree();
+
+    protected:
+        typedef MultiLevelActions3D<T, MPDESCRIPTOR, octree::WallSafeRescaler> LevelActions;
+        // builds the lattices, tags and initial state of one level
+        void setUpLevel(plint);
+        // adds the coupling actions of one species and fills its solid nodes in the helper tensors
+        void setUpCoupling(std::vector<Group3D *> &, std::unique_ptr<LevelActions> &,
+                            std::vector<Actions3D *> &);
+
+        OctreeParams octree_;
+        OctreeGridStructure ogs_;
+        // finest level, which runs at the voxel resolution of the tag field
+        plint tagLevel_{0};
+        // per level: lattice groups of both species and tags
+        std::vector<Group3D *> groupsOne_, groupsTwo_;
+        std::vector<std::unique_ptr<MultiScalarField3D<int>>> levelTags_;
+        std::unique_ptr<LevelActions> actionsOne_, actionsTwo_;
+        std::vector<Actions3D *> stepsOne_, stepsTwo_;
+};
+
+# endif 
@@ -37,33 +37,8 @@ class MultiPhasePressure: public MultiPhaseBase {
         MultiPhasePressure(const MultiPhasePressure &) = delete;
         MultiPhasePressure& operator=(const MultiPhasePressure &) = delete;
 
-        MultiPhasePressure(MultiPhasePressure&& other) noexcept
-            : MultiPhaseBase(std::move(other)), 
-            totalNumRuns_(other.totalNumRuns_),
-            minRadius_(other.minRadius_),
-            inletRhoValues_(std::move(other.inletRhoValues_)),
-            outletRhoValues_(std::move(other.outletRhoValues_)),
-            pressureValues_(std::move(other.pressureValues_)),
-            boundaryCondition_(other.boundaryCondition_)
-            {
-            other.boundaryCondition_ = nullptr;
-            }
-
-        MultiPhasePressure& operator=(MultiPhasePressure&& other) noexcept {
-        if (this != &other) {
-            MultiPhaseBase::operator=(std::move(other));
-            totalNumRuns_ = other.totalNumRuns_;
-            minRadius_ = other.minRadius_;
-            inletRhoValues_ = std::move(other.inletRhoValues_);
-            outletRhoValues_ = std::move(other.outletRhoValues_);
-            pressureValues_ = std::move(other.pressureValues_);
-            delete boundaryCondition_; // cleanup old pointer!
-            boundaryCondition_ = other.boundaryCondition_;
-            other.boundaryCondition_ = nullptr;
-            }
-            return *this;
-            }
-
+        MultiPhasePressure(MultiPhasePressure&&) = delete;
+        MultiPhasePressure& operator=(MultiPhasePressure&&) = delete;
         
         // virtual methods
         virtual void initPressureBC();
@@ -72,6 +47,7 @@ class MultiPhasePressure: public MultiPhaseBase {
         virtual void setUp();
         virtual void operator()(plint, plint, plint, T);
         virtual void writeSimulationDatFile();
+        virtual void initCoarseLevelBC(MultiBlockLattice3D<T, MPDESCRIPTOR> &, MultiBlockLattice3D<T, MPDESCRIPTOR> &);
         virtual ~MultiPhasePressure() {
             delete boundaryCondition_;
         }
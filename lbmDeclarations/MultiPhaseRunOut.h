@@ -31,6 +31,8 @@ class MultiPhaseRunOut : public MultiPhasePressure {
         
         MultiPhaseRunOut(const MultiPhaseRunOut &) = delete; 
         MultiPhaseRunOut& operator =(const MultiPhaseRunOut &) = delete;
+        // directory of the stored equilibrium stages (empty: the equilibrium stage always runs)
+        void setEquilibriumCache(const std::string &);
         void runEquilibrium(plint, plint, plint, T);
 
         virtual void initPressureBC();
@@ -42,7 +44,15 @@ class MultiPhaseRunOut : public MultiPhasePressure {
 
     
     protected:
+        // runs the equilibrium stage, or loads it from the cache if a run with the same
+        // equilibrium parameters stored it; the text names the stage and its own parameters
+        void equilibrate(plint, plint, plint, T, const std::string &);
+        // the parameters that define the equilibrium stage, one per line; the microstructure is
+        // identified by a checksum of its file and the sum of the tags, not by its path
+        std::string equilibriumKey(plint, plint, T);
+
         plint outCounter_{0};
+        std::string equilibriumCacheDir_{};
         
 };
 
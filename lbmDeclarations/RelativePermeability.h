@@ -0,0 +1,54 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */  
+/*                                                                                  */                                                                                      
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */ 
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// steady-state relative permeability: body-force driven co-flow at a sweep of saturations
+// the fluxes and the saturation are reduced in-situ, every state runs until the fluxes
+// are stationary and the sweep ends with one kr table (relperm.dat)
+# ifndef RELATIVEPERMEABILITY_H_ 
+# define RELATIVEPERMEABILITY_H_ 
+
+# include "./MultiPhaseBase.h"
+
+class RelativePermeability : public MultiPhaseBase {
+    public:
+        RelativePermeability(MultiBlockLattice3D<T, MPDESCRIPTOR> && latticeFluidOne,
+                     MultiBlockLattice3D<T, MPDESCRIPTOR> && latticeFluidTwo, MultiScalarField3D<int> && geometry):
+                        MultiPhaseBase(std::move(latticeFluidOne), std::move(latticeFluidTwo), std::move(geometry)) {};
+
+        RelativePermeability(const RelativePermeability &) = delete;
+        RelativePermeability& operator=(const RelativePermeability &) = delete;
+
+        void setRelPerm(const RelPermParams &);
+        // runs one saturation state to flux stationarity; returns the number of iterations
+        plint runSaturationState(T, plint, plint, T);
+        void writeRelPermTable() const;
+
+        virtual void setUp();
+        virtual void writeSimulationDatFile();
+        virtual void operator()(plint, plint, T);
+
+    protected:
+        // axis of the body force (0, 1, 2)
+        plint forceAxis_{0};
+        RelPermParams relPerm_;
+        // per saturation state: target and measured saturation, fluxes and iterations
+        std::vector<T> targetSaturations_, saturations_, fluxesF1_, fluxesF2_;
+        std::vector<plint> iterations_;
+};
+
+# endif 
@@ -17,6 +17,28 @@
 /************************************************************************************/
 # include "../lbmDeclarations/DryingFinitePeclet.h"
 
+# include <iomanip>
+
+void DryingFinitePeclet::setVaporSolver(const VaporSolverParams<T> & vaporParams) {
+    if (vaporParams.solver != "none" && vaporParams.solver != "cg" && vaporParams.solver != "bicgstab") {
+        throw std::invalid_argument("vapor solver must be none, cg or bicgstab");
+    }
+    if (vaporParams.solver != "none" && (vaporParams.frequency <= 0 || vaporParams.maxSweeps <= 0 ||
+            vaporParams.tolerance <= 0 || vaporParams.sweepTolerance <= 0)) {
+        throw std::invalid_argument("vapor solve frequency, sweeps and tolerances must be positive");
+    }
+    vaporSolver_ = vaporParams;
+}
+
+// replaces the explicit vapor transport in the gas phase by the steady diffusion field
+// fluid one is drained to rhoNoFluid_ at both planes (see setPressureBoundaryValues)
+void DryingFinitePeclet::solveVaporField() {
+    plint sweeps = mpfunctionals::solveQuasiSteadyVapor(latticeFluidOne_, latticeFluidTwo_, geometry_,
+        inlet_, outlet_, rhoNoFluid_, vaporSolver_.solver == "bicgstab", vaporSolver_.tolerance,
+            vaporSolver_.sweepTolerance, vaporSolver_.maxSweeps);
+    pcout << "quasi-steady vapor solve: " << sweeps << " block sweeps" << std::endl;
+}
+
 void DryingFinitePeclet::setFluidsProperties(const CohesionParams<T> & cohesionParams, const FluidsParams<T> & fluidsParams) {
     
     T omegaF1{0}, omegaF2{0};
@@ -71,6 +93,7 @@ void DryingFinitePeclet::initPressureBC() {
 }
 
 void DryingFinitePeclet::setPressureBoundaryValues(T rhoInlet, T rhoOutlet) {
+    activateAllBlocks();
     setBoundaryDensity(latticeFluidTwo_, inlet_, rhoInlet);
     setBoundaryDensity(latticeFluidTwo_, outlet_, rhoOutlet);
 
@@ -81,6 +104,7 @@ void DryingFinitePeclet::setPressureBoundaryValues(T rhoInlet, T rhoOutlet) {
 
 
 void DryingFinitePeclet::setShanChen(T gValue) {
+    activateAllBlocks();
 
     std::vector <MultiBlockLattice3D<T, MPDESCRIPTOR> *> blockLattices;
     plint processorLevel = 1;
@@ -107,13 +131,15 @@ void DryingFinitePeclet::runPressureRamp(plint maxRampIter, plint outputFreq, pl
     setPressureBoundaryValues(inletRhoValues_[1], outletRhoValues_[1]);           
 
     for (iT = 0; iT < maxRampIter; ++iT) {
-        latticeFluidOne_.collideAndStream();
-        latticeFluidTwo_.collideAndStream();
+        collideAndStream();
+        sampleProbes();
+
+        if (vaporSolver_.solver != "none" && iT % vaporSolver_.frequency == 0) {
+            solveVaporField();
+        }
 
         if (iT % outputFreq == 0) {
-            writeRhoVTK(outCounter_);
-            writeVelocityComponentsDAT(outCounter_);
-            writeRhoDistributionDAT(outCounter_);
+            writeFields(outCounter_);
             ++outCounter_;   
             pcout  <<"generating output for the pressure flow and the drying "<<std::endl;             
         }
@@ -129,10 +155,21 @@ void DryingFinitePeclet::runPressureRamp(plint maxRampIter, plint outputFreq, pl
     
 }
 
+std::string DryingFinitePeclet::cohesionKey() const {
+    std::ostringstream key;
+    key << std::setprecision(17) << "g:";
+    for (pluint iRow = 0; iRow < spG_.size(); ++iRow) {
+        for (pluint iCol = 0; iCol < spG_[iRow].size(); ++iCol) {
+            key << " " << spG_[iRow][iCol];
+        }
+    }
+    return key.str();
+}
+
 void DryingFinitePeclet::operator()(plint maxIter, plint maxRampIter, plint outputFreq, plint checkFreq, T convCr) {
     setShanChen(1.0);
     setUp();
-    runEquilibrium(maxIter, outputFreq, checkFreq, convCr);
+    equilibrate(maxIter, outputFreq, checkFreq, convCr, "drying " + cohesionKey());
     setShanChen(terminalG_);
     if (pressureUpdate_) {
         runPressureRamp(maxRampIter, outputFreq, checkFreq, convCr);
@@ -19,6 +19,8 @@
 
 # include "../lbmDeclarations/DryingRateChange.h"
 
+# include <iomanip>
+
 
 void DryingRateChange::setCohesionValues(const CohesionRangeParams<T> & cohesionRangeParams,
          const std::string & gChangeType) {
@@ -112,6 +114,7 @@ void DryingRateChange::setFluidsProperties(const CohesionRangeParams<T> & cohesi
 
 
 void DryingRateChange::setShanChen(T gValue, std::vector<T> omegaValues) {
+    activateAllBlocks();
     
     std::vector <MultiBlockLattice3D<T, MPDESCRIPTOR> *> blockLattices;    
     plint processorLevel = 1;
@@ -174,13 +177,15 @@ void DryingRateChange::runPressureRamp(plint maxRampIter, plint outputFreq, plin
         gRampIter = gRampIters.at(numG);
 
         for (iT = 0; iT < gRampIter; ++iT) {
-            latticeFluidOne_.collideAndStream();
-            latticeFluidTwo_.collideAndStream();
+            collideAndStream();
+            sampleProbes();
+
+            if (vaporSolver_.solver != "none" && iT % vaporSolver_.frequency == 0) {
+                solveVaporField();
+            }
 
             if (iT % outputFreq == 0) {
-                writeRhoVTK(outCounter_);
-                writeVelocityComponentsDAT(outCounter_);
-                writeRhoDistributionDAT(outCounter_);
+                writeFields(outCounter_);
                 ++outCounter_;   
                 }
 
@@ -198,7 +203,10 @@ void DryingRateChange::operator()(plint maxIter, plint maxRampIter, plint output
     // uses a g value to run the equilibrium stage without evaporation
     setShanChen(1.0, omegaValues_.at(0));
     setUp();
-    runEquilibrium(maxIter, outputFreq, checkFreq, convCr);
+    std::ostringstream stage;
+    stage << std::setprecision(17) << "drying-rate " << cohesionKey() << " omegas: "
+          << omegaValues_.at(0).at(0) << " " << omegaValues_.at(0).at(1);
+    equilibrate(maxIter, outputFreq, checkFreq, convCr, stage.str());
     runPressureRamp(maxRampIter, outputFreq, checkFreq, convCr);
 }
 
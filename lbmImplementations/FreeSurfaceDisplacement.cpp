@@ -0,0 +1,195 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */  
+/*                                                                                  */                                                                                      
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */ 
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// implementations of methods defined in FreeSurfaceDisplacement
+# include "../lbmDeclarations/FreeSurfaceDisplacement.h"
+
+void FreeSurfaceDisplacement::setFreeSurface(const FreeSurfaceParams<T> & freeSurfaceParams) {
+    if (freeSurfaceParams.surfaceTension <= 0) {
+        throw std::invalid_argument("free surface: the surface tension must be positive");
+    }
+    if (freeSurfaceParams.contactAngle < 0 || freeSurfaceParams.contactAngle > 180) {
+        throw std::invalid_argument("free surface: the contact angle must be in the range [0, 180] degrees");
+    }
+    freeSurface_ = freeSurfaceParams;
+}
+
+void FreeSurfaceDisplacement::setPeriodicBCFlags(const PeriodicParams & periodicParams) {
+    xPeriod_ = periodicParams.xPeriod;
+    yPeriod_ = periodicParams.yPeriod;
+    zPeriod_ = periodicParams.zPeriod;
+}
+
+void FreeSurfaceDisplacement::setGasDensities() {
+    // the last step reaches the capillary entry pressure of the smallest throat,
+    // 2 sigma cos(theta)/r, with p = rho/3
+    constexpr T six = 6.0;
+    T pi = std::acos((T) -1);
+    T cosTheta = std::abs(std::cos(freeSurface_.contactAngle*pi/(T) 180));
+    T deltaRho = six*freeSurface_.surfaceTension*cosTheta/minRadius_;
+    T stepSize = deltaRho/totalNumRuns_;
+
+    for (plint runNum = 0; runNum <= totalNumRuns_; ++runNum) {
+        gasRhoValues_.push_back(rhoLiquid_ + (T)runNum*stepSize);
+    }
+}
+
+void FreeSurfaceDisplacement::setUp() {
+    if (flowType_ != "drainage" && flowType_ != "drying") {
+        throw std::invalid_argument("free surface: the flow type must be drainage or drying");
+    }
+    bool drainage = flowType_ == "drainage";
+    readGeometry();
+    initBoundaryPlanes();
+    setGasDensities();
+    poreVolume_ = count(geometry_, mpfunctionals::IsFluidTag());
+
+    // the liquid keeps the relaxation frequency and the force of its shan-chen species
+    T omega = constOmegaValues_.at(drainage ? 1 : 0);
+    T force = drainage ? forceF2_ : forceF1_;
+    Array<T, 3> forceVector(forceDir_ == "x" ? force : 0., forceDir_ == "y" ? force : 0., forceDir_ == "z" ? force : 0.);
+    fields_.reset(new FreeSurfaceFields3D<T, FSDESCRIPTOR>(geometry_.getMultiBlockManagement().getSparseBlockStructure(),
+        new BGKdynamics<T, FSDESCRIPTOR>(omega), rhoLiquid_, freeSurface_.surfaceTension, freeSurface_.contactAngle,
+        forceVector));
+    fields_->periodicityToggle(0, xPeriod_);
+    fields_->periodicityToggle(1, yPeriod_);
+    fields_->periodicityToggle(2, zPeriod_);
+
+    // solid nodes are walls, on which the curvature sees the contact angle; the faces of the
+    // non-periodic directions are closed by a wall layer
+    applyProcessingFunctional(new freesurface::FlagsFromTags3D(drainage ? 0 : 3), geometry_.getBoundingBox(),
+        geometry_, fields_->flag);
+    Box3D domain = fields_->flag.getBoundingBox();
+    if (!xPeriod_) {
+        setToConstant(fields_->flag, Box3D(0, 0, 0, ny_-1, 0, nz_-1), (int) freeSurfaceFlag::wall);
+        setToConstant(fields_->flag, Box3D(nx_-1, nx_-1, 0, ny_-1, 0, nz_-1), (int) freeSurfaceFlag::wall);
+    }
+    if (!yPeriod_) {
+        setToConstant(fields_->flag, Box3D(0, nx_-1, 0, 0, 0, nz_-1), (int) freeSurfaceFlag::wall);
+        setToConstant(fields_->flag, Box3D(0, nx_-1, ny_-1, ny_-1, 0, nz_-1), (int) freeSurfaceFlag::wall);
+    }
+    if (!zPeriod_) {
+        setToConstant(fields_->flag, Box3D(0, nx_-1, 0, ny_-1, 0, 0), (int) freeSurfaceFlag::wall);
+        setToConstant(fields_->flag, Box3D(0, nx_-1, 0, ny_-1, nz_-1, nz_-1), (int) freeSurfaceFlag::wall);
+    }
+    fields_->defaultInitialize();
+
+    // liquid reservoirs, after the last level of the free-surface processors
+    integrateProcessingFunctional(new freesurface::FixedLiquidDensity3D<T, FSDESCRIPTOR>(rhoLiquid_), outlet_,
+        fields_->freeSurfaceArgs, 4);
+    if (!drainage) {
+        integrateProcessingFunctional(new freesurface::FixedLiquidDensity3D<T, FSDESCRIPTOR>(rhoLiquid_), inlet_,
+            fields_->freeSurfaceArgs, 4);
+    }
+
+    // the initial gas is the reservoir: it stays frozen at the imposed pressure, and when it
+    // splits only its largest part does (entrapment)
+    bubbleMatch_.reset(new BubbleMatch3D(fields_->flag));
+    bubbleHistory_.reset(new BubbleHistory3D<T>(fields_->flag));
+    bubbleMatch_->execute(fields_->flag, fields_->volumeFraction);
+    bubbleHistory_->transition(*bubbleMatch_, 0, (T) 1, true);
+    bubbleHistory_->freeze();
+    pcout <<"free surface: "<<domain.nCells()<<" nodes on one lattice, "<<bubbleMatch_->numBubbles()
+          <<" initial gas region(s)"<<std::endl;
+}
+
+void FreeSurfaceDisplacement::updateGasPressure(plint iT, T rhoGas) {
+    bubbleMatch_->execute(fields_->flag, fields_->volumeFraction);
+    bubbleHistory_->transition(*bubbleMatch_, iT, (T) 1, true);
+    bubbleHistory_->updateBubblePressure(fields_->outsideDensity, rhoGas);
+}
+
+T FreeSurfaceDisplacement::computeSaturation() {
+    return computeSum(fields_->volumeFraction)/(T) poreVolume_;
+}
+
+void FreeSurfaceDisplacement::writeVolumeFractionVTK(plint it) {
+    std::string fileName = createFileName(outputDir_ + "volume_fraction_step_", it, 6);
+    VtkImageOutput3D<T> vtkOut(fileName, 1.0);
+    vtkOut.writeData<double>(fields_->volumeFraction, "volume_fraction", 1.);
+}
+
+void FreeSurfaceDisplacement::writeSimulationDatFile() {
+    std::string simFile = outputDir_ + "simulation.dat";
+    plb_ofstream simInfo(simFile.c_str());
+    simInfo<<"engine: free-surface"<<std::endl;
+    simInfo<<"surface_tension: "<<freeSurface_.surfaceTension<<std::endl;
+    simInfo<<"contact_angle: "<<freeSurface_.contactAngle<<std::endl;
+    simInfo<<"delta_P:";
+    for (pluint numP = 0; numP < pressureValues_.size(); ++numP) {
+        simInfo<<" "<<pressureValues_.at(numP);
+    }
+    simInfo<<std::endl;
+    simInfo<<"saturation:";
+    for (pluint numS = 0; numS < saturationValues_.size(); ++numS) {
+        simInfo<<" "<<saturationValues_.at(numS);
+    }
+    simInfo<<std::endl;
+}
+
+void FreeSurfaceDisplacement::operator()(plint maxIter, plint checkFreq, plint outputFreq, T convCr) {
+    // outputs follow the output frequency over all steps; the saturation is recorded at the
+    // end of each pressure step
+    setUp();
+    bool hasNotConverged{true};
+    plint iT{0}, numOut{0}, totalNumIter{0};
+    T oldSaturation{}, newSaturation{};
+    T cyclePressure{0.};
+
+    for (plint numRun = 0; numRun < totalNumRuns_; ++numRun) {
+        T rhoGas = gasRhoValues_.at(numRun);
+        bubbleHistory_->updateBubblePressure(fields_->outsideDensity, rhoGas);
+        cyclePressure = (1./3.)*(rhoGas - rhoLiquid_);
+        hasNotConverged = true;
+        oldSaturation = computeSaturation();
+        iT = 0;
+        while (hasNotConverged) {
+
+            fields_->lattice.executeInternalProcessors();
+            fields_->lattice.evaluateStatistics();
+            fields_->lattice.incrementTime();
+
+            if (totalNumIter % outputFreq == 0) {
+                writeVolumeFractionVTK(numOut);
+                pressureValues_.push_back(cyclePressure);
+                ++numOut;
+            }
+
+            if (iT > 0 && iT % checkFreq == 0) {
+                updateGasPressure(totalNumIter, rhoGas);
+                newSaturation = computeSaturation();
+                if (newSaturation <= 0 ||
+                        simutils::hasConverged(oldSaturation, newSaturation, (T) checkFreq, convCr)) {
+                    hasNotConverged = false;
+                }
+                oldSaturation = newSaturation;
+            }
+
+            if (iT >= maxIter) {
+                hasNotConverged = false;
+            }
+            ++iT;
+            ++totalNumIter;
+        }
+        saturationValues_.push_back(computeSaturation());
+        pcout <<"pressure step "<<numRun<<": delta_P "<<cyclePressure<<" liquid saturation "
+              <<saturationValues_.back()<<" after "<<iT<<" iterations"<<std::endl;
+    }
+    writeSimulationDatFile();
+    bubbleHistory_->timeHistoryLog(outputDir_ + "bubble_history.dat");
+}
@@ -89,6 +89,143 @@ void MultiPhaseBase::setExternalForce(const ExternalForceParams<T> & externalFor
     forceF2_ = externalForceParams.forceF2;
 }
 
+void MultiPhaseBase::setWarmStart(const plint & levels, const plint & maxIter) {
+    if (levels < 0 || levels > 2) {
+        throw std::invalid_argument("warm start levels must be 0 (off), 1 (2x) or 2 (4x)");
+    }
+    warmStartLevels_ = levels;
+    warmStartMaxIter_ = maxIter;
+}
+
+void MultiPhaseBase::setQuiescentBlocks(const plint & interval, const T & tolerance) {
+    if (interval < 0 || tolerance < 0) {
+        throw std::invalid_argument("quiescent block interval and tolerance must be non-negative");
+    }
+    quiescentInterval_ = interval;
+    quiescentTolerance_ = tolerance;
+    if (interval == 0) {
+        quiescentBlocks_.reset();
+        return;
+    }
+    std::vector<MultiBlockLattice3D<T, MPDESCRIPTOR> *> lattices;
+    lattices.push_back(& latticeFluidOne_);
+    lattices.push_back(& latticeFluidTwo_);
+    quiescentBlocks_.reset(new activity::QuiescentBlocks<T, MPDESCRIPTOR>(lattices, tolerance, interval));
+}
+
+void MultiPhaseBase::activateAllBlocks() {
+    if (quiescentBlocks_) {
+        quiescentBlocks_->activateAll();
+    }
+}
+
+void MultiPhaseBase::setFluidCellLists(const T & maxFraction) {
+    if (maxFraction < 0 || maxFraction > 1) {
+        throw std::invalid_argument("fluid-cell list fraction must be in the range [0, 1]");
+    }
+    fluidCellFraction_ = maxFraction;
+}
+
+void MultiPhaseBase::setConvergenceMeasure(const std::string & measure) {
+    if (measure != "energy" && measure != "l2" && measure != "linf" && measure != "saturation") {
+        throw std::invalid_argument("convergence measure must be energy, l2, linf or saturation");
+    }
+    convergenceMeasure_ = measure;
+}
+
+void MultiPhaseBase::resetConvergence() {
+    oldAvgEnF1_ = 1.;
+    oldAvgEnF2_ = 1.;
+    hasEnergyReference_ = false;
+    if (residualMonitor_) {
+        residualMonitor_->reset();
+    }
+}
+
+bool MultiPhaseBase::checkConvergence(plint checkFreq, T convCr, bool report) {
+    if (convergenceMeasure_ == "energy") {
+        T newAvgEnF1 = getStoredAverageDensity(latticeFluidOne_);
+        T newAvgEnF2 = getStoredAverageDensity(latticeFluidTwo_);
+        if (report) {
+            pcout <<"the 1 energy value is "<<std::fabs(oldAvgEnF1_ - newAvgEnF1)*100.0/oldAvgEnF1_/(T)checkFreq<<" cr: "<<convCr<<std::endl;
+            pcout <<"the 2 energy value is "<<std::fabs(oldAvgEnF2_ - newAvgEnF2)*100.0/oldAvgEnF2_/(T)checkFreq<<" cr: "<<convCr<<std::endl;
+        }
+        // the first check after a reset has no reference energies
+        bool converged = hasEnergyReference_ &&
+                simutils::hasConverged(oldAvgEnF1_, oldAvgEnF2_, newAvgEnF1, newAvgEnF2, (T) checkFreq, convCr);
+        hasEnergyReference_ = true;
+        oldAvgEnF1_ = newAvgEnF1;
+        oldAvgEnF2_ = newAvgEnF2;
+        return converged;
+    }
+
+    // the monitor is created at the first check, once the densities are set
+    if (!residualMonitor_) {
+        residualMonitor_.reset(new convergence::ResidualMonitor<T, MPDESCRIPTOR>(latticeFluidOne_, latticeFluidTwo_,
+                                    geometry_, rhoF1_, rhoF2_, rhoNoFluid_));
+    }
+    convergence::Residuals<T> residuals = residualMonitor_->check(checkFreq);
+    if (report) {
+        pcout <<"residuals l2: "<<residuals.l2F1<<" "<<residuals.l2F2<<" linf: "<<residuals.linfF1<<" "<<residuals.linfF2
+              <<" saturation: "<<residuals.saturation<<" change: "<<residuals.saturationChange<<" cr: "<<convCr<<std::endl;
+    }
+    if (convergenceMeasure_ == "l2") {
+        return residuals.l2F1 < convCr && residuals.l2F2 < convCr;
+    }
+    if (convergenceMeasure_ == "linf") {
+        return residuals.linfF1 < convCr && residuals.linfF2 < convCr;
+    }
+    return residuals.saturationChange < convCr;
+}
+
+void MultiPhaseBase::setMicrostructureMesh(const MeshParams<T> & meshParams) {
+    if (meshParams.voxelSize <= 0 || meshParams.origin.size() != 3 || meshParams.inletLayers < 0) {
+        throw std::invalid_argument("stl voxel size must be positive, origin needs 3 coordinates and inlet layers must be non-negative");
+    }
+    meshParams_ = meshParams;
+}
+
+void MultiPhaseBase::setClusterAnalysis(const bool & clusterAnalysis) {
+    clusterAnalysis_ = clusterAnalysis;
+}
+
+void MultiPhaseBase::setOutputFormat(const std::string & outputFormat) {
+    if (outputFormat != "vtk" && outputFormat != "pvti" && outputFormat != "hdf5" && outputFormat != "delta") {
+        throw std::invalid_argument("output format must be vtk, pvti, hdf5 or delta");
+    }
+# ifndef HDF5
+    if (outputFormat == "hdf5") {
+        throw std::invalid_argument("hdf5 output requires a build with ENABLE_HDF5");
+    }
+# endif
+    outputFormat_ = outputFormat;
+}
+
+void MultiPhaseBase::setDeltaOutputTolerance(const T & tolerance) {
+    if (tolerance < 0) {
+        throw std::invalid_argument("delta output tolerance must be non-negative");
+    }
+    deltaOutputTolerance_ = tolerance;
+}
+
+void MultiPhaseBase::setProbes(const std::vector<ProbeParams> & probeParams) {
+    Box3D domain(0, nx_ - 1, 0, ny_ - 1, 0, nz_ - 1);
+    probes_.clear();
+    for (pluint iProbe = 0; iProbe < probeParams.size(); ++iProbe) {
+        const ProbeParams & params = probeParams[iProbe];
+        if (params.name.empty() || params.fields.empty()) {
+            throw std::invalid_argument("probes need a name and at least one field");
+        }
+        if (params.frequency <= 0) {
+            throw std::invalid_argument("probe " + params.name + ": frequency must be positive");
+        }
+        if (!contained(params.domain, domain)) {
+            throw std::invalid_argument("probe " + params.name + ": domain lies outside the lattice");
+        }
+        probes_.emplace_back(new probes::ProbeStream(params, outputDir_));
+    }
+}
+
 void MultiPhaseBase::setShanChen() {        
     std::vector <MultiBlockLattice3D<T, MPDESCRIPTOR> *> blockLattices;
     plint processorLevel = 1;
@@ -100,18 +237,24 @@ void MultiPhaseBase::setShanChen() {
 }
 
 void MultiPhaseBase::readGeometry() {
-    Box3D slicebox(0,0, 0,ny_-1, 0,nz_-1);
-    std::unique_ptr<MultiScalarField3D<int> > slice = generateMultiScalarField<int>(geometry_, slicebox);
-    plb_ifstream geometryfile(geoFileName_.c_str());
-    for (plint ix=0; ix<nx_; ++ix) {
-        if (!geometryfile.is_open()) {
-            pcout << "Error: could not open geometry file " << geoFileName_ << std::endl;
-            exit(EXIT_FAILURE);
+    std::string extension = geoFileName_.size() > 4 ? geoFileName_.substr(geoFileName_.size() - 4) : "";
+    if (extension == ".stl" || extension == ".STL") {
+        voxelizeGeometry();
+    }
+    else {
+        Box3D slicebox(0,0, 0,ny_-1, 0,nz_-1);
+        std::unique_ptr<MultiScalarField3D<int> > slice = generateMultiScalarField<int>(geometry_, slicebox);
+        plb_ifstream geometryfile(geoFileName_.c_str());
+        for (plint ix=0; ix<nx_; ++ix) {
+            if (!geometryfile.is_open()) {
+                pcout << "Error: could not open geometry file " << geoFileName_ << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            geometryfile >> *slice;
+            copy(*slice, slice->getBoundingBox(), geometry_, Box3D(ix,ix, 0,ny_-1, 0,nz_-1));
         }
-        geometryfile >> *slice;
-        copy(*slice, slice->getBoundingBox(), geometry_, Box3D(ix,ix, 0,ny_-1, 0,nz_-1));
+        geometryfile.close();
     }
-    geometryfile.close();
     {
         VtkImageOutput3D<T> vtkOut("porousMedium", 1.0);
         vtkOut.writeData<float>(*copyConvert<int, T> (geometry_, geometry_.getBoundingBox()), "tag", 1.0);
@@ -129,6 +272,29 @@ void MultiPhaseBase::readGeometry() {
     }        
 }
 
+void MultiPhaseBase::voxelizeGeometry() {
+    // the mesh is moved to lattice units; the voxelizer runs in parallel on the block
+    // distribution of geometry_, seeded as void at the origin corner, which must not lie
+    // inside the solid
+    TriangleSet<T> triangles(geoFileName_, DBL);
+    triangles.translate(Array<T,3>(-meshParams_.origin[0], -meshParams_.origin[1], -meshParams_.origin[2]));
+    triangles.scale((T) 1/meshParams_.voxelSize);
+    DEFscaledMesh<T> mesh(triangles);
+    plint borderWidth = 1;
+    std::unique_ptr<MultiScalarField3D<int> > voxels = voxelize(mesh.getMesh(), geometry_.getMultiBlockManagement(),
+            borderWidth, Box3D(0,0, 0,0, 0,0));
+
+    // inside of the mesh: solid, classified into surface and interior nodes below
+    Box3D domain = geometry_.getBoundingBox();
+    setToConstant(geometry_, domain, 0);
+    setToConstant(geometry_, *voxels, voxelFlag::inside, domain, 2);
+    setToConstant(geometry_, *voxels, voxelFlag::innerBorder, domain, 2);
+    if (meshParams_.inletLayers > 0) {
+        setToConstant(geometry_, Box3D(0, meshParams_.inletLayers - 1, 0, ny_ - 1, 0, nz_ - 1), 3);
+    }
+    mpfunctionals::classifySolidTags(geometry_, domain);
+}
+
 void MultiPhaseBase::initBoundaryPlanes() {
     // note that boundary planes are defined internally
     // will be useful for setting up pressure boundary coinditions for drainage simulations
@@ -143,42 +309,67 @@ void MultiPhaseBase::initBoundaryPlanes() {
 }
 
 void MultiPhaseBase::defineLatticeDynamics() {
+    defineLatticeDynamics(latticeFluidOne_, latticeFluidTwo_, geometry_);
+    if (fluidCellFraction_ > 0) {
+        std::vector<MultiBlockLattice3D<T, MPDESCRIPTOR> *> lattices;
+        lattices.push_back(& latticeFluidOne_);
+        lattices.push_back(& latticeFluidTwo_);
+        plint numListBlocks = fluidcells::setFluidCellLists(lattices, fluidCellFraction_);
+        pcout << "fluid-cell lists: " << numListBlocks << " of "
+              << latticeFluidOne_.getSparseBlockStructure().getNumBlocks() << " blocks" << std::endl;
+    }
+}
+
+void MultiPhaseBase::defineLatticeDynamics(MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidOne,
+                MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidTwo, MultiScalarField3D<int> & geometry) {
     // currently supports uniform wettability
     // 0: voids so no dynamics assigned
     // 1: surface nodes: bounce back with adhesion force
     // 2: interior solid nodes with bounce back or no dynamics for computational efficiency
+    // solid dynamics are stateless, so each block shares one instance per tag
     // interior solid nodes: no dynamics
-    defineDynamics(latticeFluidOne_, geometry_, new NoDynamics<T,MPDESCRIPTOR>(), 2);
-    defineDynamics(latticeFluidTwo_, geometry_, new NoDynamics<T,MPDESCRIPTOR>(), 2);
+    defineSharedDynamics(latticeFluidOne, geometry, new NoDynamics<T,MPDESCRIPTOR>(), 2);
+    defineSharedDynamics(latticeFluidTwo, geometry, new NoDynamics<T,MPDESCRIPTOR>(), 2);
 
     //surface nodes with wettability: bounce back and adhesion 
-    defineDynamics(latticeFluidOne_, geometry_, new BounceBack <T, MPDESCRIPTOR> (gF1S_), 1);
-    defineDynamics(latticeFluidTwo_, geometry_, new BounceBack <T, MPDESCRIPTOR> (-1.0*gF1S_), 1);
+    defineSharedDynamics(latticeFluidOne, geometry, new BounceBack <T, MPDESCRIPTOR> (gF1S_), 1);
+    defineSharedDynamics(latticeFluidTwo, geometry, new BounceBack <T, MPDESCRIPTOR> (-1.0*gF1S_), 1);
+
+    // collision and streaming only write populations: the externals are rebuilt
+    // on the envelope by the shan-chen processor, so the post-streaming halo
+    // exchange skips them
+    latticeFluidOne.setInternalTypeOfModification(modif::populations);
+    latticeFluidTwo.setInternalTypeOfModification(modif::populations);
 }
 
 
 void MultiPhaseBase::initializeLatticeDensities() {
+    initializeLatticeDensities(latticeFluidOne_, latticeFluidTwo_, geometry_);
+}
+
+void MultiPhaseBase::initializeLatticeDensities(MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidOne,
+                MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidTwo, MultiScalarField3D<int> & geometry) {
     // 3: wetting fluid 0: non wetting fluid
     // for example: in contact angle measurements spreading fluid: -1, air: 0 
     Array<T, 3> zeroVelocity(0., 0., 0.);
-    const plint nx = geometry_.getNx();
-    const plint ny = geometry_.getNy();
-    const plint nz = geometry_.getNz();
+    const plint nx = geometry.getNx();
+    const plint ny = geometry.getNy();
+    const plint nz = geometry.getNz();
 
     for (plint iX = 0; iX < nx; iX++) {
         for (plint iY = 0; iY < ny; iY++) {
             for (plint iZ = 0; iZ < nz; iZ++) {
-                plint tag = geometry_.get(iX, iY, iZ);
+                plint tag = geometry.get(iX, iY, iZ);
                 // inert fluid (latticeFluidTwo_)
                 if (tag == 0) {
-                    initializeAtEquilibrium(latticeFluidTwo_, Box3D(iX,iX,iY,iY,iZ,iZ), rhoF2_, zeroVelocity);
-                    initializeAtEquilibrium(latticeFluidOne_, Box3D(iX,iX,iY,iY,iZ,iZ), rhoNoFluid_, zeroVelocity);
+                    initializeAtEquilibrium(latticeFluidTwo, Box3D(iX,iX,iY,iY,iZ,iZ), rhoF2_, zeroVelocity);
+                    initializeAtEquilibrium(latticeFluidOne, Box3D(iX,iX,iY,iY,iZ,iZ), rhoNoFluid_, zeroVelocity);
                 }
                 // main fluid (latticeFluidOne_)
                 // for drainage simulation tag == 3 is a fluid that invades the domain (it should be a non wetting fluid)
                 else if (tag == 3) {
-                    initializeAtEquilibrium(latticeFluidOne_, Box3D(iX,iX,iY,iY,iZ,iZ), rhoF1_, zeroVelocity);
-                    initializeAtEquilibrium(latticeFluidTwo_, Box3D(iX,iX,iY,iY,iZ,iZ), rhoNoFluid_, zeroVelocity);
+                    initializeAtEquilibrium(latticeFluidOne, Box3D(iX,iX,iY,iY,iZ,iZ), rhoF1_, zeroVelocity);
+                    initializeAtEquilibrium(latticeFluidTwo, Box3D(iX,iX,iY,iY,iZ,iZ), rhoNoFluid_, zeroVelocity);
                 }
             }
         }
@@ -186,6 +377,28 @@ void MultiPhaseBase::initializeLatticeDensities() {
 }
 
 void MultiPhaseBase::addExternalForces() {
+    addExternalForces(latticeFluidOne_, latticeFluidTwo_);
+}
+
+void MultiPhaseBase::collideAndStream() {
+    collideAndStream(latticeFluidOne_, latticeFluidTwo_);
+    if (quiescentBlocks_) {
+        quiescentBlocks_->update();
+    }
+}
+
+// both lattices share one decomposition, so they form a single communication group;
+// fluid one goes first as the Shan-Chen coupling processor is integrated in fluid two
+void MultiPhaseBase::collideAndStream(MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidOne,
+                                      MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidTwo) {
+    std::vector<MultiBlockLattice3D<T, MPDESCRIPTOR>*> species(2);
+    species[0] = &latticeFluidOne;
+    species[1] = &latticeFluidTwo;
+    plb::collideAndStream(species);
+}
+
+void MultiPhaseBase::addExternalForces(MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidOne,
+                MultiBlockLattice3D<T, MPDESCRIPTOR> & latticeFluidTwo) {
     Array<T, 3> forceF1; 
     Array<T, 3> forceF2;
     
@@ -203,17 +416,18 @@ void MultiPhaseBase::addExternalForces() {
     }
 
     if (forceF1_ != 0.0) {
-        setExternalVector(latticeFluidOne_, latticeFluidOne_.getBoundingBox(),
+        setExternalVector(latticeFluidOne, latticeFluidOne.getBoundingBox(),
                     MPDESCRIPTOR<T>::ExternalField::forceBeginsAt, forceF1);
     }
 
     if (forceF2_ != 0.0) {
-        setExternalVector(latticeFluidTwo_, latticeFluidTwo_.getBoundingBox(),
+        setExternalVector(latticeFluidTwo, latticeFluidTwo.getBoundingBox(),
                 MPDESCRIPTOR<T>::ExternalField::forceBeginsAt, forceF2);    
     }
 }
 
 void MultiPhaseBase::initializeLattices() {
+    activateAllBlocks();
     latticeFluidOne_.initialize();
     latticeFluidTwo_.initialize();
 }
@@ -229,44 +443,135 @@ void MultiPhaseBase::setUp() {
     initializeLattices();
 }
 
+void MultiPhaseBase::initCoarseLevelBC(MultiBlockLattice3D<T, MPDESCRIPTOR> &, MultiBlockLattice3D<T, MPDESCRIPTOR> &) {
+    // imbibition: no boundary conditions other than the geometry
+}
+
+void MultiPhaseBase::runWarmStart(plint checkFreq, T convCr) {
+    // must be called after setUp(): geometry_ and the fine lattices are ready
+    // the tags are coarsened by sampling and the solid nodes are re-classified
+    // into surface and interior nodes on the coarse grid
+    std::unique_ptr<MultiScalarField3D<int> > coarseGeometry = coarsen(geometry_, 0, 0, warmStartLevels_, 0);
+    mpfunctionals::classifySolidTags(*coarseGeometry, coarseGeometry->getBoundingBox());
+    const plint cnx = coarseGeometry->getNx();
+    const plint cny = coarseGeometry->getNy();
+    const plint cnz = coarseGeometry->getNz();
+    pcout <<"warm start on a coarse lattice of "<<cnx<<" x "<<cny<<" x "<<cnz<<" >>> "<<std::endl;
+
+    // the coarse lattices take the block distribution and grid level of the coarse tags, which
+    // follow the (possibly tuned) distribution of the fine lattices: processors coupling blocks
+    // of different grid levels rescale their domains
+    MultiBlockManagement3D const & coarseManagement = coarseGeometry->getMultiBlockManagement();
+    MultiBlockLattice3D<T, MPDESCRIPTOR> coarseFluidOne(coarseManagement,
+        defaultMultiBlockPolicy3D().getBlockCommunicator(), defaultMultiBlockPolicy3D().getCombinedStatistics(),
+        defaultMultiBlockPolicy3D().getMultiCellAccess<T, MPDESCRIPTOR>(), latticeFluidOne_.getBackgroundDynamics().clone());
+    MultiBlockLattice3D<T, MPDESCRIPTOR> coarseFluidTwo(coarseManagement,
+        defaultMultiBlockPolicy3D().getBlockCommunicator(), defaultMultiBlockPolicy3D().getCombinedStatistics(),
+        defaultMultiBlockPolicy3D().getMultiCellAccess<T, MPDESCRIPTOR>(), latticeFluidTwo_.getBackgroundDynamics().clone());
+    for (plint iDim = 0; iDim < 3; ++iDim) {
+        bool isPeriodic = latticeFluidOne_.periodicity().get(iDim);
+        coarseFluidOne.periodicity().toggle(iDim, isPeriodic);
+        coarseFluidTwo.periodicity().toggle(iDim, isPeriodic);
+    }
+
+    std::vector <MultiBlockLattice3D<T, MPDESCRIPTOR> *> blockLattices;
+    blockLattices.push_back(& coarseFluidTwo);
+    blockLattices.push_back(& coarseFluidOne);
+    integrateProcessingFunctional(new ShanChenMultiComponentProcessor3D <T, MPDESCRIPTOR> (gc_, constOmegaValues_),
+         coarseFluidOne.getBoundingBox(), blockLattices, 1);
+
+    initCoarseLevelBC(coarseFluidOne, coarseFluidTwo);
+    defineLatticeDynamics(coarseFluidOne, coarseFluidTwo, *coarseGeometry);
+    initializeLatticeDensities(coarseFluidOne, coarseFluidTwo, *coarseGeometry);
+    addExternalForces(coarseFluidOne, coarseFluidTwo);
+    coarseFluidOne.initialize();
+    coarseFluidTwo.initialize();
+
+    T newAvgEnF1{}, newAvgEnF2{}, oldAvgEnF1{1.}, oldAvgEnF2{1.};
+    plint iT{0};
+    for (iT = 0; iT < warmStartMaxIter_; ++iT) {
+        collideAndStream(coarseFluidOne, coarseFluidTwo);
+        if (iT % checkFreq == 0) {
+            newAvgEnF1 = getStoredAverageDensity(coarseFluidOne);
+            newAvgEnF2 = getStoredAverageDensity(coarseFluidTwo);
+            if (simutils::hasConverged(oldAvgEnF1, oldAvgEnF2, newAvgEnF1, newAvgEnF2, (T) checkFreq, convCr)) {
+                break;
+            }
+            oldAvgEnF1 = newAvgEnF1;
+            oldAvgEnF2 = newAvgEnF2;
+        }
+    }
+    pcout <<"coarse warm start stage finished at iteration "<<iT<<std::endl;
+
+    // prolong the densities (trilinear interpolation) and re-initialize the fluid nodes
+    // the refined fields are copied onto the block distribution of the fine lattices; they can be
+    // a few nodes shorter than the fine lattice at the upper ends, where the last prolonged plane is repeated
+    T rhoMax = std::max(rhoF1_, rhoF2_);
+    std::unique_ptr<MultiScalarField3D<T> > refinedF1 = refine(*computeDensity(coarseFluidOne), 0, 0, -warmStartLevels_, 0);
+    std::unique_ptr<MultiScalarField3D<T> > refinedF2 = refine(*computeDensity(coarseFluidTwo), 0, 0, -warmStartLevels_, 0);
+    Box3D fineDomain;
+    intersect(refinedF1->getBoundingBox(), geometry_.getBoundingBox(), fineDomain);
+    std::unique_ptr<MultiScalarField3D<T> > rhoF1 = generateMultiScalarField<T>(geometry_, geometry_.getBoundingBox());
+    std::unique_ptr<MultiScalarField3D<T> > rhoF2 = generateMultiScalarField<T>(geometry_, geometry_.getBoundingBox());
+    copy(*refinedF1, fineDomain, *rhoF1, fineDomain);
+    copy(*refinedF2, fineDomain, *rhoF2, fineDomain);
+    Box3D fullDomain = geometry_.getBoundingBox();
+    Box3D filled = fineDomain;
+    const plint filledUpper[3] = {filled.x1, filled.y1, filled.z1};
+    const plint fullUpper[3] = {fullDomain.x1, fullDomain.y1, fullDomain.z1};
+    for (plint iDim = 0; iDim < 3; ++iDim) {
+        Box3D lastPlane = filled;
+        if (iDim == 0) lastPlane.x0 = lastPlane.x1;
+        else if (iDim == 1) lastPlane.y0 = lastPlane.y1;
+        else lastPlane.z0 = lastPlane.z1;
+        for (plint iPlane = filledUpper[iDim] + 1; iPlane <= fullUpper[iDim]; ++iPlane) {
+            Box3D plane = lastPlane;
+            if (iDim == 0) plane.x0 = plane.x1 = iPlane;
+            else if (iDim == 1) plane.y0 = plane.y1 = iPlane;
+            else plane.z0 = plane.z1 = iPlane;
+            copy(*rhoF1, lastPlane, *rhoF1, plane);
+            copy(*rhoF2, lastPlane, *rhoF2, plane);
+        }
+        if (iDim == 0) filled.x1 = fullDomain.x1;
+        else if (iDim == 1) filled.y1 = fullDomain.y1;
+        else filled.z1 = fullDomain.z1;
+    }
+    mpfunctionals::iniEquilibriumFromDensity(latticeFluidOne_, *rhoF1, geometry_, fullDomain, rhoNoFluid_, rhoMax);
+    mpfunctionals::iniEquilibriumFromDensity(latticeFluidTwo_, *rhoF2, geometry_, fullDomain, rhoNoFluid_, rhoMax);
+    initializeLattices();
+}
+
 // checks convergence criteria
 void MultiPhaseBase::operator()(plint checkFreq, plint outputFreq, plint maxIter, T convCr) {
     setUp();
+    if (warmStartLevels_ > 0) {
+        runWarmStart(checkFreq, convCr);
+    }
     bool hasNotConverged{true};
     plint iT{0}, numOut{0};
-    T newAvgEnF1{}, newAvgEnF2{}, oldAvgEnF1{1.}, oldAvgEnF2{1.};
-    T relEF1{0}, relEF2{0};
 
-    
+    resetConvergence();
     for (iT = 0; iT < maxIter; ++iT) {
-        latticeFluidOne_.collideAndStream();
-        latticeFluidTwo_.collideAndStream();
+        collideAndStream();
+        sampleProbes();
         
         if ((iT % checkFreq == 0) && (hasNotConverged)) {
-            newAvgEnF1 = getStoredAverageDensity(latticeFluidOne_);
-            newAvgEnF2 = getStoredAverageDensity(latticeFluidTwo_);
-            relEF1 = std::fabs(oldAvgEnF1 - newAvgEnF1)*100.0/oldAvgEnF1/(T)checkFreq;
-            relEF2 = std::fabs(oldAvgEnF2 - newAvgEnF2)*100.0/oldAvgEnF2/(T)checkFreq;
-            pcout <<"the 1 energy value is "<<relEF1<<" cr: "<<convCr<<std::endl;
-            pcout <<"the 2 energy value is "<<relEF2<<" cr: "<<convCr<<std::endl;
-            if (simutils::hasConverged(oldAvgEnF1, oldAvgEnF2, newAvgEnF1, newAvgEnF2, (T) checkFreq, convCr)) {
+            if (checkConvergence(checkFreq, convCr, true)) {
                 hasNotConverged = false;
                 pcout <<"simulations converged at iteration "<<iT<<std::endl;
             }
             else {
                 pcout <<"simulations has not converged yet at "<<iT<<std::endl;
             }
-            oldAvgEnF1 = newAvgEnF1;
-            oldAvgEnF2 = newAvgEnF2;
+            if (clusterAnalysis_) {
+                analyzeClusters(iT);
+            }
         }
 
       //  if ((iT % outputFreq == 0) && !(hasNotConverged)) {
         if (iT % outputFreq == 0) {
             pcout <<"generating output ... "<<iT<<std::endl;            
-            writeRhoVTK(numOut);
-        
-        //    writeVelocityComponentsDAT(numOut);
-            writeRhoDistributionDAT(numOut);
+            writeFields(numOut, false);
             ++numOut;
         }
 
@@ -274,7 +579,113 @@ void MultiPhaseBase::operator()(plint checkFreq, plint outputFreq, plint maxIter
     writeSimulationDatFile();
 }
 
+bool MultiPhaseBase::analyzeClusters(plint it) {
+    std::string clusterFile = outputDir_ + "clusters.dat";
+    if (!clusterMatch_) {
+        plb_ofstream clusterHeader(clusterFile.c_str());
+        clusterHeader << "# iteration clusters trapped inlet_connected outlet_connected volume"
+                      << " trapped_volume residual_saturation" << std::endl;
+        phaseFlags_.reset(new MultiScalarField3D<int>(geometry_));
+        for (plint dir = 0; dir < 3; ++dir) {
+            phaseFlags_ -> periodicity().toggle(dir, latticeFluidOne_.periodicity().get(dir));
+        }
+        clusterMatch_.reset(new ClusterMatch3D(*phaseFlags_));
+        poreVolume_ = count(geometry_, mpfunctionals::IsFluidTag());
+    }
+
+    std::vector<MultiBlock3D *> blocks;
+    blocks.push_back(phaseFlags_.get());
+    blocks.push_back(& latticeFluidOne_);
+    blocks.push_back(& latticeFluidTwo_);
+    blocks.push_back(& geometry_);
+    applyProcessingFunctional(new mpfunctionals::DominantPhaseFlags3D<T, MPDESCRIPTOR>,
+        phaseFlags_ -> getBoundingBox(), blocks);
+    clusterMatch_ -> execute(*phaseFlags_, 2, inlet_, outlet_);
+
+    // the defending fluid leaves through the outlet: clusters without outlet contact are trapped
+    plint numClusters = clusterMatch_ -> numClusters();
+    plint numTrapped{0}, numInlet{0}, numOutlet{0};
+    T volume{0}, trappedVolume{0};
+    for (plint n = 0; n < numClusters; ++n) {
+        T clusterVolume = clusterMatch_ -> getClusterVolume().at(n);
+        volume += clusterVolume;
+        if (clusterMatch_ -> getTouchesInlet().at(n)) {
+            ++numInlet;
+        }
+        if (clusterMatch_ -> getTouchesOutlet().at(n)) {
+            ++numOutlet;
+        }
+        else {
+            ++numTrapped;
+            trappedVolume += clusterVolume;
+        }
+    }
+    T residualSaturation = poreVolume_ > 0 ? trappedVolume/(T)poreVolume_ : 0;
+    pcout << "f2 clusters: " << numClusters << " trapped: " << numTrapped
+          << " residual saturation: " << residualSaturation << std::endl;
+
+    plb_ofstream clusterInfo(clusterFile.c_str(), std::ostream::out | std::ostream::app);
+    clusterInfo << it << " " << numClusters << " " << numTrapped << " " << numInlet << " " << numOutlet
+                << " " << volume << " " << trappedVolume << " " << residualSaturation << std::endl;
+
+    return numOutlet > 0;
+}
+
 // output methods 
+void MultiPhaseBase::writeFields(plint it, bool withVelocity) {
+    if (outputFormat_ == "hdf5") {
+        writeFieldsHDF5(it);
+        return;
+    }
+    if (outputFormat_ == "delta") {
+        writeFieldsDelta(it);
+        return;
+    }
+    if (outputFormat_ == "pvti") {
+        writeRhoPVTI(it);
+    }
+    else {
+        writeRhoVTK(it);
+    }
+    if (withVelocity) {
+        writeVelocityComponentsDAT(it);
+    }
+    writeRhoDistributionDAT(it);
+}
+
+void MultiPhaseBase::writeFieldsHDF5(plint it) {
+# ifdef HDF5
+    std::vector<hdf5output::LocalField> fields;
+    fields.push_back(hdf5output::extractLocalField(*computeDensity(latticeFluidOne_), "f1_density"));
+    fields.push_back(hdf5output::extractLocalField(*computeDensity(latticeFluidTwo_), "f2_density"));
+    fields.push_back(hdf5output::extractLocalField(*computeVelocity(latticeFluidOne_), "f1_velocity"));
+    fields.push_back(hdf5output::extractLocalField(*computeVelocity(latticeFluidTwo_), "f2_velocity"));
+    fields.push_back(hdf5output::extractLocalField(geometry_, "geometry"));
+    hdf5output::writeStep(createFileName(outputDir_ + "fields_step_", it, 6),
+                          latticeFluidOne_.getMultiBlockManagement(), fields);
+# else
+    (void) it;
+# endif
+}
+
+void MultiPhaseBase::sampleProbes() {
+    for (pluint iProbe = 0; iProbe < probes_.size(); ++iProbe) {
+        probes_[iProbe]->sample(probeStep_, latticeFluidOne_, latticeFluidTwo_);
+    }
+    ++probeStep_;
+}
+
+// the stream is opened at the first output, after the lattices got their final decomposition
+void MultiPhaseBase::writeFieldsDelta(plint it) {
+    std::unique_ptr<MultiScalarField3D<T> > rhoF1 = computeDensity(latticeFluidOne_);
+    std::unique_ptr<MultiScalarField3D<T> > rhoF2 = computeDensity(latticeFluidTwo_);
+    if (!deltaStream_) {
+        deltaStream_.reset(new deltaoutput::DeltaStream(outputDir_, rhoF1->getMultiBlockManagement(),
+                                                        (double) deltaOutputTolerance_));
+    }
+    deltaStream_->write(it, *rhoF1, *rhoF2);
+}
+
 void MultiPhaseBase::writeRhoVTK(plint it) {
     
     std::string rhoF1 = createFileName(outputDir_ + "f1_rho_step_", it, 6);
@@ -287,6 +698,20 @@ void MultiPhaseBase::writeRhoVTK(plint it) {
     vtkOutF2.writeData<double> ((*computeDensity(latticeFluidTwo_)), "density", 1.);
 }
 
+// same fields as writeRhoVTK, but every rank writes its own blocks as .vti pieces
+// and a .pvti index ties them together
+void MultiPhaseBase::writeRhoPVTI(plint it) {
+
+    std::string rhoF1 = createFileName(outputDir_ + "f1_rho_step_", it, 6);
+    std::string rhoF2 = createFileName(outputDir_ + "f2_rho_step_", it, 6);
+
+    PartitionedVtkImageOutput3D<T> vtkOutF1(rhoF1, 1.0);
+    vtkOutF1.writeData<double> ((*computeDensity(latticeFluidOne_)), "density", 1.);
+
+    PartitionedVtkImageOutput3D<T> vtkOutF2(rhoF2, 1.0);
+    vtkOutF2.writeData<double> ((*computeDensity(latticeFluidTwo_)), "density", 1.);
+}
+
 
 void MultiPhaseBase::writeVelocityComponentsDAT(plint it) {
     
@@ -333,7 +758,7 @@ void MultiPhaseBase::writeRhoDistributionDAT(plint it) {
 
 }
 
-void MultiPhaseBase::addSimulationGeneralInfo(plb_ofstream & simInfo) {
+void MultiPhaseBase::addSimulationGeneralInfo(plb_ofstream & simInfo) const {
     simInfo<<"f1_ads: "<<gF1S_<<std::endl;
     simInfo<<"diss_rho: "<<rhoNoFluid_<<std::endl;
 }
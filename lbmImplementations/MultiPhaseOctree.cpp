@@ -0,0 +1,273 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */  
+/*                                                                                  */                                                                                      
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */ 
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// implementations of methods defined in MultiPhaseOctree
+# include "../lbmDeclarations/MultiPhaseOctree.h"
+
+void MultiPhaseOctree::setOctree(const OctreeParams & octreeParams) {
+    if (octreeParams.levels < 1) {
+        throw std::invalid_argument("octree needs at least one coarser level");
+    }
+    if (octreeParams.blockSize < 6 || octreeParams.blockSize % 2 != 0) {
+        throw std::invalid_argument("octree block size must be even and at least 6");
+    }
+    if (octreeParams.minRadius < 1) {
+        throw std::invalid_argument("octree minimum pore radius must be positive");
+    }
+    octree_ = octreeParams;
+}
+
+MultiPhaseOctree::~MultiPhaseOctree() {
+    // the actions refer to the blocks of the groups, which own the level lattices
+    for (pluint iL = 0; iL < stepsOne_.size(); ++iL) {
+        delete stepsOne_[iL];
+        delete stepsTwo_[iL];
+    }
+    actionsOne_.reset();
+    actionsTwo_.reset();
+    for (pluint iL = 0; iL < groupsOne_.size(); ++iL) {
+        delete groupsOne_[iL];
+        delete groupsTwo_[iL];
+    }
+}
+
+void MultiPhaseOctree::setUp() {
+    readGeometry();
+
+    // the finest octree level maps one to one onto the voxels: the smallest dimension is
+    // blockSize*2^maxLevel and every dimension an even number of coarsest blocks
+    plint minSize = std::min(nx_, std::min(ny_, nz_));
+    plint maxLevel{0};
+    while ((octree_.blockSize << (maxLevel + 1)) <= minSize) {
+        ++maxLevel;
+    }
+    plint coarsestNodes = (plint) 2 << maxLevel;
+    if ((octree_.blockSize << maxLevel) != minSize ||
+            nx_ % coarsestNodes != 0 || ny_ % coarsestNodes != 0 || nz_ % coarsestNodes != 0) {
+        throw std::invalid_argument("octree: the smallest domain size must be block size * 2^p "
+            "and every domain size a multiple of 2^(p+1)");
+    }
+    if (octree_.levels > maxLevel) {
+        throw std::invalid_argument("octree: more levels than the domain size allows for this block size");
+    }
+
+    std::string densityFile = outputDir_ + "octree_density.dat";
+    octree::writeGridDensity<T>(geometry_, octree_.levels, octree_.minRadius, octree_.blockSize, densityFile);
+    OctreeGridGenerator<T> generator(Cuboid<T>(0, nx_, 0, ny_, 0, nz_), densityFile,
+        (int) (maxLevel - octree_.levels), (int) maxLevel, octree_.blockSize, global::mpi().getSize(),
+        false, false, false, (T) 1, false, -1, 100, true, true, 0, -1, false, outputDir_, false, true, "octree");
+    ogs_ = generator.generateOctreeGridStructure();
+    tagLevel_ = maxLevel - generator.getMinLevel();
+
+    for (plint iL = 0; iL < ogs_.getNumLevels(); ++iL) {
+        setUpLevel(iL);
+    }
+    setUpCoupling(groupsOne_, actionsOne_, stepsOne_);
+    setUpCoupling(groupsTwo_, actionsTwo_, stepsTwo_);
+}
+
+void MultiPhaseOctree::setUpLevel(plint iL) {
+    // level iL runs on the grid coarsened 2^k times: convective scaling (dt ~ dx) halves
+    // the lattice viscosity and doubles the lattice force per coarsening
+    plint k = tagLevel_ - iL;
+    std::vector<T> omegas = constOmegaValues_;
+    for (plint iK = 0; iK < k; ++iK) {
+        for (pluint iO = 0; iO < omegas.size(); ++iO) {
+            omegas[iO] = (T) 2*omegas[iO]/((T) 1 + (T) 0.5*omegas[iO]);
+        }
+    }
+    T forceScale = (T) ((plint) 1 << k);
+    MultiBlockManagement3D management = ogs_.getMultiBlockManagement(iL, 1);
+
+    // tags of the level: the voxel tags sampled on the coarse nodes, solid nodes re-classified
+    levelTags_.emplace_back(defaultGenerateMultiScalarField3D<int>(management, 0).release());
+    MultiScalarField3D<int> & tags = *levelTags_.back();
+    std::unique_ptr<MultiScalarField3D<int> > coarseGeometry;
+    MultiScalarField3D<int> * source = & geometry_;
+    if (k > 0) {
+        coarseGeometry = coarsen(geometry_, 0, 0, k, 0);
+        mpfunctionals::classifySolidTags(*coarseGeometry, coarseGeometry->getBoundingBox());
+        source = coarseGeometry.get();
+    }
+    source->setRefinementLevel(iL);
+    Box3D domain;
+    intersect(source->getBoundingBox(), tags.getBoundingBox(), domain);
+    copy(*source, domain, tags, domain);
+
+    Dynamics<T, MPDESCRIPTOR> * dynamicsOne = latticeFluidOne_.getBackgroundDynamics().clone();
+    Dynamics<T, MPDESCRIPTOR> * dynamicsTwo = latticeFluidTwo_.getBackgroundDynamics().clone();
+    dynamicsOne->setOmega(omegas[0]);
+    dynamicsTwo->setOmega(omegas[1]);
+    MultiBlockLattice3D<T, MPDESCRIPTOR> * latticeOne = generateMultiBlockLattice<T, MPDESCRIPTOR>(management, dynamicsOne).release();
+    MultiBlockLattice3D<T, MPDESCRIPTOR> * latticeTwo = generateMultiBlockLattice<T, MPDESCRIPTOR>(management, dynamicsTwo).release();
+    latticeOne->periodicity().toggleAll(false);
+    latticeTwo->periodicity().toggleAll(false);
+    groupsOne_.push_back(new Group3D(latticeOne, "lattice"));
+    groupsTwo_.push_back(new Group3D(latticeTwo, "lattice"));
+
+    std::vector <MultiBlockLattice3D<T, MPDESCRIPTOR> *> blockLattices;
+    blockLattices.push_back(latticeTwo);
+    blockLattices.push_back(latticeOne);
+    integrateProcessingFunctional(new ShanChenMultiComponentProcessor3D <T, MPDESCRIPTOR> (gc_, omegas),
+         latticeOne->getBoundingBox(), blockLattices, 1);
+    defineLatticeDynamics(*latticeOne, *latticeTwo, tags);
+
+    Array<T, 3> direction(forceDir_ == "x" ? 1. : 0., forceDir_ == "y" ? 1. : 0., forceDir_ == "z" ? 1. : 0.);
+    if (forceF1_ != 0.0) {
+        setExternalVector(*latticeOne, latticeOne->getBoundingBox(), MPDESCRIPTOR<T>::ExternalField::forceBeginsAt,
+            direction*(forceF1_*forceScale));
+    }
+    if (forceF2_ != 0.0) {
+        setExternalVector(*latticeTwo, latticeTwo->getBoundingBox(), MPDESCRIPTOR<T>::ExternalField::forceBeginsAt,
+            direction*(forceF2_*forceScale));
+    }
+    mpfunctionals::iniEquilibriumFromTags(*latticeOne, *latticeTwo, tags, rhoF1_, rhoF2_, rhoNoFluid_);
+    latticeOne->initialize();
+    latticeTwo->initialize();
+}
+
+void MultiPhaseOctree::setUpCoupling(std::vector<Group3D *> & groups, std::unique_ptr<LevelActions> & actions,
+                                     std::vector<Actions3D *> & steps) {
+    generateHelperBlocks<T, MPDESCRIPTOR>(groups, ogs_, 0);
+    // the background dynamics must be the one of the coarsest level; the populations are
+    // copied across the interfaces, not filtered
+    actions.reset(new LevelActions(ogs_, groups[0]->getLattice<T, MPDESCRIPTOR>("lattice").getBackgroundDynamics().clone(),
+        0, groups, 1, false));
+    steps = actions->generateActions();
+    actions->addCollideAndStream(steps);
+    actions->addDefaultCouplings(steps);
+
+    // solid nodes of the coarse helper tensors are filled after every decomposition (and once
+    // for the initial state), before they are interpolated onto the finer level
+    for (plint iL = 0; iL < ogs_.getNumLevels() - 1; ++iL) {
+        MultiBlockLattice3D<T, MPDESCRIPTOR> & lattice = groups[iL]->getLattice<T, MPDESCRIPTOR>("lattice");
+        MultiNTensorField3D<T> & t0 = groups[iL]->getNTensor<T>("decomposed_t0");
+        MultiNTensorField3D<T> & t1 = groups[iL]->getNTensor<T>("decomposed_t1");
+        MultiNTensorField3D<T> & t12 = groups[iL]->getNTensor<T>("decomposed_t12");
+        Actions3D & step1 = steps[iL]->getActions(1);
+        step1.addProcessor(new octree::FillSolidDecomposed3D<T, MPDESCRIPTOR>(rhoNoFluid_), 0, 1, t0.getBoundingBox());
+        step1.addCommunication(1, modif::staticVariables);
+        step1.addProcessor(new octree::FillSolidDecomposed3D<T, MPDESCRIPTOR>(rhoNoFluid_), 0, 3, t12.getBoundingBox());
+        step1.addCommunication(3, modif::staticVariables);
+        applyProcessingFunctional(new octree::FillSolidDecomposed3D<T, MPDESCRIPTOR>(rhoNoFluid_), t0.getBoundingBox(), lattice, t0);
+        applyProcessingFunctional(new octree::FillSolidDecomposed3D<T, MPDESCRIPTOR>(rhoNoFluid_), t1.getBoundingBox(), lattice, t1);
+    }
+}
+
+// both species run each step of a level before the next one: fluid one goes first as the
+// shan-chen coupling processor is integrated in fluid two (executed at the end of its step 0)
+void MultiPhaseOctree::iterateLevel(plint iL) {
+    if (iL == ogs_.getNumLevels() - 1) {
+        stepsOne_[iL]->execute(0);
+        stepsTwo_[iL]->execute(0);
+        return;
+    }
+    // steps 2 and 4 are the two sub-steps of the next finer level
+    for (plint iS = 0; iS < 6; ++iS) {
+        if (iS == 2 || iS == 4) {
+            iterateLevel(iL + 1);
+        }
+        else {
+            stepsOne_[iL]->execute(iS);
+            stepsTwo_[iL]->execute(iS);
+        }
+    }
+}
+
+void MultiPhaseOctree::writeLevelsVTK(plint it) {
+    // one image per level and species, in voxel units; nodes outside the level are zero
+    for (plint iL = 0; iL < ogs_.getNumLevels(); ++iL) {
+        T dx = (T) ((plint) 1 << (tagLevel_ - iL));
+        std::string level = "level" + std::to_string(iL) + "_step_";
+        for (plint iF = 0; iF < 2; ++iF) {
+            Group3D & group = iF == 0 ? *groupsOne_[iL] : *groupsTwo_[iL];
+            MultiBlockLattice3D<T, MPDESCRIPTOR> & lattice = group.getLattice<T, MPDESCRIPTOR>("lattice");
+            Box3D box = lattice.getBoundingBox();
+            std::unique_ptr<MultiScalarField3D<T> > density = computeDensity(lattice);
+            std::unique_ptr<MultiScalarField3D<T> > image = generateMultiScalarField<T>(box, (T) 0, 1);
+            image->setRefinementLevel(iL);
+            copy(*density, box, *image, box);
+            std::string fileName = createFileName(outputDir_ + (iF == 0 ? "f1_rho_" : "f2_rho_") + level, it, 6);
+            VtkImageOutput3D<T> vtkOut(fileName, dx, Array<double, 3>(box.x0*dx, box.y0*dx, box.z0*dx));
+            vtkOut.writeData<double>(*image, "density", 1.);
+        }
+    }
+}
+
+void MultiPhaseOctree::writeSimulationDatFile() {
+    MultiPhaseBase::writeSimulationDatFile();
+    std::string simFile = outputDir_ + "simulation.dat";
+    plb_ofstream simInfo(simFile.c_str(), std::ostream::out | std::ostream::app);
+    simInfo<<"octree_levels: "<<ogs_.getNumLevels()<<std::endl;
+    for (plint iL = 0; iL < ogs_.getNumLevels(); ++iL) {
+        simInfo<<"level_"<<iL<<"_dx: "<<((plint) 1 << (tagLevel_ - iL))
+               <<" fluid_nodes: "<<count(*levelTags_[iL], mpfunctionals::IsFluidTag())<<std::endl;
+    }
+}
+
+void MultiPhaseOctree::operator()(plint checkFreq, plint outputFreq, plint maxIter, T convCr) {
+    setUp();
+    plint numLevels = ogs_.getNumLevels();
+    plint octreeNodes{0};
+    for (plint iL = 0; iL < numLevels; ++iL) {
+        plint levelNodes = groupsOne_[iL]->getLattice<T, MPDESCRIPTOR>("lattice").getMultiBlockManagement()
+            .getSparseBlockStructure().getNumBulkCells();
+        octreeNodes += levelNodes;
+        pcout <<"octree level "<<iL<<" (dx "<<((plint) 1 << (tagLevel_ - iL))<<"): "<<levelNodes<<" nodes"<<std::endl;
+    }
+    pcout <<"octree lattices: "<<octreeNodes<<" nodes for "<<nx_*ny_*nz_<<" voxels"<<std::endl;
+
+    bool hasNotConverged{true};
+    plint iT{0}, numOut{0};
+    T newAvgEnF1{}, newAvgEnF2{}, oldAvgEnF1{1.}, oldAvgEnF2{1.};
+    T relEF1{0}, relEF2{0};
+
+    for (iT = 0; iT < maxIter; ++iT) {
+        iterateLevel(0);
+
+        if ((iT % checkFreq == 0) && (hasNotConverged)) {
+            // mean over the levels of the average densities
+            newAvgEnF1 = 0;
+            newAvgEnF2 = 0;
+            for (plint iL = 0; iL < numLevels; ++iL) {
+                newAvgEnF1 += computeAverageDensity(groupsOne_[iL]->getLattice<T, MPDESCRIPTOR>("lattice"))/(T) numLevels;
+                newAvgEnF2 += computeAverageDensity(groupsTwo_[iL]->getLattice<T, MPDESCRIPTOR>("lattice"))/(T) numLevels;
+            }
+            relEF1 = std::fabs(oldAvgEnF1 - newAvgEnF1)*100.0/oldAvgEnF1/(T)checkFreq;
+            relEF2 = std::fabs(oldAvgEnF2 - newAvgEnF2)*100.0/oldAvgEnF2/(T)checkFreq;
+            pcout <<"the 1 energy value is "<<relEF1<<" cr: "<<convCr<<std::endl;
+            pcout <<"the 2 energy value is "<<relEF2<<" cr: "<<convCr<<std::endl;
+            if (simutils::hasConverged(oldAvgEnF1, oldAvgEnF2, newAvgEnF1, newAvgEnF2, (T) checkFreq, convCr)) {
+                hasNotConverged = false;
+                pcout <<"simulations converged at iteration "<<iT<<std::endl;
+            }
+            else {
+                pcout <<"simulations has not converged yet at "<<iT<<std::endl;
+            }
+            oldAvgEnF1 = newAvgEnF1;
+            oldAvgEnF2 = newAvgEnF2;
+        }
+
+        if (iT % outputFreq == 0) {
+            pcout <<"generating output ... "<<iT<<std::endl;
+            writeLevelsVTK(numOut);
+            ++numOut;
+        }
+    }
+    writeSimulationDatFile();
+}
@@ -44,6 +44,7 @@ void MultiPhasePressure::initPressureBC() {
 }
 
 void MultiPhasePressure::setPressureBoundaryValues(T rhoInlet, T rhoOutlet) {
+    activateAllBlocks();
     // inlets
     setBoundaryDensity(latticeFluidOne_, inlet_, rhoInlet);
     setBoundaryDensity(latticeFluidTwo_, inlet_, rhoNoFluid_);
@@ -52,6 +53,24 @@ void MultiPhasePressure::setPressureBoundaryValues(T rhoInlet, T rhoOutlet) {
     setBoundaryDensity(latticeFluidTwo_, outlet_, rhoOutlet);
 }
 
+void MultiPhasePressure::initCoarseLevelBC(MultiBlockLattice3D<T, MPDESCRIPTOR> & coarseFluidOne,
+                            MultiBlockLattice3D<T, MPDESCRIPTOR> & coarseFluidTwo) {
+    // pressure boundaries of the first pressure step; planes as in initBoundaryPlanes()
+    Box3D domain = coarseFluidOne.getBoundingBox();
+    Box3D inlet(1, 2, 1, domain.y1 - 1, 1, domain.z1 - 1);
+    Box3D outlet(domain.x1 - 1, domain.x1, 1, domain.y1 - 1, 1, domain.z1 - 1);
+    std::unique_ptr<OnLatticeBoundaryCondition3D<T, MPDESCRIPTOR> > coarseBC(createLocalBoundaryCondition3D<T, MPDESCRIPTOR>());
+
+    coarseBC -> addPressureBoundary0N(inlet, coarseFluidOne);
+    coarseBC -> addPressureBoundary0N(inlet, coarseFluidTwo);
+    coarseBC -> addPressureBoundary0P(outlet, coarseFluidOne);
+    coarseBC -> addPressureBoundary0P(outlet, coarseFluidTwo);
+
+    setBoundaryDensity(coarseFluidOne, inlet, rhoInitInlet_);
+    setBoundaryDensity(coarseFluidTwo, inlet, rhoNoFluid_);
+    setBoundaryDensity(coarseFluidOne, outlet, rhoNoFluid_);
+    setBoundaryDensity(coarseFluidTwo, outlet, rhoInitOutlet_);
+}
 
 void MultiPhasePressure::setUp() {
     setShanChen();
@@ -70,44 +89,46 @@ void MultiPhasePressure::setUp() {
 void MultiPhasePressure::operator()(plint maxIter, plint checkFreq, plint outputFreq, T convCr) {
     // outputs are generated at the end of each converged step
     setUp();
+    if (warmStartLevels_ > 0) {
+        runWarmStart(checkFreq, convCr);
+    }
     bool hasNotConverged{true};
     plint iT{0}, numOut{0}, totalNumIter{0};
-    T newAvgEnF1{}, newAvgEnF2{}, oldAvgEnF1{1.}, oldAvgEnF2{1.};
     T cyclePressure{0.};
-    T volume = (T)(nx_*ny_*ny_);
+    bool allTrapped{false};
 
   
-    for (plint numRun = 0; numRun < totalNumRuns_; ++numRun) {
+    for (plint numRun = 0; numRun < totalNumRuns_ && !allTrapped; ++numRun) {
         if (numRun > 0) {
             setPressureBoundaryValues(inletRhoValues_[numRun], outletRhoValues_[numRun]);        
         }
         cyclePressure = (1./3.)*(inletRhoValues_.at(numRun) - outletRhoValues_.at(numRun));
         hasNotConverged = true;
-        oldAvgEnF1 = 1.0;
-        oldAvgEnF2 = 1.0;
+        resetConvergence();
         iT = 0;
         while (hasNotConverged) {
 
-            latticeFluidOne_.collideAndStream();
-            latticeFluidTwo_.collideAndStream();
+            collideAndStream();
+            sampleProbes();
 
             if (totalNumIter % outputFreq == 0) {
-                writeRhoVTK(numOut);
-                writeVelocityComponentsDAT(numOut);   
-                writeRhoDistributionDAT(numOut);
+                writeFields(numOut);
                 pressureValues_.push_back(cyclePressure);
                 ++numOut;                 
             }
 
             if (iT % checkFreq == 0) {
-                newAvgEnF1 = getStoredAverageDensity(latticeFluidOne_)*(volume);
-                newAvgEnF2 = getStoredAverageDensity(latticeFluidTwo_)*(volume);
-             
-                if (simutils::hasConverged(oldAvgEnF1, oldAvgEnF2, newAvgEnF1, newAvgEnF2, (T) checkFreq, convCr)) {
+                // a step ends at its first converged check
+                if (checkConvergence(checkFreq, convCr)) {
+                    hasNotConverged = false;
+                }
+
+                // once all defending clusters are trapped, the next steps cannot displace them
+                if (clusterAnalysis_ && !analyzeClusters(totalNumIter)) {
+                    pcout << "all f2 clusters are trapped: pressure steps stopped" << std::endl;
+                    allTrapped = true;
                     hasNotConverged = false;
                 }
-                oldAvgEnF1 = newAvgEnF1;
-                oldAvgEnF2 = newAvgEnF2;
             }
 
             if (iT >= maxIter) {
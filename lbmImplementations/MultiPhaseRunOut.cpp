@@ -19,6 +19,8 @@
 
 # include "../lbmDeclarations/MultiPhaseRunOut.h"
 
+# include <iomanip>
+
 
 void MultiPhaseRunOut::setInletOutletDensities() {
     T cosTheta = std::abs(4.*gF1S_/(gc_*(rhoInitInlet_ - rhoNoFluid_)));
@@ -44,6 +46,7 @@ void MultiPhaseRunOut::initPressureBC() {
 
 
 void MultiPhaseRunOut::setPressureBoundaryValues(T rhoInlet, T rhoOutlet) {
+    activateAllBlocks();
     // tag 0: fluid Two; tag 3: fluid One 
     setBoundaryDensity(latticeFluidTwo_, inlet_, rhoInlet);
     setBoundaryDensity(latticeFluidTwo_, outlet_, rhoOutlet);
@@ -68,33 +71,113 @@ void MultiPhaseRunOut::setUp() {
     initializeLattices();
 }
 
+void MultiPhaseRunOut::setEquilibriumCache(const std::string & cacheDir) {
+    equilibriumCacheDir_ = cacheDir;
+    if (!equilibriumCacheDir_.empty() && equilibriumCacheDir_[equilibriumCacheDir_.size() - 1] != '/') {
+        equilibriumCacheDir_ += "/";
+    }
+}
+
+std::string MultiPhaseRunOut::equilibriumKey(plint maxIter, plint checkFreq, T convCr) {
+    // the tag sum is taken in double precision on every rank; the file is read by the main processor
+    T tagSum = computeSum(*copyConvert<int, T>(geometry_, geometry_.getBoundingBox()));
+    std::ostringstream key;
+    key << std::setprecision(17);
+    if (global::mpi().isMainProcessor()) {
+        key << "microstructure: " << std::hex << simutils::hashFile(geoFileName_) << std::dec
+            << " tags: " << tagSum << std::endl;
+    }
+    key << "stl: " << meshParams_.voxelSize << " " << meshParams_.origin.at(0) << " " << meshParams_.origin.at(1)
+        << " " << meshParams_.origin.at(2) << " " << meshParams_.inletLayers << std::endl;
+    key << "domain: " << nx_ << " " << ny_ << " " << nz_ << " periodic: " << xPeriod_ << " " << yPeriod_
+        << " " << zPeriod_ << std::endl;
+    key << "densities: " << rhoF1_ << " " << rhoF2_ << " " << rhoNoFluid_ << " " << rhoInitInlet_
+        << " " << rhoInitOutlet_ << std::endl;
+    key << "gc: " << gc_ << " f1_ads: " << gF1S_ << std::endl;
+    key << "omegas:";
+    for (pluint iOmega = 0; iOmega < constOmegaValues_.size(); ++iOmega) {
+        key << " " << constOmegaValues_[iOmega];
+    }
+    key << std::endl;
+    key << "forces: " << forceF1_ << " " << forceF2_ << " " << forceDir_ << std::endl;
+    key << "iterations: " << maxIter << " check: " << checkFreq << " criterion: " << convCr
+        << " measure: " << convergenceMeasure_ << std::endl;
+    key << "quiescent: " << quiescentInterval_ << " " << quiescentTolerance_ << std::endl;
+    std::string text = key.str();
+    global::mpi().bCast(text);
+    return text;
+}
+
+// the cache holds both lattices (palabos checkpoints, independent of the decomposition) and a
+// text file with the equilibrium parameters; the hash of the parameters only names the files
+// and the text file, written last, must match them exactly
+void MultiPhaseRunOut::equilibrate(plint maxIter, plint outputFreq, plint checkFreq, T convCr,
+                                   const std::string & stage) {
+    if (equilibriumCacheDir_.empty()) {
+        runEquilibrium(maxIter, outputFreq, checkFreq, convCr);
+        return;
+    }
+    std::string key = "stage: " + stage + "\n" + equilibriumKey(maxIter, checkFreq, convCr);
+    std::ostringstream baseName;
+    baseName << equilibriumCacheDir_ << "equilibrium_" << std::hex << simutils::hashText(key);
+    std::string stateFile = baseName.str() + ".txt";
+
+    std::string state;
+    if (global::mpi().isMainProcessor()) {
+        std::ifstream cached(stateFile.c_str());
+        std::string line, cachedKey;
+        if (std::getline(cached, line)) {
+            std::getline(cached, cachedKey, '\0');
+            if (cachedKey == key) {
+                state = line;
+            }
+        }
+    }
+    global::mpi().bCast(state);
+
+    if (!state.empty()) {
+        loadBinaryBlock(latticeFluidOne_, baseName.str() + "_f1.dat");
+        loadBinaryBlock(latticeFluidTwo_, baseName.str() + "_f2.dat");
+        latticeFluidOne_.duplicateOverlaps(modif::dataStructure);
+        latticeFluidTwo_.duplicateOverlaps(modif::dataStructure);
+        activateAllBlocks();
+        std::istringstream counters(state);
+        std::string label;
+        counters >> label >> outCounter_ >> probeStep_;
+        pcout << "equilibrium stage loaded from " << baseName.str() << std::endl;
+        return;
+    }
+
+    runEquilibrium(maxIter, outputFreq, checkFreq, convCr);
+    saveBinaryBlock(latticeFluidOne_, baseName.str() + "_f1.dat");
+    saveBinaryBlock(latticeFluidTwo_, baseName.str() + "_f2.dat");
+    if (global::mpi().isMainProcessor()) {
+        std::ofstream cached(stateFile.c_str());
+        cached << "state: " << outCounter_ << " " << probeStep_ << std::endl << key;
+    }
+    pcout << "equilibrium stage stored in " << baseName.str() << std::endl;
+}
+
 void MultiPhaseRunOut::runEquilibrium(plint maxIter, plint outputFreq, plint checkFreq, T convCr) {
     // to simulate the initial imbibition stage 
     bool hasNotConverged{true};
     plint iT{0};
-    T newAvgEnF1{}, newAvgEnF2{}, oldAvgEnF1{1.}, oldAvgEnF2{1.};
 
     pcout <<"performing the initial imbibition stage >>> "<<std::endl;
+    resetConvergence();
 
     for (iT = 0; iT < maxIter; ++iT) {
-        latticeFluidOne_.collideAndStream();
-        latticeFluidTwo_.collideAndStream();
+        collideAndStream();
+        sampleProbes();
         
         if ((iT % checkFreq == 0) && (hasNotConverged)) {
-            newAvgEnF1 = getStoredAverageDensity(latticeFluidOne_);
-            newAvgEnF2 = getStoredAverageDensity(latticeFluidTwo_);
-           
-            if (simutils::hasConverged(oldAvgEnF1, oldAvgEnF2, newAvgEnF1, newAvgEnF2, (T) checkFreq, convCr)) {
+            if (checkConvergence(checkFreq, convCr)) {
                 hasNotConverged = false;
             }
-            oldAvgEnF1 = newAvgEnF1;
-            oldAvgEnF2 = newAvgEnF2;
         }
 
         if ((iT % outputFreq == 0)) {
-            writeRhoVTK(outCounter_);
-            writeVelocityComponentsDAT(outCounter_);
-            writeRhoDistributionDAT(outCounter_);
+            writeFields(outCounter_);
             ++outCounter_;
         }
 
@@ -108,8 +191,6 @@ void MultiPhaseRunOut::runPressureRamp(plint maxRampIter, plint outputFreq, plin
     pcout <<"performing the pressure ramp stage >>> "<<std::endl;
     bool hasNotConverged{true};
     plint iT{0}, totalNumIter{0};
-    T newAvgEnF1{}, newAvgEnF2{}, oldAvgEnF1{1.}, oldAvgEnF2{1.};
-    T volume = (T)(nx_*ny_*ny_);
 
     for (plint numRun = 0; numRun < totalNumRuns_; ++numRun) {
         if (numRun > 0) {
@@ -117,28 +198,21 @@ void MultiPhaseRunOut::runPressureRamp(plint maxRampIter, plint outputFreq, plin
         }
         
         hasNotConverged = true;
-        oldAvgEnF1 = 1.0;
-        oldAvgEnF2 = 1.0;
+        resetConvergence();
         iT = 0;
         while (hasNotConverged) {
-            latticeFluidOne_.collideAndStream();
-            latticeFluidTwo_.collideAndStream();
+            collideAndStream();
+            sampleProbes();
 
             if (totalNumIter % outputFreq == 0) {
-                writeRhoVTK(outCounter_);
-              //  writeVelocityComponentsDAT(numOut);   
-                writeRhoDistributionDAT(outCounter_);
+                writeFields(outCounter_, false);
                 ++outCounter_;                 
             }
 
             if (iT % checkFreq == 0) {
-                newAvgEnF1 = getStoredAverageDensity(latticeFluidOne_)*(volume);
-                newAvgEnF2 = getStoredAverageDensity(latticeFluidTwo_)*(volume);
-                if (simutils::hasConverged(oldAvgEnF1, oldAvgEnF2, newAvgEnF1, newAvgEnF2, (T) checkFreq, convCr)) {
+                if (checkConvergence(checkFreq, convCr)) {
                     hasNotConverged = false;
                 }
-                oldAvgEnF1 = newAvgEnF1;
-                oldAvgEnF2 = newAvgEnF2;
             }
 
             if (iT >= maxRampIter) {
@@ -153,7 +227,7 @@ void MultiPhaseRunOut::runPressureRamp(plint maxRampIter, plint outputFreq, plin
 void MultiPhaseRunOut::operator()(plint maxIter, plint maxRampIter, plint outputFreq, plint checkFreq, T convCr) {
     setShanChen();
     setUp();
-    runEquilibrium(maxIter, outputFreq, checkFreq, convCr);
+    equilibrate(maxIter, outputFreq, checkFreq, convCr, "runout");
     runPressureRamp(maxRampIter, outputFreq, checkFreq, convCr);
 }
 
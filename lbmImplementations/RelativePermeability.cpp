@@ -0,0 +1,133 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */  
+/*                                                                                  */                                                                                      
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */ 
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// implementations of methods defined in RelativePermeability
+# include "../lbmDeclarations/RelativePermeability.h"
+
+void RelativePermeability::setRelPerm(const RelPermParams & relPermParams) {
+    if (relPermParams.numSaturations < 1) {
+        throw std::invalid_argument("number of saturation steps must be positive");
+    }
+    relPerm_ = relPermParams;
+}
+
+void RelativePermeability::setUp() {
+    if (forceDir_ == "x") {
+        forceAxis_ = 0;
+    }
+    else if (forceDir_ == "y") {
+        forceAxis_ = 1;
+    }
+    else if (forceDir_ == "z") {
+        forceAxis_ = 2;
+    }
+    else {
+        throw std::invalid_argument("relperm needs a force direction x, y or z");
+    }
+    if (!latticeFluidOne_.periodicity().get(forceAxis_)) {
+        throw std::invalid_argument("relperm needs a periodic domain in the force direction");
+    }
+    if (rhoF1_ <= rhoNoFluid_ || rhoF2_ <= rhoNoFluid_) {
+        throw std::invalid_argument("relperm needs fluid densities above the dissolved density");
+    }
+    plint length = forceAxis_ == 0 ? nx_ : (forceAxis_ == 1 ? ny_ : nz_);
+    // default: one section in the middle of the domain
+    if (relPerm_.sections.empty()) {
+        relPerm_.sections.push_back(length/2);
+    }
+    for (pluint iS = 0; iS < relPerm_.sections.size(); ++iS) {
+        if (relPerm_.sections[iS] < 0 || relPerm_.sections[iS] >= length) {
+            throw std::invalid_argument("flux sections must lie inside the domain");
+        }
+    }
+    MultiPhaseBase::setUp();
+}
+
+plint RelativePermeability::runSaturationState(T saturation, plint checkFreq, plint maxIter, T convCr) {
+    mpfunctionals::iniRandomSaturation(latticeFluidOne_, latticeFluidTwo_, geometry_, saturation,
+        rhoF1_, rhoF2_, rhoNoFluid_);
+    initializeLattices();
+
+    std::vector<MultiBlock3D *> blocks;
+    blocks.push_back(& latticeFluidOne_);
+    blocks.push_back(& latticeFluidTwo_);
+    blocks.push_back(& geometry_);
+    T oldQ1{0}, oldQ2{0}, newQ1{0}, newQ2{0}, newS{0};
+    plint iT{0};
+    for (iT = 0; iT < maxIter; ++iT) {
+        collideAndStream();
+        sampleProbes();
+
+        if (iT % checkFreq == 0) {
+            // saturation and the fluxes of both fluids in one reduction
+            mpfunctionals::PhaseFluxes3D<T, MPDESCRIPTOR> fluxes(forceAxis_, relPerm_.sections, rhoF1_, rhoF2_, rhoNoFluid_);
+            applyProcessingFunctional(fluxes, latticeFluidOne_.getBoundingBox(), blocks);
+            newS = fluxes.getSaturation();
+            newQ1 = fluxes.getFlux(0);
+            newQ2 = fluxes.getFlux(1);
+            pcout <<"S: "<<newS<<" q1: "<<newQ1<<" q2: "<<newQ2<<" at "<<iT<<std::endl;
+            if (iT > 0 && simutils::hasFluxConverged(oldQ1, oldQ2, newQ1, newQ2, (T) checkFreq, convCr)) {
+                pcout <<"fluxes converged at iteration "<<iT<<std::endl;
+                break;
+            }
+            oldQ1 = newQ1;
+            oldQ2 = newQ2;
+        }
+    }
+    saturations_.push_back(newS);
+    fluxesF1_.push_back(newQ1);
+    fluxesF2_.push_back(newQ2);
+    return iT;
+}
+
+void RelativePermeability::writeRelPermTable() const {
+    // end points: fluid one alone (first state) and fluid two alone (last state)
+    T refQ1 = fluxesF1_.front();
+    T refQ2 = fluxesF2_.back();
+    std::string tableFile = outputDir_ + "relperm.dat";
+    plb_ofstream table(tableFile.c_str());
+    table << "# target_saturation saturation q1 q2 kr1 kr2 iterations" << std::endl;
+    for (pluint iS = 0; iS < saturations_.size(); ++iS) {
+        T kr1 = refQ1 != (T) 0. ? fluxesF1_[iS]/refQ1 : (T) 0.;
+        T kr2 = refQ2 != (T) 0. ? fluxesF2_[iS]/refQ2 : (T) 0.;
+        table << targetSaturations_[iS] << " " << saturations_[iS] << " " << fluxesF1_[iS] << " "
+              << fluxesF2_[iS] << " " << kr1 << " " << kr2 << " " << iterations_[iS] << std::endl;
+    }
+}
+
+void RelativePermeability::writeSimulationDatFile() {
+    std::string simFile = outputDir_ + "simulation.dat";
+    plb_ofstream simInfo(simFile.c_str());
+    addSimulationGeneralInfo(simInfo);
+    simInfo<<"force_f1: "<<forceF1_<<std::endl;
+    simInfo<<"force_f2: "<<forceF2_<<std::endl;
+    simInfo<<"force_direction: "<<forceDir_<<std::endl;
+}
+
+// saturation sweep from fluid one only down to fluid two only
+void RelativePermeability::operator()(plint checkFreq, plint maxIter, T convCr) {
+    setUp();
+    for (plint step = relPerm_.numSaturations; step >= 0; --step) {
+        T saturation = (T) step/(T) relPerm_.numSaturations;
+        pcout <<"relative permeability at saturation "<<saturation<<" >>> "<<std::endl;
+        targetSaturations_.push_back(saturation);
+        iterations_.push_back(runSaturationState(saturation, checkFreq, maxIter, convCr));
+    }
+    writeRelPermTable();
+    writeSimulationDatFile();
+}
@@ -97,14 +97,17 @@ void SingleComponent::setExternalForce(const T & forceF) {
 
 void SingleComponent::setUpShanChen() {
     plint processorLevel = 0;
-    integrateProcessingFunctional(new ShanChenSingleComponentProcessor3D <T, MPDESCRIPTOR> (gc_, new interparticlePotential::PsiShanChen93<T>(rho_0_)), 
+    // psi is tabulated up to 20 rho_0, where it has saturated; larger densities use the exponential
+    T rhoTableMax = 20 * rho_0_;
+    integrateProcessingFunctional(new ShanChenSingleComponentProcessor3D <T, MPDESCRIPTOR> (gc_,
+                new interparticlePotential::TabulatedPsi<T>(interparticlePotential::PsiShanChen93<T>(rho_0_), rhoTableMax)),
                 lattice_.getBoundingBox(), lattice_, processorLevel);
 
 }
 
 void SingleComponent::defineLatticeDynamics() {
-    defineDynamics(lattice_, geometry_, new NoDynamics<T, MPDESCRIPTOR>(), 2);
-    defineDynamics(lattice_, geometry_, new BounceBack<T, MPDESCRIPTOR>(gfs_), 1);
+    defineSharedDynamics(lattice_, geometry_, new NoDynamics<T, MPDESCRIPTOR>(), 2);
+    defineSharedDynamics(lattice_, geometry_, new BounceBack<T, MPDESCRIPTOR>(gfs_), 1);
 }
 
 void SingleComponent::initializeLatticeDensities() {
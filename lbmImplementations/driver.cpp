@@ -27,7 +27,7 @@ int main(int argc, char ** argv) {
 
     plint success{0};
     std::string modelName = argv[1];
-    std::string xmlFileName = argv[2];
+    std::string xmlFileName = argc > 2 ? argv[2] : "";
 
     global::timer("toma").restart();
 
@@ -39,6 +39,19 @@ int main(int argc, char ** argv) {
         success = runMultiPhaseSingleComponent(xmlFileName);
     }
 
+    // mpflow reconstruct output_directory step
+    else if (modelName == "reconstruct" && argc > 3) {
+        success = reconstructDeltaOutput(xmlFileName, (plint) std::stol(argv[3]));
+    }
+
+    // mpflow simdcheck: compares the vectorized with the cell-by-cell collision, exits with 1 if they differ
+    else if (modelName == "simdcheck") {
+        success = checkVectorizedCollision();
+        if (success != 1) {
+            return 1;
+        }
+    }
+
     if (success == 1) {
         T timeDuration = T();
         timeDuration = global::timer("toma").stop();
@@ -0,0 +1,49 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */  
+/*                                                                                  */                                                                                      
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */ 
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// rebuilds one output step of the delta format (output format delta) and writes the
+// densities as f1_rho_step_NNNNNN.vti and f2_rho_step_NNNNNN.vti, as the vtk format does
+# include "../helpers/header.h"
+# include "../helpers/deltaOutput.h"
+
+
+int reconstructDeltaOutput(const std::string & directory, plint step) {
+
+    std::string outputDir = directory;
+    if (!outputDir.empty() && outputDir[outputDir.size() - 1] != '/') {
+        outputDir += "/";
+    }
+    deltaoutput::StepIndex stepIndex;
+    if (!deltaoutput::readStepIndex(outputDir + "delta_index.dat", step, stepIndex)) {
+        pcout << "Error: step " << step << " is not in " << outputDir << "delta_index.dat" << std::endl;
+        return -1;
+    }
+
+    MultiScalarField3D<T> rhoF1(stepIndex.nx, stepIndex.ny, stepIndex.nz, (T) 0);
+    MultiScalarField3D<T> rhoF2(rhoF1);
+    applyProcessingFunctional(new deltaoutput::ReadDeltaStep3D<T>(outputDir + "delta_fields.bin", stepIndex),
+                              rhoF1.getBoundingBox(), rhoF1, rhoF2);
+
+    VtkImageOutput3D<T> vtkOutF1(createFileName(outputDir + "f1_rho_step_", step, 6), 1.0);
+    vtkOutF1.writeData<double> (rhoF1, "density", 1.);
+    VtkImageOutput3D<T> vtkOutF2(createFileName(outputDir + "f2_rho_step_", step, 6), 1.0);
+    vtkOutF2.writeData<double> (rhoF2, "density", 1.);
+
+    pcout << "step " << step << " reconstructed in " << outputDir << std::endl;
+    return 1;
+}
@@ -22,7 +22,11 @@
 # include "../lbmDeclarations/MultiPhaseRunOut.h"
 # include "../lbmDeclarations/DryingFinitePeclet.h"
 # include "../lbmDeclarations/DryingRateChange.h"
+# include "../lbmDeclarations/RelativePermeability.h"
+# include "../lbmDeclarations/MultiPhaseOctree.h"
+# include "../lbmDeclarations/FreeSurfaceDisplacement.h"
 # include "../helpers/mpParameterPacks.h"
+# include "../helpers/decompositionTuner.h"
 
 int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
 
@@ -35,6 +39,31 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
     plint totalNumRuns{0}, minRadius{0};
     plint convCheckFreq{0};
     plint gsteps{0}, changeStep{0};
+    plint warmStartLevels{0}, warmStartMaxIter{0};
+    plint quiescentInterval{0};
+    std::string equilibriumCache{};
+    std::string convergenceMeasure{"energy"};
+    T fluidCellFraction{0};
+    T quiescentTolerance{1e-6};
+    plint octreeLevels{0}, octreeBlockSize{12}, octreeMinRadius{3};
+    std::string engine{"shan-chen"};
+    T surfaceTension{0}, contactAngle{0};
+    std::string vaporSolver{"none"};
+    plint vaporSolveFreq{0}, vaporMaxSweeps{0};
+    T vaporTolerance{0}, vaporSweepTolerance{-1};
+    bool clusterAnalysis{false};
+    bool memoryArena{false}, hugePages{true};
+    bool persistentComm{false};
+    std::string decompositionMode{"default"}, decompositionCache{};
+    plint decompositionSteps{5};
+    std::string outputFormat{"vtk"};
+    T deltaTolerance{1e-6};
+    std::vector<ProbeParams> probeParams;
+    T stlVoxelSize{1.};
+    std::vector<T> stlOrigin;
+    plint stlInletLayers{0};
+    plint numSaturations{10};
+    std::vector<plint> fluxSections;
     bool xPeriod{true}, yPeriod{false}, zPeriod{false}, omegaChange{false};
     T omegaF1{}, omegaF2{}, gc{0.0}, gF1S{}, g00{0}, g01{0}, g11{0}, omegaMinF1{0.}, omegaMaxF1{0.}, omegaMinF2{0}, omegaMaxF2{0.};
     T gmin{0}, gmax{0};
@@ -104,6 +133,202 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
         return -1;
     }
 
+    // optional: coarse-to-fine warm start (imbibition and drainage)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["warm_start_levels"].read(warmStartLevels);
+        warmStartMaxIter = maxIter;
+        document["simulations"]["warm_start_max_iterations"].read(warmStartMaxIter);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: placement of an stl microstructure (filenames/microstructure ending with .stl)
+    try {
+        XMLreader document(xmlFileName);
+        document["stl"]["voxel_size"].read(stlVoxelSize);
+        document["stl"]["origin"].read(stlOrigin);
+        document["stl"]["inlet_fluid_layers"].read(stlInletLayers);
+    } catch (PlbIOException &) {
+    }
+    if (stlOrigin.empty()) {
+        stlOrigin = {0., 0., 0.};
+    }
+
+    // optional: octree multi-level lattices refined by the local pore radius (imbibition)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["octree_levels"].read(octreeLevels);
+        document["simulations"]["octree_block_size"].read(octreeBlockSize);
+        document["simulations"]["octree_min_radius"].read(octreeMinRadius);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: single-lattice free-surface engine (drainage and drying)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["engine"].read(engine);
+    } catch (PlbIOException &) {
+    }
+    if (engine != "shan-chen" && engine != "free-surface") {
+        pcout << "engine must be shan-chen or free-surface" << std::endl;
+        return -1;
+    }
+    bool freeSurface = engine == "free-surface";
+    if (freeSurface && simType != "drainage" && simType != "drying") {
+        pcout << "the free-surface engine runs drainage and drying only" << std::endl;
+        return -1;
+    }
+    if (freeSurface) {
+        try {
+            XMLreader document(xmlFileName);
+            document["free_surface"]["surface_tension"].read(surfaceTension);
+            document["free_surface"]["contact_angle"].read(contactAngle);
+        } catch (PlbIOException & exception) {
+            pcout << exception.what() << std::endl;
+            return -1;
+        }
+    }
+
+    // optional: quiescent-block skipping (shan-chen engine without octree)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["quiescent_interval"].read(quiescentInterval);
+        document["simulations"]["quiescent_tolerance"].read(quiescentTolerance);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: fluid-cell lists in porous blocks (shan-chen engine without octree)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["fluid_cell_fraction"].read(fluidCellFraction);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: directory of the stored equilibrium stages (runout, drying and drying-rate)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["equilibrium_cache"].read(equilibriumCache);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: convergence measure (energy, l2, linf or saturation)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["converge_measure"].read(convergenceMeasure);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: trapped-cluster analysis (imbibition and drainage)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["cluster_analysis"].read(clusterAnalysis);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: quasi-steady vapor solve (drying and drying-rate)
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["vapor_solver"].read(vaporSolver);
+        document["simulations"]["vapor_solve_frequency"].read(vaporSolveFreq);
+        document["simulations"]["vapor_max_sweeps"].read(vaporMaxSweeps);
+        document["simulations"]["vapor_tolerance"].read(vaporTolerance);
+    } catch (PlbIOException &) {
+    }
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["vapor_sweep_tolerance"].read(vaporSweepTolerance);
+    } catch (PlbIOException &) {
+    }
+    // without its own key the sweeps stop at the solver tolerance, as before
+    if (vaporSweepTolerance < 0) {
+        vaporSweepTolerance = vaporTolerance;
+    }
+
+    // optional: arena allocation of the lattice and field storage
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["memory_arena"].read(memoryArena);
+        document["simulations"]["huge_pages"].read(hugePages);
+    } catch (PlbIOException &) {
+    }
+    if (memoryArena) {
+        global::setBlockAllocator(new ArenaBlockAllocator(hugePages));
+    }
+
+    // optional: persistent mpi requests for the halo exchanges
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["persistent_communication"].read(persistentComm);
+    } catch (PlbIOException &) {
+    }
+    global::mpi().setPersistentCommunication(persistentComm);
+
+    // optional: startup tuning of the block decomposition
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["decomposition"].read(decompositionMode);
+    } catch (PlbIOException &) {
+    }
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["decomposition_steps"].read(decompositionSteps);
+    } catch (PlbIOException &) {
+    }
+    try {
+        XMLreader document(xmlFileName);
+        document["simulations"]["decomposition_cache"].read(decompositionCache);
+    } catch (PlbIOException &) {
+    }
+    if (decompositionMode != "default" && decompositionMode != "auto") {
+        pcout << "decomposition must be default or auto" << std::endl;
+        return -1;
+    }
+    if (decompositionSteps <= 0) {
+        pcout << "decomposition_steps must be positive" << std::endl;
+        return -1;
+    }
+
+    // optional: saturation sweep and flux sections (relperm)
+    try {
+        XMLreader document(xmlFileName);
+        document["flow"]["number_of_saturation_steps"].read(numSaturations);
+    } catch (PlbIOException &) {
+    }
+    try {
+        XMLreader document(xmlFileName);
+        document["flow"]["flux_sections"].read(fluxSections);
+    } catch (PlbIOException &) {
+    }
+
+    // optional: field output format
+    try {
+        XMLreader document(xmlFileName);
+        document["output"]["format"].read(outputFormat);
+    } catch (PlbIOException &) {
+    }
+    try {
+        XMLreader document(xmlFileName);
+        document["output"]["delta_tolerance"].read(deltaTolerance);
+    } catch (PlbIOException &) {
+    }
+    // optional: slice, box and point probes (a probe that is present must be complete)
+    {
+        XMLreader document(xmlFileName);
+        XMLreaderProxy probe(0);
+        try {
+            probe = document["output"]["probes"]["probe"];
+        } catch (PlbIOException &) {
+        }
+        try {
+            for (; probe.isValid(); probe = probe.iterId()) {
+                probeParams.push_back(probes::readProbeParams(probe, nx, ny, nz));
+            }
+        } catch (PlbIOException & exception) {
+            pcout << exception.what() << std::endl;
+            return -1;
+        }
+    }
+
     // set global variables
     // compute relaxation times 
    // nuF1 = ((T)1/omegaF1 - (T)0.5)/MPDESCRIPTOR<T>::invCs2;
@@ -128,6 +353,9 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
     FluidsParams<T> fluidsParams(omegaF1, omegaF2, gc, gF1S);
     CohesionParams<T> cohesionParams(g00, g01, g11);
     ExternalForceParams<T> externalForceParams(forceF1, forceF2, forceDir);
+    VaporSolverParams<T> vaporSolverParams(vaporSolver, vaporSolveFreq, vaporMaxSweeps, vaporTolerance,
+                                                vaporSweepTolerance);
+    MeshParams<T> meshParams(stlVoxelSize, stlOrigin, stlInletLayers);
     CohesionRangeParams<T> cohesionRangeParams;
     FluidsParamsChangingOmega<T> fluidsRangeParams; 
 
@@ -143,16 +371,57 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
         fluidsRangeParams = FluidsParamsChangingOmega<T>(omegaMinF1, omegaMaxF1, omegaMinF2, omegaMaxF2);
     }
 
+    // block decomposition shared by both lattices and the geometry: palabos default
+    // (one block per rank) or the fastest of the candidates timed at startup
+    MultiBlockManagement3D management = defaultMultiBlockPolicy3D().getMultiBlockManagement(nx, ny, nz,
+                                            MPDESCRIPTOR<T>::vicinity);
+    // the tuner times the shan-chen step, so the free-surface engine keeps the default
+    if (decompositionMode == "auto" && !freeSurface) {
+        if (decompositionCache.empty()) {
+            decompositionCache = outputDir + "decomposition.cache";
+        }
+        decomposition::DecompositionTuner tuner(nx, ny, nz, tomaFileName);
+        decomposition::Layout layout = tuner.tune<T, MPDESCRIPTOR>(gc, std::vector<T>{omegaF1, omegaF2},
+                                            decompositionSteps, decompositionCache);
+        management = tuner.createManagement(layout, MPDESCRIPTOR<T>::vicinity);
+    }
+
     // define MultiBlock lattices and pass them to the class 
-    MultiBlockLattice3D < T, MPDESCRIPTOR > latticeFluidOne(nx, ny, nz,
+    // octree imbibition builds its level lattices from the octree and the free-surface engine
+    // its single lattice: the lattices passed in are single node placeholders and only the
+    // geometry spans the voxel domain
+    bool octree = simType == "imbibition" && octreeLevels > 0;
+    MultiBlockManagement3D latticeManagement = octree || freeSurface ?
+        defaultMultiBlockPolicy3D().getMultiBlockManagement(1, 1, 1, MPDESCRIPTOR<T>::vicinity) : management;
+    MultiBlockLattice3D < T, MPDESCRIPTOR > latticeFluidOne(latticeManagement,
+        defaultMultiBlockPolicy3D().getBlockCommunicator(), defaultMultiBlockPolicy3D().getCombinedStatistics(),
+        defaultMultiBlockPolicy3D().getMultiCellAccess<T, MPDESCRIPTOR>(),
         new ExternalMomentRegularizedBGKdynamics < T, MPDESCRIPTOR > (omegaF1));
 
-    MultiBlockLattice3D < T, MPDESCRIPTOR > latticeFluidTwo(nx, ny, nz, 
+    MultiBlockLattice3D < T, MPDESCRIPTOR > latticeFluidTwo(latticeManagement,
+        defaultMultiBlockPolicy3D().getBlockCommunicator(), defaultMultiBlockPolicy3D().getCombinedStatistics(),
+        defaultMultiBlockPolicy3D().getMultiCellAccess<T, MPDESCRIPTOR>(),
         new ExternalMomentRegularizedBGKdynamics < T, MPDESCRIPTOR > (omegaF2));
     
-    MultiScalarField3D<int> geometry(nx, ny, nz);
+    MultiScalarField3D<int> geometry(management,
+        defaultMultiBlockPolicy3D().getBlockCommunicator(), defaultMultiBlockPolicy3D().getCombinedStatistics(),
+        defaultMultiBlockPolicy3D().getMultiScalarAccess<int>());
     
-    if (simType == "drainage") {
+    if (freeSurface) {
+        FreeSurfaceDisplacement displacement(std::move(latticeFluidOne), std::move(latticeFluidTwo),
+                    std::move(geometry), totalNumRuns, minRadius, simType);
+        displacement.setDomainSize(nx, ny, nz);
+        displacement.setFileNames(fileParams);
+        displacement.setDensities(densityParams);
+        displacement.setPeriodicBCFlags(periodicParams);
+        displacement.setFluidsProperties(fluidsParams);
+        displacement.setExternalForce(externalForceParams);
+        displacement.setMicrostructureMesh(meshParams);
+        displacement.setFreeSurface(FreeSurfaceParams<T>(surfaceTension, contactAngle));
+        displacement(maxIter, convCheckFreq, outputFreq, convCr);
+    }
+
+    else if (simType == "drainage") {
         MultiPhasePressure multiPressure(std::move(latticeFluidOne),
                     std::move(latticeFluidTwo), std::move(geometry), totalNumRuns, minRadius);       
         multiPressure.setDomainSize(nx, ny, nz);
@@ -161,6 +430,15 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
         multiPressure.setPeriodicBCFlags(periodicParams);
         multiPressure.setFluidsProperties(fluidsParams);
         multiPressure.setExternalForce(externalForceParams);
+        multiPressure.setOutputFormat(outputFormat);
+        multiPressure.setDeltaOutputTolerance(deltaTolerance);
+        multiPressure.setProbes(probeParams);
+        multiPressure.setQuiescentBlocks(quiescentInterval, quiescentTolerance);
+        multiPressure.setFluidCellLists(fluidCellFraction);
+        multiPressure.setConvergenceMeasure(convergenceMeasure);
+        multiPressure.setMicrostructureMesh(meshParams);
+        multiPressure.setWarmStart(warmStartLevels, warmStartMaxIter);
+        multiPressure.setClusterAnalysis(clusterAnalysis);
         multiPressure(maxIter, convCheckFreq, outputFreq, convCr);
     }
 
@@ -173,10 +451,30 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
         multiRunOut.setPeriodicBCFlags(periodicParams);
         multiRunOut.setFluidsProperties(fluidsParams);
         multiRunOut.setExternalForce(externalForceParams);
+        multiRunOut.setOutputFormat(outputFormat);
+        multiRunOut.setDeltaOutputTolerance(deltaTolerance);
+        multiRunOut.setProbes(probeParams);
+        multiRunOut.setQuiescentBlocks(quiescentInterval, quiescentTolerance);
+        multiRunOut.setFluidCellLists(fluidCellFraction);
+        multiRunOut.setConvergenceMeasure(convergenceMeasure);
+        multiRunOut.setMicrostructureMesh(meshParams);
+        multiRunOut.setEquilibriumCache(equilibriumCache);
         multiRunOut(maxIter, maxRampIter, outputFreq, convCheckFreq, convCr);
 
     }
 
+    else if (octree) {
+        MultiPhaseOctree multiPhase(std::move(latticeFluidOne), std::move(latticeFluidTwo), std::move(geometry));
+        multiPhase.setDomainSize(nx, ny, nz);
+        multiPhase.setFileNames(fileParams);
+        multiPhase.setDensities(densityParams);
+        multiPhase.setFluidsProperties(fluidsParams);
+        multiPhase.setExternalForce(externalForceParams);
+        multiPhase.setMicrostructureMesh(meshParams);
+        multiPhase.setOctree(OctreeParams(octreeLevels, octreeBlockSize, octreeMinRadius));
+        multiPhase(convCheckFreq, outputFreq, maxIter, convCr);
+    }
+
     else if (simType == "imbibition") {
         MultiPhaseBase multiPhase(std::move(latticeFluidOne), std::move(latticeFluidTwo), std::move(geometry));
         multiPhase.setDomainSize(nx, ny, nz);
@@ -185,6 +483,15 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
         multiPhase.setPeriodicBCFlags(periodicParams);
         multiPhase.setFluidsProperties(fluidsParams);
         multiPhase.setExternalForce(externalForceParams);
+        multiPhase.setOutputFormat(outputFormat);
+        multiPhase.setDeltaOutputTolerance(deltaTolerance);
+        multiPhase.setProbes(probeParams);
+        multiPhase.setQuiescentBlocks(quiescentInterval, quiescentTolerance);
+        multiPhase.setFluidCellLists(fluidCellFraction);
+        multiPhase.setConvergenceMeasure(convergenceMeasure);
+        multiPhase.setMicrostructureMesh(meshParams);
+        multiPhase.setWarmStart(warmStartLevels, warmStartMaxIter);
+        multiPhase.setClusterAnalysis(clusterAnalysis);
         multiPhase(convCheckFreq, outputFreq, maxIter, convCr);
     }
 
@@ -197,6 +504,15 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
         drying.setPeriodicBCFlags(periodicParams);
         drying.setFluidsProperties(cohesionParams, fluidsParams);
         drying.setExternalForce(externalForceParams);
+        drying.setOutputFormat(outputFormat);
+        drying.setDeltaOutputTolerance(deltaTolerance);
+        drying.setProbes(probeParams);
+        drying.setQuiescentBlocks(quiescentInterval, quiescentTolerance);
+        drying.setFluidCellLists(fluidCellFraction);
+        drying.setConvergenceMeasure(convergenceMeasure);
+        drying.setMicrostructureMesh(meshParams);
+        drying.setEquilibriumCache(equilibriumCache);
+        drying.setVaporSolver(vaporSolverParams);
         drying(maxIter, maxRampIter, outputFreq, convCheckFreq, convCr);
     }
 
@@ -217,9 +533,38 @@ int runMultiPhaseMultiComponent(const std::string & xmlFileName) {
         }
 
         dryRate.setExternalForce(externalForceParams);
+        dryRate.setOutputFormat(outputFormat);
+        dryRate.setDeltaOutputTolerance(deltaTolerance);
+        dryRate.setProbes(probeParams);
+        dryRate.setQuiescentBlocks(quiescentInterval, quiescentTolerance);
+        dryRate.setFluidCellLists(fluidCellFraction);
+        dryRate.setConvergenceMeasure(convergenceMeasure);
+        dryRate.setMicrostructureMesh(meshParams);
+        dryRate.setEquilibriumCache(equilibriumCache);
+        dryRate.setVaporSolver(vaporSolverParams);
         dryRate(maxIter, maxRampIter, outputFreq, convCheckFreq, convCr);
     }
 
+    else if (simType == "relperm") {
+        RelativePermeability relPerm(std::move(latticeFluidOne), std::move(latticeFluidTwo), std::move(geometry));
+        relPerm.setDomainSize(nx, ny, nz);
+        relPerm.setFileNames(fileParams);
+        relPerm.setDensities(densityParams);
+        relPerm.setPeriodicBCFlags(periodicParams);
+        relPerm.setFluidsProperties(fluidsParams);
+        relPerm.setExternalForce(externalForceParams);
+        relPerm.setOutputFormat(outputFormat);
+        relPerm.setDeltaOutputTolerance(deltaTolerance);
+        relPerm.setProbes(probeParams);
+        relPerm.setQuiescentBlocks(quiescentInterval, quiescentTolerance);
+        relPerm.setFluidCellLists(fluidCellFraction);
+        relPerm.setMicrostructureMesh(meshParams);
+        relPerm.setRelPerm(RelPermParams(numSaturations, fluxSections));
+        relPerm(convCheckFreq, maxIter, convCr);
+    }
+
+    pcout << global::blockAllocationReport();
+
     return 1;
 
 }
\ No newline at end of file
@@ -62,6 +62,8 @@ public:
     virtual void setConstBlock(AtomicBlock3D const& block);
     virtual BlockLatticeDataTransfer3D<T,Descriptor>* clone() const;
     virtual plint staticCellSize() const;
+    /// Size in bytes of a part of the static cell content (populations or externals).
+    static plint staticPartSize(modif::ModifT kind);
     /// Send data from the lattice into a byte-stream.
     virtual void send(Box3D domain, std::vector<char>& buffer, modif::ModifT kind) const;
     /// Receive data from a byte-stream into the lattice.
@@ -84,12 +86,14 @@ private:
     void send_static(Box3D domain, std::vector<char>& buffer) const;
     void send_dynamic(Box3D domain, std::vector<char>& buffer) const;
     void send_all(Box3D domain, std::vector<char>& buffer) const;
+    void send_part(Box3D domain, std::vector<char>& buffer, modif::ModifT kind) const;
 
     void receive_static(Box3D domain, std::vector<char> const& buffer);
     void receive_dynamic(Box3D domain, std::vector<char> const& buffer);
     void receive_all(Box3D domain, std::vector<char> const& buffer);
     void receive_regenerate( Box3D domain, std::vector<char> const& buffer,
                              std::map<int,int> const& idIndirect = (std::map<int,int>()) );
+    void receive_part(Box3D domain, std::vector<char> const& buffer, modif::ModifT kind);
 
     void attribute_static (
         Box3D toDomain, plint deltaX, plint deltaY, plint deltaZ,
@@ -103,6 +107,9 @@ private:
     void attribute_regenerate (
         Box3D toDomain, plint deltaX, plint deltaY, plint deltaZ,
         BlockLattice3D<T,Descriptor> const& from );
+    void attribute_part (
+        Box3D toDomain, plint deltaX, plint deltaY, plint deltaZ,
+        BlockLattice3D<T,Descriptor> const& from, modif::ModifT kind );
 private:
     BlockLattice3D<T,Descriptor>* lattice;
     BlockLattice3D<T,Descriptor> const* constLattice;
@@ -179,6 +186,34 @@ public:
     Dynamics<T,Descriptor> const& getBackgroundDynamics() const;
     /// Assign an individual clone of the new dynamics to every cell.
     void resetDynamics(Dynamics<T,Descriptor> const& dynamics);
+    /// Get a shared (flyweight) instance of the dynamics, which any number of cells can point to.
+    /** The lattice keeps a small table of shared dynamics objects, compared through their
+     *  serialized content (class and parameters). If an equal object is already in the
+     *  table it is returned, otherwise a clone of the prototype is added. The returned object
+     *  is owned by the lattice and is passed to attributeDynamics() without being cloned.
+     *  Only dynamics without per-cell state may be shared.
+     */
+    Dynamics<T,Descriptor>* getSharedDynamics(Dynamics<T,Descriptor> const& prototype);
+    /// Number of entries in the table of shared dynamics.
+    plint getNumSharedDynamics() const;
+    /// Replace a newly generated dynamics object by an equal shared instance, if there
+    ///   is one in the table (the argument is then deleted).
+    Dynamics<T,Descriptor>* replaceBySharedDynamics(Dynamics<T,Descriptor>* dynamics);
+    /// Restrict collide(), stream() and collideAndStream() to a list of active cells.
+    /** The cells are given in local coordinates, sorted by x, then y, then z, which is
+     *  the order required by the swap-based streaming. The neighbors of each cell in the
+     *  list are looked up once here. Links to cells which are not in the list are not
+     *  streamed, which amounts to a bounce-back on these links: the list may therefore
+     *  only omit cells whose populations never reach an active cell, such as solid
+     *  cells surrounded by solid and bounce-back cells.
+     */
+    void setActiveCells(std::vector<Dot3D> const& cells);
+    /// Return to the loops over all cells of a domain.
+    void clearActiveCells();
+    /// True if the lattice is restricted to a list of active cells.
+    bool hasActiveCells() const;
+    /// The list of active cells (empty if the lattice is not restricted).
+    std::vector<Dot3D> const& getActiveCells() const;
     /// Apply streaming step to bulk (non-boundary) cells
     void bulkStream(Box3D domain);
     /// Apply streaming step to boundary cells
@@ -191,6 +226,11 @@ private:
     /// Cache-efficient implementation of bulkCollideAndStream(domain)for
     ///   nearest-neighbor lattices.
     void blockwiseBulkCollideAndStream(Box3D domain);
+    /// Versions of collide(domain), stream(domain) and collideAndStream(domain)
+    ///   which only visit the active cells.
+    void activeCollide(Box3D domain);
+    void activeStream(Box3D domain);
+    void activeCollideAndStream(Box3D domain);
 private:
     /// Helper method for memory allocation
     void allocateAndInitialize();
@@ -198,10 +238,22 @@ private:
     void releaseMemory();
     void implementPeriodicity();
     plint allocatedMemory() const;
+    /// Index of the dynamics in the table of shared dynamics, or -1.
+    plint findSharedDynamics(Dynamics<T,Descriptor> const* dynamics) const;
+    /// A dynamics object which is neither the background nor a shared one belongs
+    ///   to a single cell, and is deleted together with it.
+    bool isIndividualDynamics(Dynamics<T,Descriptor> const* dynamics) const;
 private:
     void periodicDomain(Box3D domain);
 private:
     Dynamics<T,Descriptor>* backgroundDynamics;
+    std::vector<Dynamics<T,Descriptor>*> sharedDynamics;
+    std::vector<std::vector<char> > sharedSignatures;
+    /// Active cells, and for each of them the position in the list of the neighbor
+    ///   in the directions 1 to q/2 (-1 if the neighbor is not active).
+    bool activeCellsOnly;
+    std::vector<Dot3D> activeCells;
+    std::vector<plint> activeNeighbors;
     Cell<T,Descriptor>     *rawData;
     Cell<T,Descriptor>   ***grid;
 public:
@@ -41,6 +41,7 @@
 #include "core/dynamics.h"
 #include "core/cell.h"
 #include "core/plbTimer.h"
+#include "core/blockAllocator.h"
 #include "latticeBoltzmann/latticeTemplates.h"
 #include "latticeBoltzmann/indexTemplates.h"
 #include "core/util.h"
@@ -64,7 +65,8 @@ BlockLattice3D<T,Descriptor>::BlockLattice3D (
         plint nx_, plint ny_, plint nz_,
         Dynamics<T,Descriptor>* backgroundDynamics_ )
    :  AtomicBlock3D(nx_, ny_, nz_, new BlockLatticeDataTransfer3D<T,Descriptor>()),
-      backgroundDynamics(backgroundDynamics_)
+      backgroundDynamics(backgroundDynamics_),
+      activeCellsOnly(false)
 {
     plint nx = this->getNx();
     plint ny = this->getNy();
@@ -113,11 +115,18 @@ template<typename T, template<typename U> class Descriptor>
 BlockLattice3D<T,Descriptor>::BlockLattice3D(BlockLattice3D<T,Descriptor> const& rhs)
     : BlockLatticeBase3D<T,Descriptor>(rhs),
       AtomicBlock3D(rhs),
-      backgroundDynamics(rhs.backgroundDynamics->clone())
+      backgroundDynamics(rhs.backgroundDynamics->clone()),
+      sharedSignatures(rhs.sharedSignatures),
+      activeCellsOnly(rhs.activeCellsOnly),
+      activeCells(rhs.activeCells),
+      activeNeighbors(rhs.activeNeighbors)
 {
     plint nx = this->getNx();
     plint ny = this->getNy();
     plint nz = this->getNz();
+    for (pluint iShared=0; iShared<rhs.sharedDynamics.size(); ++iShared) {
+        sharedDynamics.push_back(rhs.sharedDynamics[iShared]->clone());
+    }
     allocateAndInitialize();
     for (plint iX=0; iX<nx; ++iX) {
         for (plint iY=0; iY<ny; ++iY) {
@@ -126,10 +135,14 @@ BlockLattice3D<T,Descriptor>::BlockLattice3D(BlockLattice3D<T,Descriptor> const&
                 // Assign cell from rhs
                 cell = rhs.grid[iX][iY][iZ];
                 // Get an independent clone of the dynamics,
-                //   or assign backgroundDynamics
+                //   or assign backgroundDynamics or the shared dynamics
+                plint iShared = rhs.findSharedDynamics(&cell.getDynamics());
                 if (&cell.getDynamics()==rhs.backgroundDynamics) {
                     cell.attributeDynamics(backgroundDynamics);
                 }
+                else if (iShared >= 0) {
+                    cell.attributeDynamics(sharedDynamics[iShared]);
+                }
                 else {
                     cell.attributeDynamics(cell.getDynamics().clone());
                 }
@@ -163,6 +176,11 @@ void BlockLattice3D<T,Descriptor>::swap(BlockLattice3D& rhs) {
     BlockLatticeBase3D<T,Descriptor>::swap(rhs);
     AtomicBlock3D::swap(rhs);
     std::swap(backgroundDynamics, rhs.backgroundDynamics);
+    sharedDynamics.swap(rhs.sharedDynamics);
+    sharedSignatures.swap(rhs.sharedSignatures);
+    std::swap(activeCellsOnly, rhs.activeCellsOnly);
+    activeCells.swap(rhs.activeCells);
+    activeNeighbors.swap(rhs.activeNeighbors);
     std::swap(rawData, rhs.rawData);
     std::swap(grid, rhs.grid);
     global::plbCounter("MEMORY_LATTICE").increment(allocatedMemory());
@@ -187,6 +205,10 @@ void BlockLattice3D<T,Descriptor>::collide(Box3D domain) {
     // Make sure domain is contained within current lattice
     PLB_PRECONDITION( contained(domain, this->getBoundingBox()) );
 
+    if (activeCellsOnly) {
+        activeCollide(domain);
+        return;
+    }
     for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
         for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
             for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
@@ -217,6 +239,10 @@ void BlockLattice3D<T,Descriptor>::stream(Box3D domain) {
     // Make sure domain is contained within current lattice
     PLB_PRECONDITION( contained(domain, this->getBoundingBox()) );
 
+    if (activeCellsOnly) {
+        activeStream(domain);
+        return;
+    }
     static const plint vicinity = Descriptor<T>::vicinity;
 
     bulkStream(Box3D(domain.x0+vicinity,domain.x1-vicinity,
@@ -268,6 +294,12 @@ void BlockLattice3D<T,Descriptor>::collideAndStream(Box3D domain) {
     PLB_PRECONDITION( contained(domain, this->getBoundingBox()) );
 
     global::profiler().start("collStream");
+    if (activeCellsOnly) {
+        global::profiler().increment("collStreamCells", (plint) activeCells.size());
+        activeCollideAndStream(domain);
+        global::profiler().stop("collStream");
+        return;
+    }
     global::profiler().increment("collStreamCells", domain.nCells());
 
     static const plint vicinity = Descriptor<T>::vicinity;
@@ -352,10 +384,12 @@ void BlockLattice3D<T,Descriptor>::allocateAndInitialize() {
     plint nx = this->getNx();
     plint ny = this->getNy();
     plint nz = this->getNz();
-    rawData = new Cell<T,Descriptor> [nx*ny*nz];
+    rawData = allocateBlockData<Cell<T,Descriptor> >(nx*ny*nz);
     grid    = new Cell<T,Descriptor>** [nx];
+    // The line pointers of all x-planes share one table.
+    Cell<T,Descriptor>** lines = nx>0 ? new Cell<T,Descriptor>* [nx*ny] : 0;
     for (plint iX=0; iX<nx; ++iX) {
-        grid[iX] = new Cell<T,Descriptor>* [ny];
+        grid[iX] = lines + ny*iX;
         for (plint iY=0; iY<ny; ++iY) {
             grid[iX][iY] = rawData + nz*(iY+ny*iX);
         }
@@ -371,16 +405,19 @@ void BlockLattice3D<T,Descriptor>::releaseMemory() {
         for (plint iY=0; iY<ny; ++iY) {
             for (plint iZ=0; iZ<nz; ++iZ) {
                 Dynamics<T,Descriptor>* dynamics = &grid[iX][iY][iZ].getDynamics();
-                if (dynamics != backgroundDynamics) {
+                if (isIndividualDynamics(dynamics)) {
                     delete dynamics;
                 }
             }
         }
     }
     delete backgroundDynamics;
-    delete [] rawData;
-    for (plint iX=0; iX<nx; ++iX) {
-        delete [] grid[iX];
+    for (pluint iShared=0; iShared<sharedDynamics.size(); ++iShared) {
+        delete sharedDynamics[iShared];
+    }
+    releaseBlockData(rawData, nx*ny*nz);
+    if (nx>0) {
+        delete [] grid[0];
     }
     delete [] grid;
 }
@@ -390,12 +427,71 @@ void BlockLattice3D<T,Descriptor>::attributeDynamics (
         plint iX, plint iY, plint iZ, Dynamics<T,Descriptor>* dynamics )
 {
     Dynamics<T,Descriptor>* previousDynamics = &grid[iX][iY][iZ].getDynamics();
-    if (previousDynamics != backgroundDynamics) {
+    if (previousDynamics != dynamics && isIndividualDynamics(previousDynamics)) {
         delete previousDynamics;
     }
     grid[iX][iY][iZ].attributeDynamics(dynamics);
 }
 
+template<typename T, template<typename U> class Descriptor>
+Dynamics<T,Descriptor>* BlockLattice3D<T,Descriptor>::getSharedDynamics (
+        Dynamics<T,Descriptor> const& prototype )
+{
+    std::vector<char> signature;
+    serialize(prototype, signature);
+    for (pluint iShared=0; iShared<sharedSignatures.size(); ++iShared) {
+        if (sharedSignatures[iShared] == signature) {
+            return sharedDynamics[iShared];
+        }
+    }
+    sharedDynamics.push_back(prototype.clone());
+    sharedSignatures.push_back(signature);
+    return sharedDynamics.back();
+}
+
+template<typename T, template<typename U> class Descriptor>
+plint BlockLattice3D<T,Descriptor>::getNumSharedDynamics() const {
+    return (plint)sharedDynamics.size();
+}
+
+template<typename T, template<typename U> class Descriptor>
+Dynamics<T,Descriptor>* BlockLattice3D<T,Descriptor>::replaceBySharedDynamics (
+        Dynamics<T,Descriptor>* dynamics )
+{
+    // Lattices without shared dynamics skip the serialization.
+    if (sharedDynamics.empty()) {
+        return dynamics;
+    }
+    std::vector<char> signature;
+    serialize(*dynamics, signature);
+    for (pluint iShared=0; iShared<sharedSignatures.size(); ++iShared) {
+        if (sharedSignatures[iShared] == signature) {
+            delete dynamics;
+            return sharedDynamics[iShared];
+        }
+    }
+    return dynamics;
+}
+
+template<typename T, template<typename U> class Descriptor>
+plint BlockLattice3D<T,Descriptor>::findSharedDynamics (
+        Dynamics<T,Descriptor> const* dynamics ) const
+{
+    for (pluint iShared=0; iShared<sharedDynamics.size(); ++iShared) {
+        if (sharedDynamics[iShared] == dynamics) {
+            return (plint)iShared;
+        }
+    }
+    return -1;
+}
+
+template<typename T, template<typename U> class Descriptor>
+bool BlockLattice3D<T,Descriptor>::isIndividualDynamics (
+        Dynamics<T,Descriptor> const* dynamics ) const
+{
+    return dynamics != backgroundDynamics && findSharedDynamics(dynamics) < 0;
+}
+
 template<typename T, template<typename U> class Descriptor>
 Dynamics<T,Descriptor>& BlockLattice3D<T,Descriptor>::getBackgroundDynamics() {
     return *backgroundDynamics;
@@ -559,17 +655,39 @@ void BlockLattice3D<T,Descriptor>::blockwiseBulkCollideAndStream(Box3D domain) {
                         //    the swap-operation of the streaming.
                         plint minZ = outerZ-dx-dy;
                         plint maxZ = minZ+blockSize-1;
-                        for (plint innerZ=std::max(minZ,domain.z0);
-                             innerZ <= std::min(maxZ, domain.z1);
-                             ++innerZ)
-                        {
-                            // Collide the cell.
-                            grid[innerX][innerY][innerZ].collide (
-                                    this->getInternalStatistics() );
-                            // Swap the populations on the cell, and then with post-collision
-                            //   neighboring cell, to perform the streaming step.
-                            latticeTemplates<T,Descriptor>::swapAndStream3D (
-                                    grid, innerX, innerY, innerZ );
+                        plint endZ = std::min(maxZ, domain.z1);
+                        Cell<T,Descriptor>* row = grid[innerX][innerY];
+                        plint innerZ=std::max(minZ,domain.z0);
+                        while (innerZ <= endZ) {
+                            // Consecutive cells which share the same dynamics object are
+                            //   handed over as a run, to let the dynamics use a vectorized
+                            //   collision. This is equivalent to the cell-by-cell order,
+                            //   because the swap on (x,y,z) never involves (x,y,z+1).
+                            Dynamics<T,Descriptor>* dynamics = &row[innerZ].getDynamics();
+                            plint endRun = innerZ+1;
+                            while (endRun <= endZ && &row[endRun].getDynamics() == dynamics) {
+                                ++endRun;
+                            }
+                            if ( endRun-innerZ > 1 &&
+                                 dynamics->collideRun(row+innerZ, endRun-innerZ,
+                                                      this->getInternalStatistics()) )
+                            {
+                                for (plint iZ=innerZ; iZ<endRun; ++iZ) {
+                                    latticeTemplates<T,Descriptor>::swapAndStream3D (
+                                            grid, innerX, innerY, iZ );
+                                }
+                            }
+                            else {
+                                for (plint iZ=innerZ; iZ<endRun; ++iZ) {
+                                    // Collide the cell.
+                                    row[iZ].collide(this->getInternalStatistics());
+                                    // Swap the populations on the cell, and then with post-collision
+                                    //   neighboring cell, to perform the streaming step.
+                                    latticeTemplates<T,Descriptor>::swapAndStream3D (
+                                            grid, innerX, innerY, iZ );
+                                }
+                            }
+                            innerZ = endRun;
                         }
                     }
                 }
@@ -578,6 +696,113 @@ void BlockLattice3D<T,Descriptor>::blockwiseBulkCollideAndStream(Box3D domain) {
     }
 }
 
+template<typename T, template<typename U> class Descriptor>
+void BlockLattice3D<T,Descriptor>::setActiveCells(std::vector<Dot3D> const& cells) {
+    static const plint half = Descriptor<T>::q/2;
+    Box3D bbox(this->getBoundingBox());
+    // Position of each cell in the list, -1 for inactive cells.
+    std::vector<plint> position(bbox.nCells(), -1);
+    for (pluint iCell=0; iCell<cells.size(); ++iCell) {
+        Dot3D const& pos = cells[iCell];
+        PLB_PRECONDITION( contained(pos.x,pos.y,pos.z, bbox) );
+        PLB_PRECONDITION( iCell==0 || cells[iCell-1] < pos );
+        position[(pos.x*this->getNy() + pos.y)*this->getNz() + pos.z] = (plint) iCell;
+    }
+    activeCells = cells;
+    activeNeighbors.assign(cells.size()*half, -1);
+    for (pluint iCell=0; iCell<cells.size(); ++iCell) {
+        for (plint iPop=1; iPop<=half; ++iPop) {
+            plint nextX = cells[iCell].x + Descriptor<T>::c[iPop][0];
+            plint nextY = cells[iCell].y + Descriptor<T>::c[iPop][1];
+            plint nextZ = cells[iCell].z + Descriptor<T>::c[iPop][2];
+            if (contained(nextX,nextY,nextZ, bbox)) {
+                activeNeighbors[iCell*half + iPop-1] =
+                    position[(nextX*this->getNy() + nextY)*this->getNz() + nextZ];
+            }
+        }
+    }
+    activeCellsOnly = true;
+}
+
+template<typename T, template<typename U> class Descriptor>
+void BlockLattice3D<T,Descriptor>::clearActiveCells() {
+    activeCellsOnly = false;
+    std::vector<Dot3D>().swap(activeCells);
+    std::vector<plint>().swap(activeNeighbors);
+}
+
+template<typename T, template<typename U> class Descriptor>
+bool BlockLattice3D<T,Descriptor>::hasActiveCells() const {
+    return activeCellsOnly;
+}
+
+template<typename T, template<typename U> class Descriptor>
+std::vector<Dot3D> const& BlockLattice3D<T,Descriptor>::getActiveCells() const {
+    return activeCells;
+}
+
+template<typename T, template<typename U> class Descriptor>
+void BlockLattice3D<T,Descriptor>::activeCollide(Box3D domain) {
+    for (pluint iCell=0; iCell<activeCells.size(); ++iCell) {
+        Dot3D const& pos = activeCells[iCell];
+        if (contained(pos.x,pos.y,pos.z, domain)) {
+            grid[pos.x][pos.y][pos.z].collide(this->getInternalStatistics());
+            grid[pos.x][pos.y][pos.z].revert();
+        }
+    }
+}
+
+/** As in boundaryStream(), populations are only exchanged with neighbors inside
+ *  the domain; in addition, the neighbor must be active.
+ */
+template<typename T, template<typename U> class Descriptor>
+void BlockLattice3D<T,Descriptor>::activeStream(Box3D domain) {
+    static const plint half = Descriptor<T>::q/2;
+    for (pluint iCell=0; iCell<activeCells.size(); ++iCell) {
+        Dot3D const& pos = activeCells[iCell];
+        if (!contained(pos.x,pos.y,pos.z, domain)) {
+            continue;
+        }
+        Cell<T,Descriptor>& cell = grid[pos.x][pos.y][pos.z];
+        for (plint iPop=1; iPop<=half; ++iPop) {
+            plint iNext = activeNeighbors[iCell*half + iPop-1];
+            if (iNext >= 0) {
+                Dot3D const& next = activeCells[iNext];
+                if (contained(next.x,next.y,next.z, domain)) {
+                    std::swap(cell[iPop+half], grid[next.x][next.y][next.z][iPop]);
+                }
+            }
+        }
+    }
+}
+
+/** The list is sorted like the loops of linearBulkCollideAndStream(), so that
+ *  the neighbors in the directions 1 to q/2 are post-collision cells when
+ *  a cell is swapped with them.
+ */
+template<typename T, template<typename U> class Descriptor>
+void BlockLattice3D<T,Descriptor>::activeCollideAndStream(Box3D domain) {
+    static const plint half = Descriptor<T>::q/2;
+    for (pluint iCell=0; iCell<activeCells.size(); ++iCell) {
+        Dot3D const& pos = activeCells[iCell];
+        if (!contained(pos.x,pos.y,pos.z, domain)) {
+            continue;
+        }
+        Cell<T,Descriptor>& cell = grid[pos.x][pos.y][pos.z];
+        cell.collide(this->getInternalStatistics());
+        cell.revert();
+        for (plint iPop=1; iPop<=half; ++iPop) {
+            plint iNext = activeNeighbors[iCell*half + iPop-1];
+            if (iNext >= 0) {
+                Dot3D const& next = activeCells[iNext];
+                if (contained(next.x,next.y,next.z, domain)) {
+                    std::swap(cell[iPop+half], grid[next.x][next.y][next.z][iPop]);
+                }
+            }
+        }
+    }
+}
+
 template<typename T, template<typename U> class Descriptor>
 void BlockLattice3D<T,Descriptor>::implementPeriodicity() {
     static const plint vicinity = Descriptor<T>::vicinity;
@@ -688,6 +913,15 @@ plint BlockLatticeDataTransfer3D<T,Descriptor>::staticCellSize() const {
     return sizeof(T)* (Descriptor<T>::numPop + Descriptor<T>::ExternalField::numScalars);
 }
 
+template<typename T, template<typename U> class Descriptor>
+plint BlockLatticeDataTransfer3D<T,Descriptor>::staticPartSize(modif::ModifT kind) {
+    PLB_PRECONDITION( modif::isStaticPart(kind) );
+    if (kind==modif::populations) {
+        return sizeof(T)*Descriptor<T>::numPop;
+    }
+    return sizeof(T)*Descriptor<T>::ExternalField::numScalars;
+}
+
 template<typename T, template<typename U> class Descriptor>
 void BlockLatticeDataTransfer3D<T,Descriptor>::send (
         Box3D domain, std::vector<char>& buffer, modif::ModifT kind ) const
@@ -707,6 +941,9 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::send (
         case modif::allVariables:  
         case modif::dataStructure:
             send_all(domain,buffer); break;
+        case modif::populations:
+        case modif::externalVariables:
+            send_part(domain, buffer, kind); break;
         default: PLB_ASSERT(false);
     }
 }
@@ -733,6 +970,30 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::send_static (
     }
 }
 
+template<typename T, template<typename U> class Descriptor>
+void BlockLatticeDataTransfer3D<T,Descriptor>::send_part (
+        Box3D domain, std::vector<char>& buffer, modif::ModifT kind ) const
+{
+    PLB_PRECONDITION( constLattice );
+    plint partSize = staticPartSize(kind);
+    pluint numBytes = domain.nCells()*partSize;
+    // Avoid dereferencing uninitialized pointer.
+    if (numBytes==0) return;
+    buffer.resize(numBytes);
+
+    plint iData=0;
+    for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
+        for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
+            for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
+                Cell<T,Descriptor> const& cell = constLattice->get(iX,iY,iZ);
+                T const* part = kind==modif::populations ? &cell[0] : cell.getExternal(0);
+                memcpy((void*)(&buffer[iData]), (const void*)part, partSize);
+                iData += partSize;
+            }
+        }
+    }
+}
+
 template<typename T, template<typename U> class Descriptor>
 void BlockLatticeDataTransfer3D<T,Descriptor>::send_dynamic (
         Box3D domain, std::vector<char>& buffer ) const
@@ -799,6 +1060,9 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::receive (
             receive_all(domain, buffer); break;
         case modif::dataStructure:
             receive_regenerate(domain, buffer); break;
+        case modif::populations:
+        case modif::externalVariables:
+            receive_part(domain, buffer, kind); break;
         default:
             PLB_ASSERT( false );
     }
@@ -825,6 +1089,29 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::receive_static (
     }
 }
 
+template<typename T, template<typename U> class Descriptor>
+void BlockLatticeDataTransfer3D<T,Descriptor>::receive_part (
+        Box3D domain, std::vector<char> const& buffer, modif::ModifT kind )
+{
+    PLB_PRECONDITION( lattice );
+    PLB_PRECONDITION( (plint) buffer.size() == domain.nCells()*staticPartSize(kind) );
+    // Avoid dereferencing uninitialized pointer.
+    if (buffer.empty()) return;
+    plint partSize = staticPartSize(kind);
+
+    plint iData=0;
+    for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
+        for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
+            for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
+                Cell<T,Descriptor>& cell = lattice->get(iX,iY,iZ);
+                T* part = kind==modif::populations ? &cell[0] : cell.getExternal(0);
+                memcpy((void*)part, (const void*)(&buffer[iData]), partSize);
+                iData += partSize;
+            }
+        }
+    }
+}
+
 template<typename T, template<typename U> class Descriptor>
 void BlockLatticeDataTransfer3D<T,Descriptor>::receive_dynamic (
         Box3D domain, std::vector<char> const& buffer )
@@ -884,7 +1171,7 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::receive_regenerate (
                 Dynamics<T,Descriptor>* newDynamics =
                     meta::dynamicsRegistration<T,Descriptor>().generate(unserializer);
                 posInBuffer = unserializer.getCurrentPos();
-                lattice->attributeDynamics(iX,iY,iZ, newDynamics);
+                lattice->attributeDynamics(iX,iY,iZ, lattice->replaceBySharedDynamics(newDynamics));
 
                 // 2. Unserialize static data.
                 if (staticCellSize()>0) {
@@ -916,6 +1203,9 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::attribute (
             attribute_all(toDomain, deltaX, deltaY, deltaZ, fromLattice); break;
         case modif::dataStructure:
             attribute_regenerate(toDomain, deltaX, deltaY, deltaZ, fromLattice); break;
+        case modif::populations:
+        case modif::externalVariables:
+            attribute_part(toDomain, deltaX, deltaY, deltaZ, fromLattice, kind); break;
         default:
             PLB_ASSERT( false );
     }
@@ -937,6 +1227,30 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::attribute_static (
     }
 }
 
+template<typename T, template<typename U> class Descriptor>
+void BlockLatticeDataTransfer3D<T,Descriptor>::attribute_part (
+        Box3D toDomain, plint deltaX, plint deltaY, plint deltaZ,
+        BlockLattice3D<T,Descriptor> const& from, modif::ModifT kind )
+{
+    PLB_PRECONDITION( lattice );
+    for (plint iX=toDomain.x0; iX<=toDomain.x1; ++iX) {
+        for (plint iY=toDomain.y0; iY<=toDomain.y1; ++iY) {
+            for (plint iZ=toDomain.z0; iZ<=toDomain.z1; ++iZ) {
+                Cell<T,Descriptor>& cell = lattice->get(iX,iY,iZ);
+                Cell<T,Descriptor> const& fromCell = from.get(iX+deltaX,iY+deltaY,iZ+deltaZ);
+                if (kind==modif::populations) {
+                    cell.attributeF(fromCell);
+                }
+                else {
+                    for (plint iExt=0; iExt<Descriptor<T>::ExternalField::numScalars; ++iExt) {
+                        *cell.getExternal(iExt) = *fromCell.getExternal(iExt);
+                    }
+                }
+            }
+        }
+    }
+}
+
 template<typename T, template<typename U> class Descriptor>
 void BlockLatticeDataTransfer3D<T,Descriptor>::attribute_dynamic (
         Box3D toDomain, plint deltaX, plint deltaY, plint deltaZ,
@@ -1004,7 +1318,7 @@ void BlockLatticeDataTransfer3D<T,Descriptor>::attribute_regenerate (
                 HierarchicUnserializer unserializer(serializedData, 0);
                 Dynamics<T,Descriptor>* newDynamics =
                     meta::dynamicsRegistration<T,Descriptor>().generate(unserializer);
-                lattice->attributeDynamics(iX,iY,iZ, newDynamics);
+                lattice->attributeDynamics(iX,iY,iZ, lattice->replaceBySharedDynamics(newDynamics));
 
                 // 2. Attribute static content.
                 lattice->get(iX,iY,iZ).attributeValues (
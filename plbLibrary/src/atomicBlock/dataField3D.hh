@@ -40,6 +40,7 @@
 #include "atomicBlock/dataField3D.h"
 #include "atomicBlock/atomicBlock3D.h"
 #include "core/plbTimer.h"
+#include "core/blockAllocator.h"
 #include <algorithm>
 #include <typeinfo>
 #include <cstring>
@@ -116,11 +117,13 @@ void ScalarField3D<T>::reset() {
 template<typename T>
 void ScalarField3D<T>::allocateMemory() {
     if (ownsMemory) {
-        rawData = new T [(pluint)this->getNx()*(pluint)this->getNy()*(pluint)this->getNz()];
+        rawData = allocateBlockData<T>((pluint)this->getNx()*(pluint)this->getNy()*(pluint)this->getNz());
     }
     field   = new T** [(pluint)this->getNx()];
+    // The line pointers of all x-planes share one table.
+    T** lines = this->getNx()>0 ? new T* [(pluint)this->getNx()*(pluint)this->getNy()] : 0;
     for (plint iX=0; iX<this->getNx(); ++iX) {
-        field[iX] = new T* [(pluint)this->getNy()];
+        field[iX] = lines + (pluint)this->getNy()*(pluint)iX;
         for (plint iY=0; iY<this->getNy(); ++iY) {
             field[iX][iY] = rawData + (pluint)this->getNz()*((pluint)iY+(pluint)this->getNy()*(pluint)iX);
         }
@@ -129,12 +132,13 @@ void ScalarField3D<T>::allocateMemory() {
 
 template<typename T>
 void ScalarField3D<T>::releaseMemory() {
-    for (plint iX=0; iX<this->getNx(); ++iX) {
-      delete [] field[iX];
+    if (this->getNx()>0) {
+        delete [] field[0];
     }
     delete [] field;
     if (ownsMemory) {
-        delete [] rawData; rawData = 0;
+        releaseBlockData(rawData, (pluint)this->getNx()*(pluint)this->getNy()*(pluint)this->getNz());
+        rawData = 0;
     }
 }
 
@@ -331,11 +335,13 @@ void TensorField3D<T,nDim>::reset() {
 template<typename T, int nDim>
 void TensorField3D<T,nDim>::allocateMemory() {
     if (ownsMemory) {
-        rawData = new Array<T,nDim>   [(pluint)this->getNx()*(pluint)this->getNy()*(pluint)this->getNz()];
+        rawData = allocateBlockData<Array<T,nDim> >((pluint)this->getNx()*(pluint)this->getNy()*(pluint)this->getNz());
     }
     field   = new Array<T,nDim>** [(pluint)this->getNx()];
+    // The line pointers of all x-planes share one table.
+    Array<T,nDim>** lines = this->getNx()>0 ? new Array<T,nDim>* [(pluint)this->getNx()*(pluint)this->getNy()] : 0;
     for (plint iX=0; iX<this->getNx(); ++iX) {
-        field[iX] = new Array<T,nDim>* [(pluint)this->getNy()];
+        field[iX] = lines + (pluint)this->getNy()*(pluint)iX;
         for (plint iY=0; iY<this->getNy(); ++iY) {
             field[iX][iY] = rawData + (pluint)this->getNz()*((pluint)iY+(pluint)this->getNy()*(pluint)iX);
         }
@@ -354,12 +360,13 @@ plint TensorField3D<T,nDim>::allocatedMemory() const {
 
 template<typename T, int nDim>
 void TensorField3D<T,nDim>::releaseMemory() {
-    for (plint iX=0; iX<this->getNx(); ++iX) {
-        delete [] field[iX];
+    if (this->getNx()>0) {
+        delete [] field[0];
     }
     delete [] field;
     if (ownsMemory) {
-        delete [] rawData; rawData = 0;
+        releaseBlockData(rawData, (pluint)this->getNx()*(pluint)this->getNy()*(pluint)this->getNz());
+        rawData = 0;
     }
 }
 
@@ -560,8 +567,8 @@ void NTensorField3D<T>::reset() {
 template<typename T>
 void NTensorField3D<T>::allocateMemory() {
     if (ownsMemory) {
-        rawData = new T [(pluint)this->getNx()*(pluint)this->getNy()*
-                         (pluint)this->getNz()*(pluint)this->getNdim()];
+        rawData = allocateBlockData<T>((pluint)this->getNx()*(pluint)this->getNy()*
+                                       (pluint)this->getNz()*(pluint)this->getNdim());
     }
     field   = new T*** [(pluint)this->getNx()];
     for (plint iX=0; iX<this->getNx(); ++iX) {
@@ -598,7 +605,9 @@ void NTensorField3D<T>::releaseMemory() {
     }
     delete [] field;
     if (ownsMemory) {
-        delete [] rawData; rawData = 0;
+        releaseBlockData(rawData, (pluint)this->getNx()*(pluint)this->getNy()*
+                                  (pluint)this->getNz()*(pluint)this->getNdim());
+        rawData = 0;
     }
 }
 
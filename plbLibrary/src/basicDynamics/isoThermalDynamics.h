@@ -877,6 +877,10 @@ public:
     virtual void collideExternal(Cell<T,Descriptor>& cell, T rhoBar,
                          Array<T,Descriptor<T>::d> const& j, T thetaBar, BlockStatistics& stat);
 
+    /// Vectorized collision step on a run of cells sharing this object
+    virtual bool collideRun(Cell<T,Descriptor>* cells, plint numCells,
+                            BlockStatistics& statistics);
+
     /// Compute equilibrium distribution function
     virtual T computeEquilibrium(plint iPop, T rhoBar, Array<T,Descriptor<T>::d> const& j,
                                  T jSqr, T thetaBar=T()) const;
@@ -46,6 +46,7 @@
 #include "latticeBoltzmann/externalForceTemplates.h"
 #include "latticeBoltzmann/offEquilibriumTemplates.h"
 #include "latticeBoltzmann/d3q13Templates.h"
+#include "latticeBoltzmann/simdDynamicsTemplates.h"
 #include "latticeBoltzmann/geometricOperationTemplates.h"
 #include "core/latticeStatistics.h"
 #include <algorithm>
@@ -2232,6 +2233,14 @@ void ExternalMomentRegularizedBGKdynamics<T,Descriptor>::collideExternal (
     }
 }
 
+template<typename T, template<typename U> class Descriptor>
+bool ExternalMomentRegularizedBGKdynamics<T,Descriptor>::collideRun (
+        Cell<T,Descriptor>* cells, plint numCells, BlockStatistics& statistics )
+{
+    return simdDynamicsTemplates<T,Descriptor>::externalMomentRlbCollideRun (
+               cells, numCells, this->getOmega(), statistics );
+}
+
 template<typename T, template<typename U> class Descriptor>
 T ExternalMomentRegularizedBGKdynamics<T,Descriptor>::computeEquilibrium (
         plint iPop, T rhoBar, Array<T,Descriptor<T>::d> const& j,
@@ -0,0 +1,288 @@
+/* This file is part of the Palabos library.
+ *
+ * The Palabos softare is developed since 2011 by FlowKit-Numeca Group Sarl
+ * (Switzerland) and the University of Geneva (Switzerland), which jointly
+ * own the IP rights for most of the code base. Since October 2019, the
+ * Palabos project is maintained by the University of Geneva and accepts
+ * source code contributions from the community.
+ * 
+ * Contact:
+ * Jonas Latt
+ * Computer Science Department
+ * University of Geneva
+ * 7 Route de Drize
+ * 1227 Carouge, Switzerland
+ * jonas.latt@unige.ch
+ *
+ * The most recent release of Palabos can be downloaded at 
+ * <https://palabos.unige.ch/>
+ *
+ * The library Palabos is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * The library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ * Allocation of the bulk storage of atomic blocks -- implementation.
+ */
+
+#include "core/blockAllocator.h"
+#include "core/runTimeDiagnostics.h"
+#include "parallelism/mpiManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+#ifdef PLB_USE_POSIX
+#include <sys/mman.h>
+#endif
+
+namespace plb {
+
+namespace {
+
+pluint roundUp(pluint value, pluint multiple) {
+    return ((value + multiple - 1) / multiple) * multiple;
+}
+
+/// Aligned memory from the C heap. The pointer returned in base must be
+///   passed to std::free.
+char* alignedMalloc(pluint numBytes, pluint alignment, void*& base) {
+    base = std::malloc(numBytes + alignment);
+    if (!base) {
+        throw PlbMemoryException("Block allocator: out of memory");
+    }
+    return reinterpret_cast<char*>(roundUp(reinterpret_cast<pluint>(base), alignment));
+}
+
+}  // namespace
+
+/* *************** Class BlockAllocationStatistics ************************* */
+
+BlockAllocationStatistics::BlockAllocationStatistics()
+    : numAllocations(0), numReused(0), numLive(0),
+      bytesLive(0), bytesPeak(0), bytesReserved(0), bytesHugePages(0)
+{ }
+
+/* *************** Class BlockAllocator ************************************ */
+
+void BlockAllocator::recordAllocation(pluint numBytes, bool reused) {
+    ++statistics.numAllocations;
+    if (reused) {
+        ++statistics.numReused;
+    }
+    ++statistics.numLive;
+    statistics.bytesLive += numBytes;
+    statistics.bytesPeak = std::max(statistics.bytesPeak, statistics.bytesLive);
+}
+
+void BlockAllocator::recordRelease(pluint numBytes) {
+    --statistics.numLive;
+    statistics.bytesLive -= numBytes;
+}
+
+/* *************** Class HeapBlockAllocator ******************************** */
+
+HeapBlockAllocator::~HeapBlockAllocator() {
+    std::map<void*, HeapBlock>::iterator it = liveBlocks.begin();
+    for (; it != liveBlocks.end(); ++it) {
+        std::free(it->second.base);
+    }
+}
+
+void* HeapBlockAllocator::allocate(pluint numBytes) {
+    pluint size = roundUp(std::max(numBytes, (pluint)1), blockAlignment);
+    HeapBlock block;
+    char* ptr = alignedMalloc(size, blockAlignment, block.base);
+    block.size = size;
+    liveBlocks[ptr] = block;
+    statistics.bytesReserved += size;
+    recordAllocation(size, false);
+    return ptr;
+}
+
+void HeapBlockAllocator::release(void* ptr) {
+    std::map<void*, HeapBlock>::iterator it = liveBlocks.find(ptr);
+    PLB_ASSERT( it != liveBlocks.end() );
+    statistics.bytesReserved -= it->second.size;
+    recordRelease(it->second.size);
+    std::free(it->second.base);
+    liveBlocks.erase(it);
+}
+
+std::string HeapBlockAllocator::getName() const {
+    return "heap";
+}
+
+/* *************** Class ArenaBlockAllocator ******************************* */
+
+ArenaBlockAllocator::ArenaBlockAllocator(bool useHugePages_, pluint chunkSize_)
+    : useHugePages(useHugePages_),
+      chunkSize(roundUp(std::max(chunkSize_, (pluint)1), hugePageSize))
+{ }
+
+ArenaBlockAllocator::~ArenaBlockAllocator() {
+    for (pluint iChunk=0; iChunk<chunks.size(); ++iChunk) {
+        unmapChunk(chunks[iChunk]);
+    }
+}
+
+void* ArenaBlockAllocator::allocate(pluint numBytes) {
+    pluint size = roundUp(std::max(numBytes, (pluint)1), blockAlignment);
+
+    // Reuse the smallest released block which fits, unless it is much too large.
+    std::multimap<pluint, char*>::iterator it = freeBlocks.lower_bound(size);
+    if (it != freeBlocks.end() && it->first <= size + size/4) {
+        char* ptr = it->second;
+        pluint blockSize = it->first;
+        freeBlocks.erase(it);
+        liveBlocks[ptr] = blockSize;
+        recordAllocation(blockSize, true);
+        return ptr;
+    }
+
+    // Otherwise, carve the block from the current chunk, or map a new one.
+    if (chunks.empty() || chunks.back().size - chunks.back().used < size) {
+        if (!chunks.empty() && chunks.back().used < chunks.back().size) {
+            // The tail of the previous chunk is kept for smaller requests.
+            Chunk& last = chunks.back();
+            freeBlocks.insert(std::make_pair(last.size-last.used, last.begin+last.used));
+            last.used = last.size;
+        }
+        chunks.push_back(mapChunk(std::max(chunkSize, roundUp(size, hugePageSize))));
+    }
+    Chunk& chunk = chunks.back();
+    char* ptr = chunk.begin + chunk.used;
+    chunk.used += size;
+    liveBlocks[ptr] = size;
+    recordAllocation(size, false);
+    return ptr;
+}
+
+void ArenaBlockAllocator::release(void* ptr) {
+    std::map<char*, pluint>::iterator it = liveBlocks.find(static_cast<char*>(ptr));
+    PLB_ASSERT( it != liveBlocks.end() );
+    recordRelease(it->second);
+    freeBlocks.insert(std::make_pair(it->second, it->first));
+    liveBlocks.erase(it);
+}
+
+std::string ArenaBlockAllocator::getName() const {
+    return useHugePages ? "arena (huge pages)" : "arena";
+}
+
+/// Maps numBytes (a multiple of the huge-page size) aligned on a huge page.
+/** The pages are not touched here: they are placed on the NUMA node of the
+ *  process which first writes to them.
+ */
+ArenaBlockAllocator::Chunk ArenaBlockAllocator::mapChunk(pluint numBytes) {
+    Chunk chunk;
+    chunk.size = numBytes;
+    chunk.used = 0;
+    chunk.base = 0;
+#if defined(PLB_USE_POSIX) && defined(MAP_ANONYMOUS)
+    pluint mapSize = numBytes + hugePageSize;
+    void* mapped = mmap(0, mapSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw PlbMemoryException("Arena block allocator: mmap failed");
+    }
+    char* raw = static_cast<char*>(mapped);
+    chunk.begin = reinterpret_cast<char*>(roundUp(reinterpret_cast<pluint>(raw), hugePageSize));
+    // Trim the slack used for the alignment.
+    if (chunk.begin > raw) {
+        munmap(raw, chunk.begin-raw);
+    }
+    pluint tail = (raw+mapSize) - (chunk.begin+numBytes);
+    if (tail > 0) {
+        munmap(chunk.begin+numBytes, tail);
+    }
+#ifdef MADV_HUGEPAGE
+    if (useHugePages && madvise(chunk.begin, numBytes, MADV_HUGEPAGE) == 0) {
+        statistics.bytesHugePages += numBytes;
+    }
+#endif
+#else
+    chunk.begin = alignedMalloc(numBytes, blockAlignment, chunk.base);
+#endif
+    statistics.bytesReserved += numBytes;
+    return chunk;
+}
+
+void ArenaBlockAllocator::unmapChunk(Chunk const& chunk) {
+#if defined(PLB_USE_POSIX) && defined(MAP_ANONYMOUS)
+    munmap(chunk.begin, chunk.size);
+#else
+    std::free(chunk.base);
+#endif
+}
+
+namespace global {
+
+namespace {
+
+BlockAllocator*& blockAllocatorInstance() {
+    // Intentionally never deleted, because atomic blocks with static storage
+    //   duration may still release their memory at program exit.
+    static BlockAllocator* instance = new HeapBlockAllocator;
+    return instance;
+}
+
+}  // namespace
+
+BlockAllocator& blockAllocator() {
+    return *blockAllocatorInstance();
+}
+
+void setBlockAllocator(BlockAllocator* allocator) {
+    PLB_ASSERT( allocator );
+    BlockAllocator*& instance = blockAllocatorInstance();
+    if (instance->getStatistics().numLive > 0) {
+        delete allocator;
+        throw PlbLogicException("setBlockAllocator: atomic blocks allocated with the "
+                                "current allocator are still alive");
+    }
+    delete instance;
+    instance = allocator;
+}
+
+std::string blockAllocationReport() {
+    BlockAllocationStatistics const& stat = blockAllocator().getStatistics();
+    const double MB = 1024.*1024.;
+    std::vector<double> sums(7), maxima(2);
+    sums[0] = (double)stat.numAllocations;
+    sums[1] = (double)stat.numReused;
+    sums[2] = (double)stat.numLive;
+    sums[3] = (double)stat.bytesLive / MB;
+    sums[4] = (double)stat.bytesPeak / MB;
+    sums[5] = (double)stat.bytesReserved / MB;
+    sums[6] = (double)stat.bytesHugePages / MB;
+    maxima[0] = sums[4];
+    maxima[1] = sums[5];
+#ifdef PLB_MPI_PARALLEL
+    mpi().allReduceVect(sums, MPI_SUM);
+    mpi().allReduceVect(maxima, MPI_MAX);
+#endif
+    std::ostringstream report;
+    report << "block allocation report (" << blockAllocator().getName() << ", "
+           << mpi().getSize() << " processes)" << std::endl;
+    report << "  allocations: " << (plint)sums[0] << ", reused: " << (plint)sums[1]
+           << ", live: " << (plint)sums[2] << std::endl;
+    report << "  live memory: " << sums[3] << " MB, peak: " << sums[4]
+           << " MB (max per process: " << maxima[0] << " MB)" << std::endl;
+    report << "  reserved: " << sums[5] << " MB (max per process: " << maxima[1]
+           << " MB), advised for huge pages: " << sums[6] << " MB" << std::endl;
+    return report.str();
+}
+
+}  // namespace global
+
+}  // namespace plb
@@ -0,0 +1,178 @@
+/* This file is part of the Palabos library.
+ *
+ * The Palabos softare is developed since 2011 by FlowKit-Numeca Group Sarl
+ * (Switzerland) and the University of Geneva (Switzerland), which jointly
+ * own the IP rights for most of the code base. Since October 2019, the
+ * Palabos project is maintained by the University of Geneva and accepts
+ * source code contributions from the community.
+ * 
+ * Contact:
+ * Jonas Latt
+ * Computer Science Department
+ * University of Geneva
+ * 7 Route de Drize
+ * 1227 Carouge, Switzerland
+ * jonas.latt@unige.ch
+ *
+ * The most recent release of Palabos can be downloaded at 
+ * <https://palabos.unige.ch/>
+ *
+ * The library Palabos is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * The library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ * Allocation of the bulk storage of atomic blocks (populations of a
+ * BlockLattice3D, values of the 3D data fields) -- header file.
+ */
+#ifndef BLOCK_ALLOCATOR_H
+#define BLOCK_ALLOCATOR_H
+
+#include "core/globalDefs.h"
+#include <cstddef>
+#include <new>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace plb {
+
+/// Counters kept by every block allocator, for the allocation report.
+struct BlockAllocationStatistics {
+    BlockAllocationStatistics();
+    pluint numAllocations;     ///< Number of calls to allocate().
+    pluint numReused;          ///< Allocations served from previously released memory.
+    pluint numLive;            ///< Allocations not yet released.
+    pluint bytesLive;          ///< Bytes currently handed out.
+    pluint bytesPeak;          ///< Maximum of bytesLive.
+    pluint bytesReserved;      ///< Bytes obtained from the operating system.
+    pluint bytesHugePages;     ///< Part of bytesReserved advised for huge pages.
+};
+
+/// Interface of the allocators used for the bulk data of atomic blocks.
+/** The allocator hands out raw memory aligned on cache lines. It never
+ *  writes into the memory it hands out, so that the pages are first
+ *  touched (and placed on a NUMA node) by the process which initializes
+ *  the block.
+ */
+class BlockAllocator {
+public:
+    virtual ~BlockAllocator() { }
+    /// Raw memory of at least numBytes bytes, aligned on blockAlignment.
+    virtual void* allocate(pluint numBytes) =0;
+    /// Return memory obtained from allocate() with the same allocator.
+    virtual void release(void* ptr) =0;
+    virtual std::string getName() const =0;
+    BlockAllocationStatistics const& getStatistics() const { return statistics; }
+public:
+    static const pluint blockAlignment = 64;
+protected:
+    void recordAllocation(pluint numBytes, bool reused);
+    void recordRelease(pluint numBytes);
+protected:
+    BlockAllocationStatistics statistics;
+};
+
+/// Default allocator: cache-line aligned memory from the C heap.
+class HeapBlockAllocator : public BlockAllocator {
+public:
+    virtual ~HeapBlockAllocator();
+    virtual void* allocate(pluint numBytes);
+    virtual void release(void* ptr);
+    virtual std::string getName() const;
+private:
+    struct HeapBlock {
+        void* base;
+        pluint size;
+    };
+    std::map<void*, HeapBlock> liveBlocks;
+};
+
+/// Arena allocator: memory is taken from large chunks mapped directly from
+///   the operating system, advised for 2 MB (transparent) huge pages.
+/** Released blocks are kept in the arena and reused for later requests of
+ *  a similar size, which is the common pattern when multi-blocks are copied
+ *  or re-created. The chunks are returned to the operating system only when
+ *  the arena is destroyed. There is one arena per MPI process.
+ */
+class ArenaBlockAllocator : public BlockAllocator {
+public:
+    ArenaBlockAllocator(bool useHugePages_=true, pluint chunkSize_=64*1024*1024);
+    virtual ~ArenaBlockAllocator();
+    virtual void* allocate(pluint numBytes);
+    virtual void release(void* ptr);
+    virtual std::string getName() const;
+public:
+    static const pluint hugePageSize = 2*1024*1024;
+private:
+    ArenaBlockAllocator(ArenaBlockAllocator const& rhs);
+    ArenaBlockAllocator& operator=(ArenaBlockAllocator const& rhs);
+private:
+    struct Chunk {
+        char* begin;
+        void* base;     ///< Only used when mmap is not available.
+        pluint size;
+        pluint used;
+    };
+    Chunk mapChunk(pluint numBytes);
+    void unmapChunk(Chunk const& chunk);
+private:
+    bool useHugePages;
+    pluint chunkSize;
+    std::vector<Chunk> chunks;
+    std::multimap<pluint, char*> freeBlocks;  ///< Released blocks, by size.
+    std::map<char*, pluint> liveBlocks;       ///< Handed-out blocks and their size.
+};
+
+namespace global {
+
+/// Allocator used by all atomic blocks of this process.
+BlockAllocator& blockAllocator();
+
+/// Replace the allocator; takes ownership of the argument.
+/** Must be called before any atomic block is created (or after all of them
+ *  are destroyed), because memory is released with the allocator which
+ *  provided it.
+ */
+void setBlockAllocator(BlockAllocator* allocator);
+
+/// Human-readable summary of the allocations, summed over all processes.
+/** This is a collective call. */
+std::string blockAllocationReport();
+
+}  // namespace global
+
+/// Allocate and default-initialize numElements objects of type T.
+template<typename T>
+T* allocateBlockData(pluint numElements) {
+    T* data = static_cast<T*>(global::blockAllocator().allocate(numElements*sizeof(T)));
+    for (pluint i=0; i<numElements; ++i) {
+        new (data+i) T;
+    }
+    return data;
+}
+
+/// Destroy and release data obtained from allocateBlockData.
+template<typename T>
+void releaseBlockData(T* data, pluint numElements) {
+    if (data) {
+        for (pluint i=0; i<numElements; ++i) {
+            data[i].~T();
+        }
+        global::blockAllocator().release(data);
+    }
+}
+
+}  // namespace plb
+
+#endif  // BLOCK_ALLOCATOR_H
@@ -126,6 +126,12 @@ struct Dynamics {
     virtual void collideExternal(Cell<T,Descriptor>& cell, T rhoBar,
                          Array<T,Descriptor<T>::d> const& j, T thetaBar, BlockStatistics& stat);
 
+    /// Collision step on numCells consecutive cells which all point to this dynamics object
+    /** Returns false if the dynamics has no specialized (vectorized) implementation,
+     *  in which case nothing is done and the caller collides the cells one by one.
+     */
+    virtual bool collideRun(Cell<T,Descriptor>* cells, plint numCells, BlockStatistics& statistics);
+
     /// Compute equilibrium distribution function
     virtual T computeEquilibrium(plint iPop, T rhoBar, Array<T,Descriptor<T>::d> const& j,
                                  T jSqr, T thetaBar=T()) const =0;
@@ -173,6 +173,14 @@ void Dynamics<T,Descriptor>::collideExternal (
     collide(cell, stat);
 }
 
+/** By default, runs of cells are not treated specially. */
+template<typename T, template<typename U> class Descriptor>
+bool Dynamics<T,Descriptor>::collideRun (
+        Cell<T,Descriptor>* cells, plint numCells, BlockStatistics& statistics )
+{
+    return false;
+}
+
 
 template<typename T, template<typename U> class Descriptor>
 void Dynamics<T,Descriptor>::computeEquilibria (
@@ -196,14 +196,40 @@ namespace modif {
         dynamicVariables =2,  //< Only content of dynamics objects, but no static content.
         allVariables     =3,  //< Both the static and dynamic cell content.
         dataStructure    =4,  //< Recreate dynamics and copy both static and dynamic content.
-        undefined        =5   
+        undefined        =5,
+        populations      =6,  //< Part of the static content: the populations only.
+        externalVariables=7   //< Part of the static content: the external scalars only.
     };
 
     enum { numConstants=5 };
 
+    /// Tell if the type of modification is a part of the static cell content.
+    inline bool isStaticPart(ModifT type) {
+        return type==populations || type==externalVariables;
+    }
+
+    /// Tell if the type of modification leads to messages of predictable size.
+    inline bool hasStaticSize(ModifT type) {
+        return type==staticVariables || isStaticPart(type);
+    }
+
     /// If two data processors act on a block, combine their ModifT modification to
     ///   determine a resulting (worst-case) ModifT modification.
     inline ModifT combine(ModifT type1, ModifT type2) {
+        if (type1==type2 || type2==nothing) {
+            return type1;
+        }
+        if (type1==nothing) {
+            return type2;
+        }
+        // Different parts of the static content, or a part of it combined with
+        //   anything else, amount to the full static content.
+        if (isStaticPart(type1)) {
+            type1 = staticVariables;
+        }
+        if (isStaticPart(type2)) {
+            type2 = staticVariables;
+        }
         ModifT result = std::max(type1, type2);
         // Note: static+dynamic = all.
         if ( result==dynamicVariables &&
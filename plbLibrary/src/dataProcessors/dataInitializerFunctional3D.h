@@ -274,6 +274,34 @@ private:
     int whichFlag;
 };
 
+/* ************* Class SharedDynamicsFromIntMaskFunctional3D ****************** */
+
+/// Assign a shared dynamics object to nodes specified by an integer mask.
+/** Unlike DynamicsFromIntMaskFunctional3D, the dynamics is not cloned for every
+ *  node: all matching nodes of an atomic block point to one entry of the
+ *  block's table of shared dynamics (see BlockLattice3D::getSharedDynamics).
+ *  Use this only for dynamics without per-cell state, such as NoDynamics or
+ *  BounceBack.
+ */
+template<typename T, template<typename U> class Descriptor>
+class SharedDynamicsFromIntMaskFunctional3D : public BoxProcessingFunctional3D_LS<T,Descriptor,int> {
+public:
+    SharedDynamicsFromIntMaskFunctional3D(Dynamics<T,Descriptor>* dynamics_, int whichFlag_);
+    SharedDynamicsFromIntMaskFunctional3D(SharedDynamicsFromIntMaskFunctional3D<T,Descriptor> const& rhs);
+    SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>& operator= (
+            SharedDynamicsFromIntMaskFunctional3D<T,Descriptor> const& rhs );
+    virtual ~SharedDynamicsFromIntMaskFunctional3D();
+    virtual void process (
+            Box3D domain, BlockLattice3D<T,Descriptor>& lattice,
+                          ScalarField3D<int>& mask );
+    virtual BlockDomain::DomainT appliesTo() const;
+    virtual void getTypeOfModification(std::vector<modif::ModifT>& modified) const;
+    virtual SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>* clone() const;
+private:
+    Dynamics<T,Descriptor>* dynamics;
+    int whichFlag;
+};
+
 /* *************** Class RecomposeFromOrderZeroVariablesFunctional3D ******************* */
 
 template<typename T, template<typename U> class Descriptor>
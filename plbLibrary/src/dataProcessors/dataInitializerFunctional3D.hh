@@ -734,6 +734,75 @@ DynamicsFromIntMaskFunctional3D<T,Descriptor>*
     return new DynamicsFromIntMaskFunctional3D<T,Descriptor>(*this);
 }
 
+/* ************* Class SharedDynamicsFromIntMaskFunctional3D ****************** */
+
+template<typename T, template<typename U> class Descriptor>
+SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::SharedDynamicsFromIntMaskFunctional3D (
+        Dynamics<T,Descriptor>* dynamics_, int whichFlag_ )
+    : dynamics(dynamics_), whichFlag(whichFlag_)
+{ }
+
+template<typename T, template<typename U> class Descriptor>
+SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::SharedDynamicsFromIntMaskFunctional3D (
+        SharedDynamicsFromIntMaskFunctional3D<T,Descriptor> const& rhs )
+    : dynamics(rhs.dynamics->clone()),
+      whichFlag(rhs.whichFlag)
+{ }
+
+template<typename T, template<typename U> class Descriptor>
+SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>&
+    SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::operator= (
+        SharedDynamicsFromIntMaskFunctional3D<T,Descriptor> const& rhs )
+{
+    delete dynamics; dynamics = rhs.dynamics->clone();
+    whichFlag = rhs.whichFlag;
+    return *this;
+}
+
+template<typename T, template<typename U> class Descriptor>
+SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::~SharedDynamicsFromIntMaskFunctional3D() {
+    delete dynamics;
+}
+
+template<typename T, template<typename U> class Descriptor>
+void SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::process (
+        Box3D domain, BlockLattice3D<T,Descriptor>& lattice,
+                      ScalarField3D<int>& mask )
+{
+    Dot3D offset = computeRelativeDisplacement(lattice, mask);
+    Dynamics<T,Descriptor>* sharedDynamics = lattice.getSharedDynamics(*dynamics);
+    for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
+        for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
+            for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
+                int flag = mask.get(iX+offset.x, iY+offset.y, iZ+offset.z);
+                if ( flag == whichFlag ) {
+                    lattice.attributeDynamics(iX,iY,iZ, sharedDynamics);
+                }
+            }
+        }
+    }
+}
+
+template<typename T, template<typename U> class Descriptor>
+BlockDomain::DomainT SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::appliesTo() const {
+    return BlockDomain::bulk;
+}
+
+template<typename T, template<typename U> class Descriptor>
+void SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::getTypeOfModification (
+        std::vector<modif::ModifT>& modified ) const
+{
+    modified[0] = modif::dataStructure;
+    modified[1] = modif::nothing;
+}
+
+template<typename T, template<typename U> class Descriptor>
+SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>*
+    SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>::clone() const 
+{
+    return new SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>(*this);
+}
+
 /* ************* Class RecomposeFromOrderZeroVariablesFunctional3D ******************* */
 
 template<typename T, template<typename U> class Descriptor>
@@ -88,6 +88,16 @@ void defineDynamics( BlockLattice3D<T,Descriptor>& lattice, ScalarField3D<int>&
 template<typename T, template<typename U> class Descriptor>
 void defineDynamics( BlockLattice3D<T,Descriptor>& lattice, ScalarField3D<int>& intMask,
                      Dynamics<T,Descriptor>* dynamics, int whichFlag );
+
+/// Like defineDynamics with an int mask, but all selected cells of an atomic block
+///   share one instance of the dynamics. Only for dynamics without per-cell state.
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( BlockLattice3D<T,Descriptor>& lattice, ScalarField3D<int>& intMask,
+                           Box3D domain, Dynamics<T,Descriptor>* dynamics, int whichFlag );
+
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( BlockLattice3D<T,Descriptor>& lattice, ScalarField3D<int>& intMask,
+                           Dynamics<T,Descriptor>* dynamics, int whichFlag );
                      
 template<typename T, template<typename U> class Descriptor>
 void recomposeFromFlowVariables ( BlockLattice3D<T,Descriptor>& lattice,
@@ -239,6 +249,16 @@ void defineDynamics( MultiBlockLattice3D<T,Descriptor>& lattice, MultiScalarFiel
 template<typename T, template<typename U> class Descriptor>
 void defineDynamics( MultiBlockLattice3D<T,Descriptor>& lattice, MultiScalarField3D<int>& intMask,
                      Dynamics<T,Descriptor>* dynamics, int whichFlag );
+
+/// Like defineDynamics with an int mask, but all selected cells of an atomic block
+///   share one instance of the dynamics. Only for dynamics without per-cell state.
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( MultiBlockLattice3D<T,Descriptor>& lattice, MultiScalarField3D<int>& intMask,
+                           Box3D domain, Dynamics<T,Descriptor>* dynamics, int whichFlag );
+
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( MultiBlockLattice3D<T,Descriptor>& lattice, MultiScalarField3D<int>& intMask,
+                           Dynamics<T,Descriptor>* dynamics, int whichFlag );
                      
 template<typename T, template<typename U> class Descriptor>
 void recomposeFromFlowVariables ( MultiBlockLattice3D<T,Descriptor>& lattice,
@@ -126,6 +126,22 @@ void defineDynamics( BlockLattice3D<T,Descriptor>& lattice, ScalarField3D<int>&
     defineDynamics(lattice, intMask, lattice.getBoundingBox(), dynamics, whichFlag);
 }
 
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( BlockLattice3D<T,Descriptor>& lattice, ScalarField3D<int>& intMask,
+                           Box3D domain, Dynamics<T,Descriptor>* dynamics, int whichFlag )
+{
+    applyProcessingFunctional (
+            new SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>(dynamics, whichFlag),
+            domain, lattice, intMask );
+}
+
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( BlockLattice3D<T,Descriptor>& lattice, ScalarField3D<int>& intMask,
+                           Dynamics<T,Descriptor>* dynamics, int whichFlag )
+{
+    defineSharedDynamics(lattice, intMask, lattice.getBoundingBox(), dynamics, whichFlag);
+}
+
 template<typename T, template<typename U> class Descriptor>
 void recomposeFromFlowVariables ( BlockLattice3D<T,Descriptor>& lattice,
                                   ScalarField3D<T>& density, TensorField3D<T,3>& velocity,
@@ -350,6 +366,22 @@ void defineDynamics( MultiBlockLattice3D<T,Descriptor>& lattice, MultiScalarFiel
     defineDynamics(lattice, intMask, lattice.getBoundingBox(), dynamics, whichFlag);
 }
 
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( MultiBlockLattice3D<T,Descriptor>& lattice, MultiScalarField3D<int>& intMask,
+                           Box3D domain, Dynamics<T,Descriptor>* dynamics, int whichFlag )
+{
+    applyProcessingFunctional (
+            new SharedDynamicsFromIntMaskFunctional3D<T,Descriptor>(dynamics, whichFlag),
+            domain, lattice, intMask );
+}
+
+template<typename T, template<typename U> class Descriptor>
+void defineSharedDynamics( MultiBlockLattice3D<T,Descriptor>& lattice, MultiScalarField3D<int>& intMask,
+                           Dynamics<T,Descriptor>* dynamics, int whichFlag )
+{
+    defineSharedDynamics(lattice, intMask, lattice.getBoundingBox(), dynamics, whichFlag);
+}
+
 template<typename T, template<typename U> class Descriptor>
 void recomposeFromFlowVariables ( MultiBlockLattice3D<T,Descriptor>& lattice,
                                   MultiScalarField3D<T>& density, MultiTensorField3D<T,3>& velocity,
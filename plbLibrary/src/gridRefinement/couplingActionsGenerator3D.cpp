@@ -0,0 +1,79 @@
+/* This file is part of the Palabos library.
+ *
+ * The Palabos softare is developed since 2011 by FlowKit-Numeca Group Sarl
+ * (Switzerland) and the University of Geneva (Switzerland), which jointly
+ * own the IP rights for most of the code base. Since October 2019, the
+ * Palabos project is maintained by the University of Geneva and accepts
+ * source code contributions from the community.
+ * 
+ * Contact:
+ * Jonas Latt
+ * Computer Science Department
+ * University of Geneva
+ * 7 Route de Drize
+ * 1227 Carouge, Switzerland
+ * jonas.latt@unige.ch
+ *
+ * The most recent release of Palabos can be downloaded at 
+ * <https://palabos.unige.ch/>
+ *
+ * The library Palabos is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * The library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gridRefinement/couplingActionsGenerator3D.h"
+#include "gridRefinement/octreeGridStructure.h"
+#include "multiBlock/sparseBlockStructure3D.h"
+
+namespace plb {
+
+/// Select the blocks of a grid level that hold part of the coupling boxes.
+/** The helper tensors are allocated on the bulks of the lattice blocks (so that they
+ *  are aligned with the lattice and owned by the same processes) which intersect one
+ *  of the boxes, enlarged by the envelope of the coarse tensors.
+ */
+static std::vector<Box3D> selectBlocksOnBoxes(std::vector<Box3D> const& boxes,
+                                              OctreeGridStructure const& ogs, plint level)
+{
+    plint envelopeWidth = 2;
+    MultiBlockManagement3D management = ogs.getMultiBlockManagement(level, envelopeWidth);
+    std::map<plint,Box3D> const& bulks = management.getSparseBlockStructure().getBulks();
+    std::vector<Box3D> selected;
+    std::map<plint,Box3D>::const_iterator it = bulks.begin();
+    for (; it != bulks.end(); ++it) {
+        for (pluint iBox = 0; iBox < boxes.size(); ++iBox) {
+            if (doesIntersect(it->second, boxes[iBox].enlarge(envelopeWidth))) {
+                selected.push_back(it->second);
+                break;
+            }
+        }
+    }
+    return selected;
+}
+
+std::vector<Box3D> optimizeCoarseBoxes(std::vector<boxLogic::DirectedPlane> coarseExt,
+                                       OctreeGridStructure const& ogs, plint level)
+{
+    std::vector<Box3D> boxes;
+    for (pluint iPlane = 0; iPlane < coarseExt.size(); ++iPlane) {
+        boxes.push_back(coarseExt[iPlane].bb);
+    }
+    return selectBlocksOnBoxes(boxes, ogs, level);
+}
+
+std::vector<Box3D> optimizeFineBoxes(std::vector<Box3D> fineBoxes, OctreeGridStructure const& ogs, plint fineLevel)
+{
+    return selectBlocksOnBoxes(fineBoxes, ogs, fineLevel);
+}
+
+}  // namespace plb
@@ -40,6 +40,7 @@
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <map>
 
 #include "core/serializer.h"
 #include "atomicBlock/dataField2D.h"
@@ -47,6 +48,7 @@
 #include "atomicBlock/dataField3D.h"
 #include "multiBlock/multiDataField3D.h"
 #include "core/array.h"
+#include "io/plbFiles.h"
 
 namespace plb {
 
@@ -253,6 +255,42 @@ private:
     plint numEntries, sizeOfEntry, sizeOfFooter, nextDataOffset, iEntry;
 };
 
+/// Output of multi-block fields as a partitioned VTK image: each process writes
+///   the blocks it owns as separate .vti pieces with raw appended binary data,
+///   and the main process writes the .pvti index which references them. No data
+///   is gathered on a single process. The pieces are written when the object
+///   is destroyed.
+template<typename T>
+class PartitionedVtkImageOutput3D {
+public:
+    PartitionedVtkImageOutput3D(std::string fName, double deltaX_=1.);
+    PartitionedVtkImageOutput3D(std::string fName, double deltaX_, Array<double,3> offset);
+    ~PartitionedVtkImageOutput3D();
+    template<typename TConv>
+    void writeData(MultiScalarField3D<T>& scalarField,
+                   std::string scalarFieldName, TConv scalingFactor=(TConv)1, TConv additiveOffset=(TConv)0);
+    template<plint n, typename TConv>
+    void writeData(MultiTensorField3D<T,n>& tensorField,
+                   std::string tensorFieldName, TConv scalingFactor=(TConv)1);
+private:
+    template<typename TConv>
+    void declareField(MultiBlock3D& block, plint nDim, std::string const& name);
+    std::string pieceName(plint blockId) const;
+    void writePieces() const;
+    void writeIndex() const;
+private:
+    FileName fileName;
+    double deltaX;
+    Array<double,3> offset;
+    Box3D boundingBox;
+    /// Extent of all pieces, including the ones on other processes.
+    std::map<plint,Box3D> extents;
+    std::vector<std::string> fieldNames, fieldTypes;
+    std::vector<plint> fieldDims;
+    /// Raw data of the local pieces, one buffer per field.
+    std::map<plint, std::vector<std::vector<char> > > localData;
+};
+
 } // namespace plb
 
 #endif  // VTK_DATA_OUTPUT_H
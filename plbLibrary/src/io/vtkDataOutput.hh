@@ -697,6 +697,248 @@ void ParallelVtkImageOutput3D<T>::writeData( MultiNTensorField3D<T>& nTensorFiel
     delete transformedField;
 }
 
+////////// class PartitionedVtkImageOutput3D ////////////////////////////////////
+
+template<typename T>
+PartitionedVtkImageOutput3D<T>::PartitionedVtkImageOutput3D(std::string fName, double deltaX_)
+    : fileName ( FileName(fName+".pvti").defaultPath(global::directories().getVtkOutDir()) ),
+      deltaX(deltaX_),
+      offset(0.,0.,0.)
+{ }
+
+template<typename T>
+PartitionedVtkImageOutput3D<T>::PartitionedVtkImageOutput3D(std::string fName, double deltaX_, Array<double,3> offset_)
+    : fileName ( FileName(fName+".pvti").defaultPath(global::directories().getVtkOutDir()) ),
+      deltaX(deltaX_),
+      offset(offset_)
+{ }
+
+template<typename T>
+PartitionedVtkImageOutput3D<T>::~PartitionedVtkImageOutput3D() {
+    if (!fieldNames.empty()) {
+        writePieces();
+        writeIndex();
+    }
+}
+
+template<typename T>
+std::string PartitionedVtkImageOutput3D<T>::pieceName(plint blockId) const {
+    std::stringstream name;
+    name << fileName.getName() << "_p" << std::setfill('0') << std::setw(6) << blockId << ".vti";
+    return name.str();
+}
+
+template<typename T>
+template<typename TConv>
+void PartitionedVtkImageOutput3D<T>::declareField (
+        MultiBlock3D& block, plint nDim, std::string const& name )
+{
+    MultiBlockManagement3D const& management = block.getMultiBlockManagement();
+    if (fieldNames.empty()) {
+        boundingBox = block.getBoundingBox();
+        // Pieces share their boundary points with the upper neighbors, as
+        //   required for point data. The shared layer is read from the envelope.
+        std::map<plint,Box3D> const& bulks = management.getSparseBlockStructure().getBulks();
+        std::map<plint,Box3D>::const_iterator it = bulks.begin();
+        for (; it != bulks.end(); ++it) {
+            Box3D extent(it->second);
+            if (extent.x1 < boundingBox.x1) ++extent.x1;
+            if (extent.y1 < boundingBox.y1) ++extent.y1;
+            if (extent.z1 < boundingBox.z1) ++extent.z1;
+            extents[it->first] = extent;
+        }
+    }
+    else {
+        PLB_PRECONDITION( boundingBox == block.getBoundingBox() );
+        PLB_PRECONDITION( extents.size() == management.getSparseBlockStructure().getBulks().size() );
+    }
+    PLB_PRECONDITION( management.getEnvelopeWidth() >= 1 );
+    fieldNames.push_back(name);
+    fieldTypes.push_back(VtkTypeNames<TConv>::getName());
+    fieldDims.push_back(nDim);
+}
+
+template<typename T>
+template<typename TConv>
+void PartitionedVtkImageOutput3D<T>::writeData( MultiScalarField3D<T>& scalarField,
+                                                std::string scalarFieldName, TConv scalingFactor,
+                                                TConv additiveOffset )
+{
+    std::unique_ptr<MultiScalarField3D<TConv> > transformedField = copyConvert<T,TConv>(scalarField);
+    if (!util::isOne(scalingFactor)) {
+        multiplyInPlace(*transformedField, scalingFactor);
+    }
+    if (!util::isZero(additiveOffset)) {
+        addInPlace(*transformedField, additiveOffset);
+    }
+    transformedField->duplicateOverlaps(modif::staticVariables);
+    declareField<TConv>(*transformedField, 1, scalarFieldName);
+
+    std::vector<plint> const& localBlocks
+        = transformedField->getMultiBlockManagement().getLocalInfo().getBlocks();
+    for (pluint iBlock=0; iBlock<localBlocks.size(); ++iBlock) {
+        plint blockId = localBlocks[iBlock];
+        ScalarField3D<TConv> const& component = transformedField->getComponent(blockId);
+        Dot3D location = component.getLocation();
+        Box3D extent = extents[blockId];
+        std::vector<char> buffer(extent.nCells()*sizeof(TConv));
+        TConv* data = (TConv*) &buffer[0];
+        plint iData = 0;
+        for (plint iZ=extent.z0; iZ<=extent.z1; ++iZ) {
+            for (plint iY=extent.y0; iY<=extent.y1; ++iY) {
+                for (plint iX=extent.x0; iX<=extent.x1; ++iX) {
+                    data[iData++] = component.get(iX-location.x, iY-location.y, iZ-location.z);
+                }
+            }
+        }
+        localData[blockId].push_back(std::vector<char>());
+        localData[blockId].back().swap(buffer);
+    }
+}
+
+template<typename T>
+template<plint n, typename TConv>
+void PartitionedVtkImageOutput3D<T>::writeData( MultiTensorField3D<T,n>& tensorField,
+                                                std::string tensorFieldName, TConv scalingFactor )
+{
+    std::unique_ptr<MultiTensorField3D<TConv,n> > transformedField = copyConvert<T,TConv,n>(tensorField);
+    if (!util::isOne(scalingFactor)) {
+        multiplyInPlace(*transformedField, scalingFactor);
+    }
+    transformedField->duplicateOverlaps(modif::staticVariables);
+    declareField<TConv>(*transformedField, n, tensorFieldName);
+
+    std::vector<plint> const& localBlocks
+        = transformedField->getMultiBlockManagement().getLocalInfo().getBlocks();
+    for (pluint iBlock=0; iBlock<localBlocks.size(); ++iBlock) {
+        plint blockId = localBlocks[iBlock];
+        TensorField3D<TConv,n> const& component = transformedField->getComponent(blockId);
+        Dot3D location = component.getLocation();
+        Box3D extent = extents[blockId];
+        std::vector<char> buffer(extent.nCells()*n*sizeof(TConv));
+        TConv* data = (TConv*) &buffer[0];
+        plint iData = 0;
+        for (plint iZ=extent.z0; iZ<=extent.z1; ++iZ) {
+            for (plint iY=extent.y0; iY<=extent.y1; ++iY) {
+                for (plint iX=extent.x0; iX<=extent.x1; ++iX) {
+                    Array<TConv,n> const& value = component.get(iX-location.x, iY-location.y, iZ-location.z);
+                    for (plint iDim=0; iDim<n; ++iDim) {
+                        data[iData++] = value[iDim];
+                    }
+                }
+            }
+        }
+        localData[blockId].push_back(std::vector<char>());
+        localData[blockId].back().swap(buffer);
+    }
+}
+
+template<typename T>
+void PartitionedVtkImageOutput3D<T>::writePieces() const {
+    FileName piecePath(fileName);
+    typename std::map<plint, std::vector<std::vector<char> > >::const_iterator it = localData.begin();
+    for (; it != localData.end(); ++it) {
+        plint blockId = it->first;
+        Box3D extent = extents.find(blockId)->second;
+        std::vector<std::vector<char> > const& buffers = it->second;
+        PLB_ASSERT( buffers.size() == fieldNames.size() );
+
+        std::string fullName = piecePath.setName(pieceName(blockId)).setExt("").get();
+        std::ofstream ostr(fullName.c_str(), std::ios_base::binary);
+        if (!ostr) {
+            std::cerr << "could not open file " << fullName << "\n";
+            continue;
+        }
+        ostr << "<?xml version=\"1.0\"?>\n";
+#ifdef PLB_BIG_ENDIAN
+        ostr << "<VTKFile type=\"ImageData\" version=\"0.1\" byte_order=\"BigEndian\" header_type=\"UInt64\">\n";
+#else
+        ostr << "<VTKFile type=\"ImageData\" version=\"0.1\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+#endif
+        ostr << "<ImageData WholeExtent=\""
+             << extent.x0 << " " << extent.x1 << " "
+             << extent.y0 << " " << extent.y1 << " "
+             << extent.z0 << " " << extent.z1 << "\" "
+             << "Origin=\""
+             << offset[0] << " " << offset[1] << " " << offset[2] << "\" "
+             << "Spacing=\""
+             << deltaX << " " << deltaX << " " << deltaX << "\">\n";
+        ostr << "<Piece Extent=\""
+             << extent.x0 << " " << extent.x1 << " "
+             << extent.y0 << " " << extent.y1 << " "
+             << extent.z0 << " " << extent.z1 << "\">\n";
+        ostr << "<PointData>\n";
+        pluint dataOffset = 0;
+        for (pluint iField=0; iField<fieldNames.size(); ++iField) {
+            ostr << "<DataArray type=\"" << fieldTypes[iField]
+                 << "\" Name=\"" << fieldNames[iField]
+                 << "\" format=\"appended\" NumberOfComponents=\"" << fieldDims[iField]
+                 << "\" offset=\"" << dataOffset << "\"/>\n";
+            dataOffset += sizeof(pluint) + buffers[iField].size();
+        }
+        ostr << "</PointData>\n";
+        ostr << "</Piece>\n";
+        ostr << "</ImageData>\n";
+        ostr << "<AppendedData encoding=\"raw\">\n";
+        ostr << "_";
+        for (pluint iField=0; iField<buffers.size(); ++iField) {
+            pluint binarySize = buffers[iField].size();
+            ostr.write((const char*)&binarySize, sizeof(pluint));
+            if (binarySize > 0) {
+                ostr.write(&buffers[iField][0], binarySize);
+            }
+        }
+        ostr << "\n</AppendedData>\n";
+        ostr << "</VTKFile>\n";
+    }
+}
+
+template<typename T>
+void PartitionedVtkImageOutput3D<T>::writeIndex() const {
+    if (!global::mpi().isMainProcessor()) {
+        return;
+    }
+    std::string fullName = fileName.get();
+    std::ofstream ostr(fullName.c_str());
+    if (!ostr) {
+        std::cerr << "could not open file " << fullName << "\n";
+        return;
+    }
+    ostr << "<?xml version=\"1.0\"?>\n";
+#ifdef PLB_BIG_ENDIAN
+    ostr << "<VTKFile type=\"PImageData\" version=\"0.1\" byte_order=\"BigEndian\" header_type=\"UInt64\">\n";
+#else
+    ostr << "<VTKFile type=\"PImageData\" version=\"0.1\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+#endif
+    ostr << "<PImageData WholeExtent=\""
+         << boundingBox.x0 << " " << boundingBox.x1 << " "
+         << boundingBox.y0 << " " << boundingBox.y1 << " "
+         << boundingBox.z0 << " " << boundingBox.z1 << "\" "
+         << "GhostLevel=\"0\" "
+         << "Origin=\""
+         << offset[0] << " " << offset[1] << " " << offset[2] << "\" "
+         << "Spacing=\""
+         << deltaX << " " << deltaX << " " << deltaX << "\">\n";
+    ostr << "<PPointData>\n";
+    for (pluint iField=0; iField<fieldNames.size(); ++iField) {
+        ostr << "<PDataArray type=\"" << fieldTypes[iField]
+             << "\" Name=\"" << fieldNames[iField]
+             << "\" NumberOfComponents=\"" << fieldDims[iField] << "\"/>\n";
+    }
+    ostr << "</PPointData>\n";
+    std::map<plint,Box3D>::const_iterator it = extents.begin();
+    for (; it != extents.end(); ++it) {
+        Box3D const& extent = it->second;
+        ostr << "<Piece Extent=\""
+             << extent.x0 << " " << extent.x1 << " "
+             << extent.y0 << " " << extent.y1 << " "
+             << extent.z0 << " " << extent.z1 << "\" "
+             << "Source=\"" << pieceName(it->first) << "\"/>\n";
+    }
+    ostr << "</PImageData>\n";
+    ostr << "</VTKFile>\n";
+}
+
 }  // namespace plb
 
 #endif  // VTK_DATA_OUTPUT_HH
@@ -0,0 +1,81 @@
+/* This file is part of the Palabos library.
+ *
+ * The Palabos softare is developed since 2011 by FlowKit-Numeca Group Sarl
+ * (Switzerland) and the University of Geneva (Switzerland), which jointly
+ * own the IP rights for most of the code base. Since October 2019, the
+ * Palabos project is maintained by the University of Geneva and accepts
+ * source code contributions from the community.
+ * 
+ * Contact:
+ * Jonas Latt
+ * Computer Science Department
+ * University of Geneva
+ * 7 Route de Drize
+ * 1227 Carouge, Switzerland
+ * jonas.latt@unige.ch
+ *
+ * The most recent release of Palabos can be downloaded at 
+ * <https://palabos.unige.ch/>
+ *
+ * The library Palabos is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * The library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ * Explicitly vectorized collision kernels. They collide a contiguous run of
+ * cells which share the same dynamics object in one call, processing several
+ * cells per instruction. The generic implementation declines (returns false),
+ * and the caller then falls back to the cell-by-cell collision.
+ */
+#ifndef SIMD_DYNAMICS_TEMPLATES_H
+#define SIMD_DYNAMICS_TEMPLATES_H
+
+#include "core/globalDefs.h"
+#include "core/cell.h"
+#include "core/blockStatistics.h"
+
+namespace plb {
+
+/// Generic case: no vectorized kernel is available for this lattice.
+template<typename T, class BaseDescriptor>
+struct simdDynamicsTemplatesImpl {
+
+template<template<typename U> class Descriptor>
+static bool externalMomentRlbCollideRun( Cell<T,Descriptor>* cells, plint numCells,
+                                         T omega, BlockStatistics& statistics )
+{
+    return false;
+}
+
+};  // struct simdDynamicsTemplatesImpl
+
+/// This structure forwards the calls to the appropriate helper class
+template<typename T, template<typename U> class Descriptor>
+struct simdDynamicsTemplates {
+
+/// Regularized BGK collision with density and momentum read from the external
+///   scalars, applied to numCells consecutive cells.
+static bool externalMomentRlbCollideRun( Cell<T,Descriptor>* cells, plint numCells,
+                                         T omega, BlockStatistics& statistics )
+{
+    return simdDynamicsTemplatesImpl<T,typename Descriptor<T>::BaseDescriptor>
+        ::template externalMomentRlbCollideRun<Descriptor>(cells, numCells, omega, statistics);
+}
+
+};  // struct simdDynamicsTemplates
+
+}  // namespace plb
+
+#include "latticeBoltzmann/simdDynamicsTemplates3D.h"
+
+#endif  // SIMD_DYNAMICS_TEMPLATES_H
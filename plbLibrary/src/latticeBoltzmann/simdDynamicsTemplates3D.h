@@ -0,0 +1,265 @@
+/* This file is part of the Palabos library.
+ *
+ * The Palabos softare is developed since 2011 by FlowKit-Numeca Group Sarl
+ * (Switzerland) and the University of Geneva (Switzerland), which jointly
+ * own the IP rights for most of the code base. Since October 2019, the
+ * Palabos project is maintained by the University of Geneva and accepts
+ * source code contributions from the community.
+ * 
+ * Contact:
+ * Jonas Latt
+ * Computer Science Department
+ * University of Geneva
+ * 7 Route de Drize
+ * 1227 Carouge, Switzerland
+ * jonas.latt@unige.ch
+ *
+ * The most recent release of Palabos can be downloaded at 
+ * <https://palabos.unige.ch/>
+ *
+ * The library Palabos is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * The library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/** \file
+ * 3D specialization of simdDynamicsTemplates functions. The instruction set
+ * is chosen at compile time: AVX-512 (8 doubles per pack), AVX/AVX2 (4 doubles
+ * per pack), or a scalar pack of width one when neither is enabled.
+ */
+
+#ifndef SIMD_DYNAMICS_TEMPLATES_3D_H
+#define SIMD_DYNAMICS_TEMPLATES_3D_H
+
+#include "core/globalDefs.h"
+#include "core/cell.h"
+#include "core/latticeStatistics.h"
+#include "latticeBoltzmann/nearestNeighborLattices3D.h"
+#include <algorithm>
+
+#if defined(__AVX__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace plb {
+
+namespace simd {
+
+/// Pack of Pack<T>::width values processed by one instruction. The generic
+///   version holds a single scalar, so that the kernels compile everywhere.
+template<typename T>
+struct Pack {
+    enum { width = 1 };
+    T v;
+    static Pack load(T const* p) { Pack r; r.v = *p; return r; }
+    static Pack set1(T x) { Pack r; r.v = x; return r; }
+    void store(T* p) const { *p = v; }
+};
+
+template<typename T>
+inline Pack<T> operator+(Pack<T> a, Pack<T> b) { a.v = a.v + b.v; return a; }
+template<typename T>
+inline Pack<T> operator-(Pack<T> a, Pack<T> b) { a.v = a.v - b.v; return a; }
+template<typename T>
+inline Pack<T> operator*(Pack<T> a, Pack<T> b) { a.v = a.v * b.v; return a; }
+
+#if defined(__AVX512F__)
+
+template<>
+struct Pack<double> {
+    enum { width = 8 };
+    __m512d v;
+    static Pack load(double const* p) { Pack r; r.v = _mm512_load_pd(p); return r; }
+    static Pack set1(double x) { Pack r; r.v = _mm512_set1_pd(x); return r; }
+    void store(double* p) const { _mm512_store_pd(p, v); }
+};
+
+inline Pack<double> operator+(Pack<double> a, Pack<double> b) { a.v = _mm512_add_pd(a.v, b.v); return a; }
+inline Pack<double> operator-(Pack<double> a, Pack<double> b) { a.v = _mm512_sub_pd(a.v, b.v); return a; }
+inline Pack<double> operator*(Pack<double> a, Pack<double> b) { a.v = _mm512_mul_pd(a.v, b.v); return a; }
+
+#elif defined(__AVX__)
+
+template<>
+struct Pack<double> {
+    enum { width = 4 };
+    __m256d v;
+    static Pack load(double const* p) { Pack r; r.v = _mm256_load_pd(p); return r; }
+    static Pack set1(double x) { Pack r; r.v = _mm256_set1_pd(x); return r; }
+    void store(double* p) const { _mm256_store_pd(p, v); }
+};
+
+inline Pack<double> operator+(Pack<double> a, Pack<double> b) { a.v = _mm256_add_pd(a.v, b.v); return a; }
+inline Pack<double> operator-(Pack<double> a, Pack<double> b) { a.v = _mm256_sub_pd(a.v, b.v); return a; }
+inline Pack<double> operator*(Pack<double> a, Pack<double> b) { a.v = _mm256_mul_pd(a.v, b.v); return a; }
+
+#endif
+
+}  // namespace simd
+
+/// Efficient specialization for D3Q19 lattice
+template<typename T>
+struct simdDynamicsTemplatesImpl<T, descriptors::D3Q19DescriptorBase<T> > {
+
+typedef descriptors::D3Q19DescriptorBase<T> D;
+typedef simd::Pack<T> P;
+enum { W = P::width };
+
+/// Same arithmetic as momentTemplates::compute_PiNeq followed by
+///   dynamicsTemplates::rlb_collision, written for a pack of cells stored in
+///   structure-of-arrays form. Results agree with the cell-by-cell version
+///   up to round-off (the compiler may contract the two paths differently).
+static void rlb_collision_pack( T (&f)[D::q][W], T const (&rhoBar)[W], T const (&invRho)[W],
+                                T const (&j)[D::d][W], T omega, T (&uSqr)[W] )
+{
+    P rb = P::load(rhoBar);
+    P ir = P::load(invRho);
+    P jx = P::load(j[0]);
+    P jy = P::load(j[1]);
+    P jz = P::load(j[2]);
+    P fp[D::q];
+    for (plint iPop=0; iPop<D::q; ++iPop) {
+        fp[iPop] = P::load(f[iPop]);
+    }
+
+    // Off-equilibrium stress, see momentTemplatesImpl<D3Q19>::compute_PiNeq.
+    P surfX_M1 = fp[1] + fp[4] + fp[5] + fp[6] + fp[7];
+    P surfX_P1 = fp[10] + fp[13] + fp[14] + fp[15] + fp[16];
+    P surfY_M1 = fp[2] + fp[4] + fp[8] + fp[9] + fp[14];
+    P surfY_P1 = fp[5] + fp[11] + fp[13] + fp[17] + fp[18];
+    P surfZ_M1 = fp[3] + fp[6] + fp[8] + fp[16] + fp[18];
+    P surfZ_P1 = fp[7] + fp[9] + fp[12] + fp[15] + fp[17];
+
+    P cs2 = P::set1(D::cs2);
+    P piXX = surfX_P1 + surfX_M1 - cs2*rb - ir*jx*jx;
+    P piYY = surfY_P1 + surfY_M1 - cs2*rb - ir*jy*jy;
+    P piZZ = surfZ_P1 + surfZ_M1 - cs2*rb - ir*jz*jz;
+    P piXY = fp[4] - fp[5] + fp[13] - fp[14] - ir*jx*jy;
+    P piXZ = fp[6] - fp[7] + fp[15] - fp[16] - ir*jx*jz;
+    P piYZ = fp[8] - fp[9] + fp[17] - fp[18] - ir*jy*jz;
+
+    // Projection onto the populations, see neqPiD3Q19.
+    P oneThird  = P::set1((T)1./(T)3);
+    P mOneThird = P::set1(-(T)1./(T)3);
+    P twoThirds = P::set1((T)2./(T)3);
+    P two       = P::set1((T)2);
+    P half3     = P::set1((T)3./(T)2);
+    P quarter   = P::set1((T)1./(T)4);
+    P eighth    = P::set1((T)1./(T)8);
+    P piNeq0 = half3 * (mOneThird*piXX - oneThird*piYY - oneThird*piZZ);
+    P piNeq1 = quarter * (twoThirds*piXX - oneThird*piYY - oneThird*piZZ);
+    P piNeq2 = quarter * (mOneThird*piXX + twoThirds*piYY - oneThird*piZZ);
+    P piNeq3 = quarter * (mOneThird*piXX - oneThird*piYY + twoThirds*piZZ);
+    P piNeq4 = eighth * (twoThirds*piXX + twoThirds*piYY - oneThird*piZZ + two*piXY);
+    P piNeq5 = eighth * (twoThirds*piXX + twoThirds*piYY - oneThird*piZZ - two*piXY);
+    P piNeq6 = eighth * (twoThirds*piXX - oneThird*piYY + twoThirds*piZZ + two*piXZ);
+    P piNeq7 = eighth * (twoThirds*piXX - oneThird*piYY + twoThirds*piZZ - two*piXZ);
+    P piNeq8 = eighth * (mOneThird*piXX + twoThirds*piYY + twoThirds*piZZ + two*piYZ);
+    P piNeq9 = eighth * (mOneThird*piXX + twoThirds*piYY + twoThirds*piZZ - two*piYZ);
+
+    // Second-order equilibrium plus relaxed off-equilibrium part. Populations
+    //   iPop and iPop+9 have opposite velocities, so they share c.j up to the
+    //   sign (cj below is the projection on the velocity of iPop+9).
+    P jSqr = jx*jx + jy*jy + jz*jz;
+    P three = P::set1((T)3);
+    P c45 = P::set1((T)4.5);
+    P c15 = P::set1((T)1.5);
+    P relax = P::set1((T)1-omega);
+    P c15jSqr = c15*jSqr;
+
+    P cj[10];
+    cj[1] = jx;
+    cj[2] = jy;
+    cj[3] = jz;
+    cj[4] = jx + jy;
+    cj[5] = jx - jy;
+    cj[6] = jx + jz;
+    cj[7] = jx - jz;
+    cj[8] = jy + jz;
+    cj[9] = jy - jz;
+    P piNeq[10] = { piNeq0, piNeq1, piNeq2, piNeq3, piNeq4,
+                    piNeq5, piNeq6, piNeq7, piNeq8, piNeq9 };
+
+    (P::set1(D::t[0]) * (rb - ir*c15jSqr) + relax*piNeq0).store(f[0]);
+    for (plint iPop=1; iPop<=9; ++iPop) {
+        P tPop = P::set1(D::t[iPop]);
+        P cjSqrTerm = ir*(c45*cj[iPop]*cj[iPop] - c15jSqr);
+        P threeCj = three*cj[iPop];
+        (tPop * (rb - threeCj + cjSqrTerm) + relax*piNeq[iPop]).store(f[iPop]);
+        (tPop * (rb + threeCj + cjSqrTerm) + relax*piNeq[iPop]).store(f[iPop+9]);
+    }
+
+    (jSqr*ir*ir).store(uSqr);
+}
+
+template<template<typename U> class Descriptor>
+static bool externalMomentRlbCollideRun( Cell<T,Descriptor>* cells, plint numCells,
+                                         T omega, BlockStatistics& statistics )
+{
+    alignas(64) T f[D::q][W];
+    alignas(64) T rhoBar[W];
+    alignas(64) T invRho[W];
+    alignas(64) T j[D::d][W];
+    alignas(64) T uSqr[W];
+
+    for (plint iStart=0; iStart<numCells; iStart+=W) {
+        plint numLanes = std::min((plint)W, numCells-iStart);
+        // Gather the pack. Unused lanes of the last pack are set to a fluid at
+        //   rest and never written back.
+        for (plint iLane=0; iLane<W; ++iLane) {
+            if (iLane<numLanes) {
+                Cell<T,Descriptor>& cell = cells[iStart+iLane];
+                T rho = *cell.getExternal(Descriptor<T>::ExternalField::densityBeginsAt);
+                T const* jExt = cell.getExternal(Descriptor<T>::ExternalField::momentumBeginsAt);
+                rhoBar[iLane] = Descriptor<T>::rhoBar(rho);
+                invRho[iLane] = Descriptor<T>::invRho(rhoBar[iLane]);
+                for (plint iD=0; iD<D::d; ++iD) {
+                    j[iD][iLane] = jExt[iD];
+                }
+                for (plint iPop=0; iPop<D::q; ++iPop) {
+                    f[iPop][iLane] = cell[iPop];
+                }
+            }
+            else {
+                rhoBar[iLane] = T();
+                invRho[iLane] = Descriptor<T>::invRho(T());
+                for (plint iD=0; iD<D::d; ++iD) {
+                    j[iD][iLane] = T();
+                }
+                for (plint iPop=0; iPop<D::q; ++iPop) {
+                    f[iPop][iLane] = T();
+                }
+            }
+        }
+
+        rlb_collision_pack(f, rhoBar, invRho, j, omega, uSqr);
+
+        // Scatter the pack, and gather statistics in the same order as the
+        //   cell-by-cell collision.
+        for (plint iLane=0; iLane<numLanes; ++iLane) {
+            Cell<T,Descriptor>& cell = cells[iStart+iLane];
+            for (plint iPop=0; iPop<D::q; ++iPop) {
+                cell[iPop] = f[iPop][iLane];
+            }
+            if (cell.takesStatistics()) {
+                gatherStatistics(statistics, rhoBar[iLane], uSqr[iLane]);
+            }
+        }
+    }
+    return true;
+}
+
+};  // struct simdDynamicsTemplatesImpl<D3Q19>
+
+}  // namespace plb
+
+#endif  // SIMD_DYNAMICS_TEMPLATES_3D_H
@@ -54,6 +54,13 @@ struct BlockCommunicator3D {
      *  is being transmitted.
      **/
     virtual void duplicateOverlaps(MultiBlock3D& multiBlock, modif::ModifT whichData) const =0;
+    /// Fill the overlaps of a group of multi-blocks which share the same distribution.
+    /** All multi-blocks must have the management and periodicity of the first one, and
+     *  whichData specifies the type of content for each of them. The data of all
+     *  multi-blocks can then be transmitted in a single message per pair of processes.
+     **/
+    virtual void duplicateOverlaps( std::vector<MultiBlock3D*> const& multiBlocks,
+                                    std::vector<modif::ModifT> const& whichData ) const =0;
     /// Transmit data between two multi-blocks, according to a user-defined pattern.
     /** The variable whichData specifies which type of content (static/dynamic/full dynamics object)
      *  is being transmitted.
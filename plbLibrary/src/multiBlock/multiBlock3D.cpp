@@ -293,7 +293,8 @@ MultiBlock3D::MultiBlock3D(MultiBlock3D const& rhs)
       statSubscriber(*this),
       statisticsOn(rhs.statisticsOn),
       periodicitySwitch(*this, rhs.periodicitySwitch),
-      internalModifT(rhs.internalModifT)
+      internalModifT(rhs.internalModifT),
+      frozenBlocks(rhs.frozenBlocks)
 {
     id = multiBlockRegistration3D().announce(*this);
 }
@@ -325,6 +326,7 @@ void MultiBlock3D::swap(MultiBlock3D& rhs) {
     std::swap(statisticsOn, rhs.statisticsOn);
     std::swap(periodicitySwitch, rhs.periodicitySwitch);
     std::swap(internalModifT, rhs.internalModifT);
+    frozenBlocks.swap(rhs.frozenBlocks);
 }
 
 MultiBlock3D::~MultiBlock3D() {
@@ -393,6 +395,10 @@ BlockCommunicator3D const& MultiBlock3D::getBlockCommunicator() const {
     return *blockCommunicator;
 }
 
+plint MultiBlock3D::sizeOfCellContent(modif::ModifT whichData) const {
+    return sizeOfCell();
+}
+
 void MultiBlock3D::duplicateOverlaps(modif::ModifT whichData) {
     this->getBlockCommunicator().duplicateOverlaps(*this, whichData);
 }
@@ -430,6 +436,8 @@ void MultiBlock3D::evaluateStatistics() {
     std::vector<plint> const& blocks = getLocalInfo().getBlocks();
     for (pluint iBlock=0; iBlock<blocks.size(); ++iBlock) {
         plint blockId = blocks[iBlock];
+        // Frozen blocks keep the statistics of their last active iteration.
+        if (isFrozen(blockId)) continue;
         getComponent(blockId).evaluateStatistics();
     }
     if (isInternalStatisticsOn()) reduceStatistics();
@@ -494,18 +502,61 @@ void MultiBlock3D::setDataTransfer(BlockDataTransfer3D* newDataTransfer) {
     delete newDataTransfer;
 }
 
+void MultiBlock3D::freezeBlock(plint blockId) {
+    std::vector<plint> const& blocks = getLocalInfo().getBlocks();
+    if (std::find(blocks.begin(), blocks.end(), blockId) != blocks.end()) {
+        frozenBlocks.insert(blockId);
+    }
+}
+
+void MultiBlock3D::unfreezeBlock(plint blockId) {
+    frozenBlocks.erase(blockId);
+}
+
+void MultiBlock3D::unfreezeAllBlocks() {
+    frozenBlocks.clear();
+}
+
+bool MultiBlock3D::isFrozen(plint blockId) const {
+    return frozenBlocks.find(blockId) != frozenBlocks.end();
+}
+
+plint MultiBlock3D::getNumFrozenBlocks() const {
+    return (plint) frozenBlocks.size();
+}
+
 
 void MultiBlock3D::executeInternalProcessors() {
+    std::vector<BlockAndModif> modifiedBlocks;
+    executeFirstProcessorLevel(modifiedBlocks);
+    global::profiler().start("envelope-update");
+    duplicateOverlapsInModifiedMultiBlocks(modifiedBlocks);
+    global::profiler().stop("envelope-update");
+    executeRemainingProcessorLevels();
+}
+
+void MultiBlock3D::executeFirstProcessorLevel(std::vector<BlockAndModif>& modifiedBlocks) {
     global::profiler().start("dataProcessor");
-    // Execute all automatic internal processors.
-    for (plint iLevel=0; iLevel<=maxProcessorLevel; ++iLevel) {
-        executeInternalProcessors(iLevel);
+    if (maxProcessorLevel>=0) {
+        executeInternalProcessors(0, false);
+        if (!multiBlocksChangedByAutomaticProcessors.empty()) {
+            std::vector<BlockAndModif> const& levelBlocks =
+                multiBlocksChangedByAutomaticProcessors[0];
+            for (pluint iNew=0; iNew<levelBlocks.size(); ++iNew) {
+                mergeModifiedBlock(modifiedBlocks, levelBlocks[iNew]);
+            }
+        }
     }
-    // Duplicate boundaries at least once in case there is no automatic processor.
-    if (maxProcessorLevel==-1) {
-        global::profiler().start("envelope-update");
-        this->duplicateOverlaps(internalModifT);
-        global::profiler().stop("envelope-update");
+    // Overlaps are expected to be duplicated in any case after level 0,
+    //   with a type of modification equal to internalModifT or stronger.
+    mergeModifiedBlock(modifiedBlocks, BlockAndModif(this, internalModifT));
+    global::profiler().stop("dataProcessor");
+}
+
+void MultiBlock3D::executeRemainingProcessorLevels() {
+    global::profiler().start("dataProcessor");
+    for (plint iLevel=1; iLevel<=maxProcessorLevel; ++iLevel) {
+        executeInternalProcessors(iLevel);
     }
     global::profiler().stop("dataProcessor");
 }
@@ -517,6 +568,7 @@ void MultiBlock3D::executeInternalProcessors(plint level, bool communicate) {
     std::vector<plint> const& blocks = getLocalInfo().getBlocks();
     for (pluint iBlock=0; iBlock<blocks.size(); ++iBlock) {
         plint blockId = blocks[iBlock];
+        if (isFrozen(blockId)) continue;
         getComponent(blockId).executeInternalProcessors(level);
     }
     if (level < 0) {
@@ -551,6 +603,19 @@ void MultiBlock3D::subscribeProcessor (
     }
 }
 
+void MultiBlock3D::mergeModifiedBlock (
+        std::vector<BlockAndModif>& modifiedBlocks, BlockAndModif const& newBlock )
+{
+    for (pluint iBlock=0; iBlock<modifiedBlocks.size(); ++iBlock) {
+        if (modifiedBlocks[iBlock].first == newBlock.first) {
+            modifiedBlocks[iBlock].second =
+                combine(modifiedBlocks[iBlock].second, newBlock.second);
+            return;
+        }
+    }
+    modifiedBlocks.push_back(newBlock);
+}
+
 void MultiBlock3D::storeProcessor (
         DataProcessorGenerator3D const& generator,
         std::vector<MultiBlock3D*> multiBlocks, plint level)
@@ -629,36 +694,72 @@ void MultiBlock3D::duplicateOverlapsInModifiedMultiBlocks(plint level) {
 void MultiBlock3D::duplicateOverlapsInModifiedMultiBlocks (
         std::vector<BlockAndModif>& multiBlocks )
 {
+    std::vector<MultiBlock3D*> blocks(multiBlocks.size());
+    std::vector<modif::ModifT> whichData(multiBlocks.size());
     for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
-        multiBlocks[iBlock].first->duplicateOverlaps (
-                multiBlocks[iBlock].second );
+        blocks[iBlock] = multiBlocks[iBlock].first;
+        whichData[iBlock] = multiBlocks[iBlock].second;
     }
+    plb::duplicateOverlaps(blocks, whichData);
 }
 
 
 void MultiBlock3D::duplicateOverlapsAtLevelZero (
         std::vector<BlockAndModif>& multiBlocks )
 {
-    bool treatedThis = false;
-    for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
-        MultiBlock3D* modifiedBlock = multiBlocks[iBlock].first;
-        modif::ModifT modificationType = multiBlocks[iBlock].second;
-        if (modifiedBlock==this) {
-            treatedThis = true;
-            // If it's the current multi-block we are treating, make sure
-            //   type of modification is equal to internalModifT or stronger.
-            this->duplicateOverlaps(combine(modificationType, internalModifT));
+    // Overlaps are expected to be duplicated in any case at level 0. If the
+    //   current multi-block is modified, make sure the type of modification is
+    //   equal to internalModifT or stronger.
+    std::vector<BlockAndModif> levelZeroBlocks(multiBlocks);
+    mergeModifiedBlock(levelZeroBlocks, BlockAndModif(this, internalModifT));
+    duplicateOverlapsInModifiedMultiBlocks(levelZeroBlocks);
+}
+
+bool haveSameDistribution(MultiBlock3D const& block1, MultiBlock3D const& block2) {
+    MultiBlockManagement3D const& management1 = block1.getMultiBlockManagement();
+    MultiBlockManagement3D const& management2 = block2.getMultiBlockManagement();
+    if ( management1.getEnvelopeWidth() != management2.getEnvelopeWidth() ||
+         !management1.equivalentTo(management2) )
+    {
+        return false;
+    }
+    for (plint iDim=0; iDim<3; ++iDim) {
+        if (block1.periodicity().get(iDim) != block2.periodicity().get(iDim)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void duplicateOverlaps (
+        std::vector<MultiBlock3D*> const& multiBlocks,
+        std::vector<modif::ModifT> const& whichData )
+{
+    PLB_PRECONDITION( multiBlocks.size() == whichData.size() );
+    // Partition the multi-blocks into groups with the same distribution. Each group is
+    //   handled by the communicator of its first member. The order of the multi-blocks
+    //   is preserved, so that all processes obtain the same communication pattern.
+    std::vector<bool> treated(multiBlocks.size(), false);
+    for (pluint iLeader=0; iLeader<multiBlocks.size(); ++iLeader) {
+        if (treated[iLeader]) continue;
+        std::vector<MultiBlock3D*> group;
+        std::vector<modif::ModifT> groupData;
+        for (pluint iBlock=iLeader; iBlock<multiBlocks.size(); ++iBlock) {
+            if ( !treated[iBlock] &&
+                 haveSameDistribution(*multiBlocks[iLeader], *multiBlocks[iBlock]) )
+            {
+                group.push_back(multiBlocks[iBlock]);
+                groupData.push_back(whichData[iBlock]);
+                treated[iBlock] = true;
+            }
+        }
+        if (group.size()==1) {
+            group[0]->duplicateOverlaps(groupData[0]);
         }
         else {
-            modifiedBlock->duplicateOverlaps(modificationType);
+            group[0]->getBlockCommunicator().duplicateOverlaps(group, groupData);
         }
     }
-    // If current multi-block has not already been treated, duplicate
-    //   overlaps explicitly (because overlaps are expected to be duplicated
-    //   in any case at level 0).
-    if (!treatedThis) {
-        this->duplicateOverlaps(internalModifT);
-    }
 }
 
 /* *************** Class MultiBlockRegistration3D ******************************** */
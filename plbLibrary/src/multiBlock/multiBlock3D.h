@@ -50,6 +50,7 @@
 #include <utility>
 #include <string>
 #include <vector>
+#include <set>
 
 namespace plb {
 
@@ -150,6 +151,15 @@ public:
     void executeInternalProcessors();
     /// Execute all internal dataProcessors at a given level.
     void executeInternalProcessors(plint level, bool communicate=true);
+    /// Execute the level-0 internal dataProcessors without updating the
+    ///   envelopes, and merge the multi-blocks to be updated into modifiedBlocks.
+    /** The current multi-block is always part of the update. Together with
+     *  executeRemainingProcessorLevels(), this allows several multi-blocks to
+     *  share a single envelope update after the collision-streaming step.
+     */
+    void executeFirstProcessorLevel(std::vector<BlockAndModif>& modifiedBlocks);
+    /// Execute all levels of internal dataProcessors after level 0.
+    void executeRemainingProcessorLevels();
     /// After adding an internal processor to the atomic-blocks, subscribe it
     /// in the multi-block to guarantee it will be executed.
     void subscribeProcessor(plint level,
@@ -187,10 +197,28 @@ public:
     void setRefinementLevel(plint newLevel);
     /// Assign a data transfer policy to all atomic-blocks.
     void setDataTransfer(BlockDataTransfer3D* newDataTransfer);
+    /// Exclude a local atomic-block from collision-streaming, internal data
+    ///   processors and statistics evaluation.
+    /** The envelope of a frozen block is still updated by communication, and
+     *  its last statistics are kept in the reduction. Freezing a block id that
+     *  is not local has no effect.
+     */
+    void freezeBlock(plint blockId);
+    /// Include a frozen atomic-block again in the time iterations.
+    void unfreezeBlock(plint blockId);
+    /// Include all frozen atomic-blocks again in the time iterations.
+    void unfreezeAllBlocks();
+    bool isFrozen(plint blockId) const;
+    plint getNumFrozenBlocks() const;
 public:
     virtual AtomicBlock3D& getComponent(plint blockId) =0;
     virtual AtomicBlock3D const& getComponent(plint blockId) const =0;
     virtual plint sizeOfCell() const =0;
+    /// Size in bytes of the cell content transmitted for a given type of modification.
+    /** Only meaningful for types of modification with a static size. Defaults to
+     *  sizeOfCell(), as most blocks transmit their full cell content in any case.
+     */
+    virtual plint sizeOfCellContent(modif::ModifT whichData) const;
     virtual plint getCellDim() const =0;
 private:
     void addModifiedBlocks(plint level,
@@ -201,6 +229,8 @@ private:
     void duplicateOverlapsInModifiedMultiBlocks(plint level);
     void duplicateOverlapsInModifiedMultiBlocks(std::vector<BlockAndModif>& multiBlocks);
     void duplicateOverlapsAtLevelZero(std::vector<BlockAndModif>& multiBlocks);
+    static void mergeModifiedBlock(std::vector<BlockAndModif>& modifiedBlocks,
+                                   BlockAndModif const& newBlock);
     void reduceStatistics();
 public:
     BlockCommunicator3D const& getBlockCommunicator() const;
@@ -239,6 +269,8 @@ private:
     bool statisticsOn;
     PeriodicitySwitch3D periodicitySwitch;
     modif::ModifT internalModifT;
+    /// Local atomic-blocks which are excluded from the time iterations.
+    std::set<plint> frozenBlocks;
     id_t id;
 };
 
@@ -259,6 +291,16 @@ friend MultiBlockRegistration3D& multiBlockRegistration3D();
 
 MultiBlockRegistration3D& multiBlockRegistration3D();
 
+/// Tell if two multi-blocks have the same block distribution, envelope and periodicity.
+bool haveSameDistribution(MultiBlock3D const& block1, MultiBlock3D const& block2);
+
+/// Update the envelopes of several multi-blocks.
+/** Multi-blocks with the same distribution form a communication group, and
+ *  their data is exchanged in a single message per pair of processes.
+ */
+void duplicateOverlaps( std::vector<MultiBlock3D*> const& multiBlocks,
+                        std::vector<modif::ModifT> const& whichData );
+
 } // namespace plb
 
 #endif  // MULTI_BLOCK_3D_H
@@ -123,6 +123,7 @@ public:
     virtual BlockLattice3D<T,Descriptor>& getComponent(plint blockId);
     virtual BlockLattice3D<T,Descriptor> const& getComponent(plint blockId) const;
     virtual plint sizeOfCell() const;
+    virtual plint sizeOfCellContent(modif::ModifT whichData) const;
     virtual plint getCellDim() const;
     virtual int getStaticId() const;
     virtual void copyReceive (
@@ -163,6 +164,18 @@ double getStoredAverageEnergy(MultiBlockLattice3D<T,Descriptor> const& blockLatt
 template<typename T, template<typename U> class Descriptor>
 double getStoredMaxVelocity(MultiBlockLattice3D<T,Descriptor> const& blockLattice);
 
+/// Execute a collide-and-stream cycle on lattices which share the same distribution.
+/** This is meant for coupled lattices, such as the species of a multi-component
+ *  fluid. All lattices are first collided and streamed, and their first stage of
+ *  internal processors is executed. The envelopes of all of them are then updated
+ *  together, with one message per pair of processes, before the remaining stages
+ *  are executed lattice by lattice. The result is the same as calling
+ *  collideAndStream() on each lattice in turn, provided the processors of one
+ *  lattice don't act on the collision of a lattice listed after it.
+ */
+template<typename T, template<typename U> class Descriptor>
+void collideAndStream(std::vector<MultiBlockLattice3D<T,Descriptor>*> const& lattices);
+
 }  // namespace plb
 
 #endif  // MULTI_BLOCK_LATTICE_3D_H
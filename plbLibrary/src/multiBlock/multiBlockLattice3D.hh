@@ -371,6 +371,7 @@ void MultiBlockLattice3D<T,Descriptor>::collideAndStreamImplementation() {
               it != blockLattices.end(); ++it )
         {
             plint blockId = it->first;
+            if (this->isFrozen(blockId)) continue;
             int handle = threadAttribution.getCoProcessorHandle(blockId);
             if (handle>=0) {
                  global::defaultCoProcessor3D<T>().collideAndStream(handle);
@@ -389,6 +390,7 @@ void MultiBlockLattice3D<T,Descriptor>::collideAndStreamImplementation() {
         for ( typename BlockMap::iterator it = blockLattices.begin();
               it != blockLattices.end(); ++it)
         {
+            if (this->isFrozen(it->first)) continue;
             SmartBulk3D bulk(this->getMultiBlockManagement(), it->first);
             // CollideAndStream must be applied to full domain,
             //   including currently active envelopes.
@@ -536,6 +538,14 @@ plint MultiBlockLattice3D<T,Descriptor>::sizeOfCell() const {
             Descriptor<T>::numPop + Descriptor<T>::ExternalField::numScalars );
 }
 
+template<typename T, template<typename U> class Descriptor>
+plint MultiBlockLattice3D<T,Descriptor>::sizeOfCellContent(modif::ModifT whichData) const {
+    if (modif::isStaticPart(whichData)) {
+        return BlockLatticeDataTransfer3D<T,Descriptor>::staticPartSize(whichData);
+    }
+    return sizeOfCell();
+}
+
 template<typename T, template<typename U> class Descriptor>
 plint MultiBlockLattice3D<T,Descriptor>::getCellDim() const {
     return Descriptor<T>::numPop + Descriptor<T>::ExternalField::numScalars;
@@ -587,6 +597,30 @@ double getStoredMaxVelocity(MultiBlockLattice3D<T,Descriptor> const& blockLattic
                              LatticeStatistics::maxUSqr ) );
 }
 
+template<typename T, template<typename U> class Descriptor>
+void collideAndStream(std::vector<MultiBlockLattice3D<T,Descriptor>*> const& lattices)
+{
+    std::vector<MultiBlock3D::BlockAndModif> modifiedBlocks;
+    for (pluint iLattice=0; iLattice<lattices.size(); ++iLattice) {
+        lattices[iLattice]->externalCollideAndStream();
+        lattices[iLattice]->executeFirstProcessorLevel(modifiedBlocks);
+    }
+    std::vector<MultiBlock3D*> blocks(modifiedBlocks.size());
+    std::vector<modif::ModifT> whichData(modifiedBlocks.size());
+    for (pluint iBlock=0; iBlock<modifiedBlocks.size(); ++iBlock) {
+        blocks[iBlock] = modifiedBlocks[iBlock].first;
+        whichData[iBlock] = modifiedBlocks[iBlock].second;
+    }
+    global::profiler().start("envelope-update");
+    duplicateOverlaps(blocks, whichData);
+    global::profiler().stop("envelope-update");
+    for (pluint iLattice=0; iLattice<lattices.size(); ++iLattice) {
+        lattices[iLattice]->executeRemainingProcessorLevels();
+        lattices[iLattice]->evaluateStatistics();
+        lattices[iLattice]->incrementTime();
+    }
+}
+
 }  // namespace plb
 
 #endif  // MULTI_BLOCK_LATTICE_3D_HH
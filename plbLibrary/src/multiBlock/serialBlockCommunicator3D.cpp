@@ -103,6 +103,17 @@ void SerialBlockCommunicator3D::duplicateOverlaps(MultiBlock3D& multiBlock, modi
     }
 }
 
+void SerialBlockCommunicator3D::duplicateOverlaps (
+        std::vector<MultiBlock3D*> const& multiBlocks,
+        std::vector<modif::ModifT> const& whichData ) const
+{
+    PLB_PRECONDITION( multiBlocks.size() == whichData.size() );
+    // Without messages, there is nothing to be gained by grouping.
+    for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
+        duplicateOverlaps(*multiBlocks[iBlock], whichData[iBlock]);
+    }
+}
+
 void SerialBlockCommunicator3D::communicate (
         std::vector<Overlap3D> const& overlaps,
         MultiBlock3D const& originMultiBlock, MultiBlock3D& destinationMultiBlock,
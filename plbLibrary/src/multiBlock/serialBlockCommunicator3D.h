@@ -53,6 +53,8 @@ public:
                               MultiBlock3D const& originMultiBlock,
                               MultiBlock3D& destinationMultiBlock, modif::ModifT whichData ) const;
     virtual void duplicateOverlaps(MultiBlock3D& multiBlock, modif::ModifT whichData) const;
+    virtual void duplicateOverlaps( std::vector<MultiBlock3D*> const& multiBlocks,
+                                    std::vector<modif::ModifT> const& whichData ) const;
     virtual void signalPeriodicity() const;
 private:
     void copyOverlap( Overlap3D const& overlap,
@@ -0,0 +1,409 @@
+/* This file is part of the Palabos library.
+ *
+ * The Palabos softare is developed since 2011 by FlowKit-Numeca Group Sarl
+ * (Switzerland) and the University of Geneva (Switzerland), which jointly
+ * own the IP rights for most of the code base. Since October 2019, the
+ * Palabos project is maintained by the University of Geneva and accepts
+ * source code contributions from the community.
+ * 
+ * Contact:
+ * Jonas Latt
+ * Computer Science Department
+ * University of Geneva
+ * 7 Route de Drize
+ * 1227 Carouge, Switzerland
+ * jonas.latt@unige.ch
+ *
+ * The most recent release of Palabos can be downloaded at 
+ * <https://palabos.unige.ch/>
+ *
+ * The library Palabos is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * The library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "multiPhysics/clusterMatch3D.h"
+#include "parallelism/mpiManager.h"
+#include "atomicBlock/atomicContainerBlock3D.h"
+#include "atomicBlock/dataProcessingFunctional3D.h"
+#include "atomicBlock/dataProcessingFunctional3D.hh"
+#include "multiBlock/multiDataProcessorWrapper3D.h"
+#include "multiBlock/multiDataProcessorWrapper3D.hh"
+#include "atomicBlock/dataField3D.h"
+#include "atomicBlock/dataField3D.hh"
+#include "multiBlock/multiDataField3D.h"
+#include "multiBlock/multiDataField3D.hh"
+#include "multiBlock/multiBlockGenerator3D.h"
+#include "multiBlock/multiBlockGenerator3D.hh"
+#include "multiBlock/nonLocalTransfer3D.h"
+#include "multiBlock/nonLocalTransfer3D.hh"
+#include "multiBlock/serialMultiDataField3D.h"
+#include "multiBlock/serialMultiDataField3D.hh"
+#include "parallelism/parallelMultiDataField3D.h"
+#include "parallelism/parallelMultiDataField3D.hh"
+#include <algorithm>
+#include <set>
+
+
+namespace plb {
+
+namespace {
+
+// Root of a union-find tree, with path halving.
+plint findClusterRoot(std::vector<plint>& parent, plint i) {
+    while (parent[i]!=i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// The smaller index becomes the root, so that the result does not depend on the
+// order in which the links are processed.
+void mergeClusterRoots(std::vector<plint>& parent, plint i, plint j) {
+    plint rootI = findClusterRoot(parent, i);
+    plint rootJ = findClusterRoot(parent, j);
+    if (rootI<rootJ) {
+        parent[rootJ] = rootI;
+    }
+    else if (rootJ<rootI) {
+        parent[rootI] = rootJ;
+    }
+}
+
+ClusterData3D& getClusterData(AtomicBlock3D* block) {
+    AtomicContainerBlock3D* pDataBlock = dynamic_cast<AtomicContainerBlock3D*> (block);
+    PLB_ASSERT(pDataBlock);
+    ClusterData3D* pData = dynamic_cast<ClusterData3D*>(pDataBlock->getData());
+    PLB_ASSERT(pData);
+    return *pData;
+}
+
+}  // namespace
+
+
+/* ************** class ClusterMatch3D ********************************** */
+
+ClusterMatch3D::ClusterMatch3D(MultiBlock3D& templ)
+    : clusterContainer (createContainerBlock(templ, new ClusterData3D())),
+      mpiData(*clusterContainer),
+      tagMatrix (new MultiScalarField3D<plint>(*clusterContainer))
+{ }
+
+ClusterMatch3D::~ClusterMatch3D() {
+    delete clusterContainer;
+    delete tagMatrix;
+}
+
+void ClusterMatch3D::execute(MultiScalarField3D<int>& flag, int phaseFlag, Box3D inlet, Box3D outlet)
+{
+    for (plint iDim=0; iDim<3; ++iDim) {
+        tagMatrix->periodicity().toggle(iDim, flag.periodicity().get(iDim));
+    }
+    Box3D domain = tagMatrix->getBoundingBox();
+
+    std::vector<MultiBlock3D*> labelArgs;
+    labelArgs.push_back(tagMatrix);
+    labelArgs.push_back(&flag);
+    labelArgs.push_back(clusterContainer);
+    applyProcessingFunctional (
+            new LabelLocalClusters3D(phaseFlag, flag.getBoundingBox(), inlet, outlet), domain, labelArgs );
+
+    std::vector<MultiBlock3D*> args;
+    args.push_back(tagMatrix);
+    args.push_back(clusterContainer);
+    applyProcessingFunctional(new LinkClusters3D(), domain, args);
+    mergeClusters();
+    applyProcessingFunctional(new ApplyClusterRemap3D(), domain, args);
+}
+
+void ClusterMatch3D::mergeClusters()
+{
+    std::vector<plint> localIds = mpiData.getLocalIds();
+    std::vector<plint> labels, contacts, links;
+    std::vector<double> volumes;
+    for (pluint i=0; i<localIds.size(); ++i) {
+        ClusterData3D& data = getClusterData(&clusterContainer->getComponent(localIds[i]));
+        labels.insert(labels.end(), data.labels.begin(), data.labels.end());
+        volumes.insert(volumes.end(), data.volumes.begin(), data.volumes.end());
+        contacts.insert(contacts.end(), data.contacts.begin(), data.contacts.end());
+        links.insert(links.end(), data.links.begin(), data.links.end());
+    }
+
+    // Every processor receives the local clusters and links of all processors.
+    plint numProc = global::mpi().getSize();
+    plint rank = global::mpi().getRank();
+    std::vector<plint> numLabels(numProc, 0), numLinks(numProc, 0);
+    numLabels[rank] = labels.size();
+    numLinks[rank] = links.size();
+#ifdef PLB_MPI_PARALLEL
+    global::mpi().allReduceVect(numLabels, MPI_SUM);
+    global::mpi().allReduceVect(numLinks, MPI_SUM);
+#endif
+    plint labelOffset = 0, linkOffset = 0, totLabels = 0, totLinks = 0;
+    for (plint iProc=0; iProc<numProc; ++iProc) {
+        if (iProc<rank) {
+            labelOffset += numLabels[iProc];
+            linkOffset += numLinks[iProc];
+        }
+        totLabels += numLabels[iProc];
+        totLinks += numLinks[iProc];
+    }
+    std::vector<plint> allLabels(totLabels, 0), allContacts(totLabels, 0), allLinks(totLinks, 0);
+    std::vector<double> allVolumes(totLabels, 0.);
+    std::copy(labels.begin(), labels.end(), allLabels.begin()+labelOffset);
+    std::copy(contacts.begin(), contacts.end(), allContacts.begin()+labelOffset);
+    std::copy(volumes.begin(), volumes.end(), allVolumes.begin()+labelOffset);
+    std::copy(links.begin(), links.end(), allLinks.begin()+linkOffset);
+#ifdef PLB_MPI_PARALLEL
+    global::mpi().allReduceVect(allLabels, MPI_SUM);
+    global::mpi().allReduceVect(allContacts, MPI_SUM);
+    global::mpi().allReduceVect(allVolumes, MPI_SUM);
+    global::mpi().allReduceVect(allLinks, MPI_SUM);
+#endif
+
+    // Union-find on the positions of the labels in allLabels.
+    std::map<plint,plint> position;
+    for (plint i=0; i<totLabels; ++i) {
+        position[allLabels[i]] = i;
+    }
+    std::vector<plint> parent(totLabels);
+    for (plint i=0; i<totLabels; ++i) {
+        parent[i] = i;
+    }
+    for (plint i=0; i+1<totLinks; i+=2) {
+        std::map<plint,plint>::const_iterator it1 = position.find(allLinks[i]);
+        std::map<plint,plint>::const_iterator it2 = position.find(allLinks[i+1]);
+        PLB_ASSERT(it1!=position.end() && it2!=position.end());
+        mergeClusterRoots(parent, it1->second, it2->second);
+    }
+
+    // Clusters are numbered in the order of their smallest label.
+    std::map<plint,plint> tagRemap;
+    std::vector<plint> clusterId(totLabels, -1);
+    clusterVolume.clear();
+    touchesInlet.clear();
+    touchesOutlet.clear();
+    std::map<plint,plint>::const_iterator it = position.begin();
+    for (; it!=position.end(); ++it) {
+        plint root = findClusterRoot(parent, it->second);
+        if (clusterId[root]==-1) {
+            clusterId[root] = clusterVolume.size();
+            clusterVolume.push_back(0.);
+            touchesInlet.push_back(false);
+            touchesOutlet.push_back(false);
+        }
+        plint id = clusterId[root];
+        clusterVolume[id] += allVolumes[it->second];
+        touchesInlet[id] = touchesInlet[id] || (allContacts[it->second] & 1);
+        touchesOutlet[id] = touchesOutlet[id] || (allContacts[it->second] & 2);
+        tagRemap[it->first] = id;
+    }
+
+    for (pluint i=0; i<localIds.size(); ++i) {
+        ClusterData3D& data = getClusterData(&clusterContainer->getComponent(localIds[i]));
+        data.tagRemap.clear();
+        for (pluint iLabel=0; iLabel<data.labels.size(); ++iLabel) {
+            data.tagRemap[data.labels[iLabel]] = tagRemap[data.labels[iLabel]];
+        }
+    }
+}
+
+
+/* *************** Class LabelLocalClusters3D ******************************** */
+
+LabelLocalClusters3D::LabelLocalClusters3D(int phaseFlag_, Box3D globalDomain_, Box3D inlet_, Box3D outlet_)
+    : phaseFlag(phaseFlag_),
+      globalDomain(globalDomain_),
+      inlet(inlet_),
+      outlet(outlet_)
+{ }
+
+LabelLocalClusters3D* LabelLocalClusters3D::clone() const {
+    return new LabelLocalClusters3D(*this);
+}
+
+void LabelLocalClusters3D::processGenericBlocks(Box3D domain,std::vector<AtomicBlock3D*> atomicBlocks)
+{
+    PLB_ASSERT(atomicBlocks.size()==3);
+    ScalarField3D<plint>* pTagMatrix = dynamic_cast<ScalarField3D<plint>*> (atomicBlocks[0]);
+    PLB_ASSERT(pTagMatrix);
+    ScalarField3D<plint>& tagMatrix = *pTagMatrix;
+
+    ScalarField3D<int>* pFlagMatrix = dynamic_cast<ScalarField3D<int>*> (atomicBlocks[1]);
+    PLB_ASSERT(pFlagMatrix);
+    ScalarField3D<int>& flagMatrix = *pFlagMatrix;
+
+    ClusterData3D& data = getClusterData(atomicBlocks[2]);
+    data.labels.clear();
+    data.volumes.clear();
+    data.contacts.clear();
+    data.links.clear();
+
+    Dot3D flagOffset = computeRelativeDisplacement(tagMatrix, flagMatrix);
+    Dot3D absOfs = tagMatrix.getLocation();
+
+    // Bulk and envelope start untagged.
+    for (plint iX=0; iX<tagMatrix.getNx(); ++iX) {
+        for (plint iY=0; iY<tagMatrix.getNy(); ++iY) {
+            for (plint iZ=0; iZ<tagMatrix.getNz(); ++iZ) {
+                tagMatrix.get(iX,iY,iZ) = -1;
+            }
+        }
+    }
+
+    plint ny = domain.getNy();
+    plint nz = domain.getNz();
+    std::vector<plint> parent(domain.nCells(), -1);
+    for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
+        for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
+            for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
+                if (flagMatrix.get(iX+flagOffset.x, iY+flagOffset.y, iZ+flagOffset.z)!=phaseFlag) {
+                    continue;
+                }
+                plint i = ((iX-domain.x0)*ny + (iY-domain.y0))*nz + (iZ-domain.z0);
+                parent[i] = i;
+                if (iX>domain.x0 && parent[i-ny*nz]!=-1) {
+                    mergeClusterRoots(parent, i, i-ny*nz);
+                }
+                if (iY>domain.y0 && parent[i-nz]!=-1) {
+                    mergeClusterRoots(parent, i, i-nz);
+                }
+                if (iZ>domain.z0 && parent[i-1]!=-1) {
+                    mergeClusterRoots(parent, i, i-1);
+                }
+            }
+        }
+    }
+
+    // The label of a cluster is the global linear index of its root cell.
+    plint globalNy = globalDomain.getNy();
+    plint globalNz = globalDomain.getNz();
+    std::map<plint,plint> clusterOfRoot;
+    for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
+        for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
+            for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
+                plint i = ((iX-domain.x0)*ny + (iY-domain.y0))*nz + (iZ-domain.z0);
+                if (parent[i]==-1) {
+                    continue;
+                }
+                plint root = findClusterRoot(parent, i);
+                std::map<plint,plint>::iterator it = clusterOfRoot.find(root);
+                if (it==clusterOfRoot.end()) {
+                    plint rootX = domain.x0 + root/(ny*nz) + absOfs.x;
+                    plint rootY = domain.y0 + (root/nz)%ny + absOfs.y;
+                    plint rootZ = domain.z0 + root%nz + absOfs.z;
+                    plint label = ( (rootX-globalDomain.x0)*globalNy + (rootY-globalDomain.y0) )*globalNz
+                                  + (rootZ-globalDomain.z0);
+                    it = clusterOfRoot.insert(std::pair<plint,plint>(root, data.labels.size())).first;
+                    data.labels.push_back(label);
+                    data.volumes.push_back(0.);
+                    data.contacts.push_back(0);
+                }
+                plint cluster = it->second;
+                Dot3D absPos(iX+absOfs.x, iY+absOfs.y, iZ+absOfs.z);
+                tagMatrix.get(iX,iY,iZ) = data.labels[cluster];
+                data.volumes[cluster] += 1.;
+                if (contained(absPos, inlet)) {
+                    data.contacts[cluster] |= 1;
+                }
+                if (contained(absPos, outlet)) {
+                    data.contacts[cluster] |= 2;
+                }
+            }
+        }
+    }
+}
+
+
+/* *************** Class LinkClusters3D ******************************** */
+
+LinkClusters3D* LinkClusters3D::clone() const {
+    return new LinkClusters3D(*this);
+}
+
+void LinkClusters3D::processGenericBlocks(Box3D domain,std::vector<AtomicBlock3D*> atomicBlocks)
+{
+    PLB_ASSERT(atomicBlocks.size()==2);
+    ScalarField3D<plint>* pTagMatrix = dynamic_cast<ScalarField3D<plint>*> (atomicBlocks[0]);
+    PLB_ASSERT(pTagMatrix);
+    ScalarField3D<plint>& tagMatrix = *pTagMatrix;
+    ClusterData3D& data = getClusterData(atomicBlocks[1]);
+
+    // Only the six faces of the bulk have neighbors in the envelope.
+    std::set<std::pair<plint,plint> > links;
+    for (plint iDim=0; iDim<3; ++iDim) {
+        for (plint iSide=-1; iSide<=1; iSide+=2) {
+            Box3D face(domain);
+            Dot3D ofs(0,0,0);
+            if (iDim==0) {
+                face.x0 = face.x1 = iSide<0 ? domain.x0 : domain.x1;
+                ofs.x = iSide;
+            }
+            else if (iDim==1) {
+                face.y0 = face.y1 = iSide<0 ? domain.y0 : domain.y1;
+                ofs.y = iSide;
+            }
+            else {
+                face.z0 = face.z1 = iSide<0 ? domain.z0 : domain.z1;
+                ofs.z = iSide;
+            }
+            for (plint iX=face.x0; iX<=face.x1; ++iX) {
+                for (plint iY=face.y0; iY<=face.y1; ++iY) {
+                    for (plint iZ=face.z0; iZ<=face.z1; ++iZ) {
+                        plint tag = tagMatrix.get(iX,iY,iZ);
+                        plint neighborTag = tagMatrix.get(iX+ofs.x,iY+ofs.y,iZ+ofs.z);
+                        if (tag>=0 && neighborTag>=0 && tag!=neighborTag) {
+                            links.insert(std::make_pair(std::min(tag,neighborTag), std::max(tag,neighborTag)));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::set<std::pair<plint,plint> >::const_iterator it = links.begin();
+    for (; it!=links.end(); ++it) {
+        data.links.push_back(it->first);
+        data.links.push_back(it->second);
+    }
+}
+
+
+/* *************** Class ApplyClusterRemap3D ******************************** */
+
+ApplyClusterRemap3D* ApplyClusterRemap3D::clone() const {
+    return new ApplyClusterRemap3D(*this);
+}
+
+void ApplyClusterRemap3D::processGenericBlocks(Box3D domain,std::vector<AtomicBlock3D*> atomicBlocks)
+{
+    PLB_ASSERT(atomicBlocks.size()==2);
+    ScalarField3D<plint>* pTagMatrix = dynamic_cast<ScalarField3D<plint>*> (atomicBlocks[0]);
+    PLB_ASSERT(pTagMatrix);
+    ScalarField3D<plint>& tagMatrix = *pTagMatrix;
+    ClusterData3D& data = getClusterData(atomicBlocks[1]);
+
+    for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
+        for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
+            for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
+                plint& tag = tagMatrix.get(iX,iY,iZ);
+                if (tag>=0) {
+                    std::map<plint,plint>::const_iterator it = data.tagRemap.find(tag);
+                    PLB_ASSERT(it!=data.tagRemap.end());
+                    tag = it->second;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace plb
@@ -0,0 +1,152 @@
+/* This file is part of the Palabos library.
+ *
+ * The Palabos softare is developed since 2011 by FlowKit-Numeca Group Sarl
+ * (Switzerland) and the University of Geneva (Switzerland), which jointly
+ * own the IP rights for most of the code base. Since October 2019, the
+ * Palabos project is maintained by the University of Geneva and accepts
+ * source code contributions from the community.
+ * 
+ * Contact:
+ * Jonas Latt
+ * Computer Science Department
+ * University of Geneva
+ * 7 Route de Drize
+ * 1227 Carouge, Switzerland
+ * jonas.latt@unige.ch
+ *
+ * The most recent release of Palabos can be downloaded at 
+ * <https://palabos.unige.ch/>
+ *
+ * The library Palabos is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * The library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/* Connected-component labelling of the cells of a flag matrix that carry a given
+ * flag value (face connectivity), for example the cells in which one of the
+ * Shan-Chen components dominates. Every atomic block is labelled with a local
+ * union-find, in a single sweep; the labels are then merged across the block
+ * boundaries by a global union-find on the pairs of labels that touch each other
+ * through the envelopes. The cost is one sweep of the bulk, one sweep of the block
+ * surfaces and one exchange of the (few) local cluster labels.
+ */
+
+#ifndef CLUSTER_MATCH_3D_H
+#define CLUSTER_MATCH_3D_H
+
+#include "core/globalDefs.h"
+#include "core/geometry3D.h"
+#include "atomicBlock/atomicContainerBlock3D.h"
+#include "atomicBlock/dataProcessingFunctional3D.h"
+#include "multiBlock/multiContainerBlock3D.h"
+#include "multiBlock/multiDataField3D.h"
+#include "multiPhysics/bubbleMatch3D.h"
+#include <map>
+#include <vector>
+
+
+namespace plb {
+
+class ClusterMatch3D
+{
+public:
+    ClusterMatch3D(MultiBlock3D& templ);
+    ~ClusterMatch3D();
+    // Labels all cells with flag==phaseFlag. After execution, the tag matrix holds the
+    // cluster ID (0 ... numClusters()-1) of these cells and -1 everywhere else. The
+    // contact of every cluster with the inlet and outlet domains is recorded.
+    void execute(MultiScalarField3D<int>& flag, int phaseFlag, Box3D inlet, Box3D outlet);
+    MultiScalarField3D<plint>* getTagMatrix() { return tagMatrix; }
+    std::vector<double> const& getClusterVolume() const { return clusterVolume; }
+    std::vector<bool> const& getTouchesInlet() const { return touchesInlet; }
+    std::vector<bool> const& getTouchesOutlet() const { return touchesOutlet; }
+    pluint numClusters() const { return clusterVolume.size(); }
+private:
+    // Global union-find on the local clusters of all blocks; fills the cluster data
+    // and the tag remap of the local blocks.
+    void mergeClusters();
+private:
+    ClusterMatch3D(ClusterMatch3D const& rhs) : mpiData(rhs.mpiData) { PLB_ASSERT( false ); }
+    ClusterMatch3D& operator=(ClusterMatch3D const& rhs) { PLB_ASSERT( false ); return *this; }
+private:
+    MultiContainerBlock3D *clusterContainer;
+    BubbleMPIdata mpiData;
+    MultiScalarField3D<plint> *tagMatrix;
+    std::vector<double> clusterVolume;
+    std::vector<bool> touchesInlet, touchesOutlet;
+};
+
+/**
+ * Data of the cluster labelling, associated to one block:
+ *  labels, volumes, contacts: the local clusters, identified by a globally unique
+ *                             label (the linear index of their root cell); the
+ *                             contact holds 1 for the inlet and 2 for the outlet.
+ *  links: pairs of labels of two clusters which touch across the block boundary.
+ *  tagRemap: the final cluster ID of every local label.
+ **/
+struct ClusterData3D : public ContainerBlockData {
+    virtual ClusterData3D* clone() const {
+        return new ClusterData3D(*this);
+    }
+    std::vector<plint> labels;
+    std::vector<double> volumes;
+    std::vector<int> contacts;
+    std::vector<plint> links;
+    std::map<plint,plint> tagRemap;
+};
+
+// Local union-find labelling of the cells with flag==phaseFlag. The envelope of the
+// tag matrix is reset to -1, so that it only holds labels of neighboring blocks
+// after the envelope update.
+class LabelLocalClusters3D : public BoxProcessingFunctional3D
+{
+public:
+    LabelLocalClusters3D(int phaseFlag_, Box3D globalDomain_, Box3D inlet_, Box3D outlet_);
+    virtual void processGenericBlocks(Box3D domain, std::vector<AtomicBlock3D*> atomicBlocks);
+    virtual LabelLocalClusters3D* clone() const;
+    virtual void getTypeOfModification (std::vector<modif::ModifT>& modified) const {
+        modified[0] = modif::staticVariables; // tags.
+        modified[1] = modif::nothing;         // flags.
+        modified[2] = modif::nothing;         // data.
+    }
+private:
+    int phaseFlag;
+    Box3D globalDomain, inlet, outlet;
+};
+
+// Collects the pairs of labels that touch each other across the block boundaries.
+class LinkClusters3D : public BoxProcessingFunctional3D
+{
+public:
+    virtual void processGenericBlocks(Box3D domain, std::vector<AtomicBlock3D*> atomicBlocks);
+    virtual LinkClusters3D* clone() const;
+    virtual void getTypeOfModification (std::vector<modif::ModifT>& modified) const {
+        modified[0] = modif::nothing;  // tags.
+        modified[1] = modif::nothing;  // data.
+    }
+};
+
+// Replaces the local labels by the final cluster IDs.
+class ApplyClusterRemap3D : public BoxProcessingFunctional3D
+{
+public:
+    virtual void processGenericBlocks(Box3D domain, std::vector<AtomicBlock3D*> atomicBlocks);
+    virtual ApplyClusterRemap3D* clone() const;
+    virtual void getTypeOfModification (std::vector<modif::ModifT>& modified) const {
+        modified[0] = modif::staticVariables; // tags.
+        modified[1] = modif::nothing;         // data.
+    }
+};
+
+}  // namespace plb
+
+#endif  // CLUSTER_MATCH_3D_H
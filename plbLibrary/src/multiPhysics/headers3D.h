@@ -52,6 +52,7 @@
 #include "multiPhysics/createBubbles3D.h"
 #include "multiPhysics/bubbleHistory3D.h"
 #include "multiPhysics/bubbleMatch3D.h"
+#include "multiPhysics/clusterMatch3D.h"
 #include "multiPhysics/twoPhaseModel3D.h"
 #include "multiPhysics/bodyForce3D.h"
 
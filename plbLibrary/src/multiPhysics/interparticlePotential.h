@@ -36,6 +36,7 @@
 
 #include "core/globalDefs.h"
 #include <cmath>
+#include <vector>
 
 namespace plb {
 
@@ -47,6 +48,10 @@ template<typename T>
 struct PsiFunction {
     virtual ~PsiFunction();
     virtual T compute(T rho) const =0;
+    /// Evaluate psi on num contiguous densities; psi may alias rho. The default
+    ///   implementation calls compute() per value, and is overridden by potentials
+    ///   that have a cheaper evaluation on a whole range.
+    virtual void computeRange(T const* rho, T* psi, plint num) const;
     virtual PsiFunction<T>* clone() const =0;
 };
 
@@ -90,6 +95,39 @@ private:
     T rho_0, rho_0_sqr, g;
 };
 
+/// Piecewise cubic Hermite interpolation of another potential on [0,rhoMax),
+///   with numIntervals equal intervals. Outside this range the original
+///   potential is evaluated. The table replaces the transcendental functions
+///   of the potentials above by a polynomial per node.
+template<typename T>
+class TabulatedPsi : public PsiFunction<T> {
+public:
+    TabulatedPsi(PsiFunction<T> const& psi_, T rhoMax_, plint numIntervals_=4096);
+    TabulatedPsi(TabulatedPsi<T> const& rhs);
+    TabulatedPsi<T>& operator=(TabulatedPsi<T> const& rhs);
+    virtual ~TabulatedPsi();
+    virtual T compute(T rho) const;
+    virtual void computeRange(T const* rho, T* psi, plint num) const;
+    virtual TabulatedPsi<T>* clone() const;
+private:
+    T evaluate(T rho) const {
+        T x = rho*invDeltaRho;
+        plint iInterval = (plint)x;
+        if (rho < T() || iInterval >= numIntervals) {
+            return psi->compute(rho);
+        }
+        T t = x - (T)iInterval;
+        T const* c = &coefficients[4*iInterval];
+        return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+    }
+private:
+    PsiFunction<T>* psi;
+    T rhoMax, invDeltaRho;
+    plint numIntervals;
+    /// Polynomial coefficients in the local coordinate t in [0,1), four per interval.
+    std::vector<T> coefficients;
+};
+
 }  // namespace potentials
 
 }  // namespace plb
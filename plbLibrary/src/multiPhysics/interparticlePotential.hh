@@ -44,6 +44,13 @@ template<typename T>
 PsiFunction<T>::~PsiFunction()
 { }
 
+template<typename T>
+void PsiFunction<T>::computeRange(T const* rho, T* psi, plint num) const {
+    for (plint i=0; i<num; ++i) {
+        psi[i] = compute(rho[i]);
+    }
+}
+
 template<typename T>
 T PsiIsRho<T>::compute(T rho) const {
     return rho;
@@ -102,6 +109,89 @@ PsiQian95<T>* PsiQian95<T>::clone() const {
     return new PsiQian95<T>(*this);
 }
 
+template<typename T>
+TabulatedPsi<T>::TabulatedPsi(PsiFunction<T> const& psi_, T rhoMax_, plint numIntervals_)
+    : psi(psi_.clone()),
+      rhoMax(rhoMax_),
+      invDeltaRho((T)numIntervals_/rhoMax_),
+      numIntervals(numIntervals_),
+      coefficients(4*numIntervals_)
+{
+    PLB_PRECONDITION( rhoMax>T() && numIntervals>0 );
+    T deltaRho = rhoMax/(T)numIntervals;
+    // Derivatives at the nodes, from fourth-order finite differences of the original
+    //   potential; one-sided at rho=0, where some potentials are not defined below.
+    T h = (T)0.01*deltaRho;
+    std::vector<T> values(numIntervals+1), derivatives(numIntervals+1);
+    for (plint iNode=0; iNode<=numIntervals; ++iNode) {
+        T rho = (T)iNode*deltaRho;
+        values[iNode] = psi->compute(rho);
+        if (iNode==0) {
+            derivatives[iNode] = ( -(T)25*values[iNode] + (T)48*psi->compute(rho+h)
+                                   -(T)36*psi->compute(rho+(T)2*h) + (T)16*psi->compute(rho+(T)3*h)
+                                   -(T)3*psi->compute(rho+(T)4*h) ) / ((T)12*h);
+        }
+        else {
+            derivatives[iNode] = ( psi->compute(rho-(T)2*h) - (T)8*psi->compute(rho-h)
+                                   + (T)8*psi->compute(rho+h) - psi->compute(rho+(T)2*h) ) / ((T)12*h);
+        }
+    }
+    // Hermite polynomial on each interval, with derivatives scaled to t in [0,1).
+    for (plint iInterval=0; iInterval<numIntervals; ++iInterval) {
+        T p0 = values[iInterval];
+        T p1 = values[iInterval+1];
+        T m0 = derivatives[iInterval]*deltaRho;
+        T m1 = derivatives[iInterval+1]*deltaRho;
+        T* c = &coefficients[4*iInterval];
+        c[0] = p0;
+        c[1] = m0;
+        c[2] = (T)3*(p1-p0) - (T)2*m0 - m1;
+        c[3] = (T)2*(p0-p1) + m0 + m1;
+    }
+}
+
+template<typename T>
+TabulatedPsi<T>::TabulatedPsi(TabulatedPsi<T> const& rhs)
+    : psi(rhs.psi->clone()),
+      rhoMax(rhs.rhoMax),
+      invDeltaRho(rhs.invDeltaRho),
+      numIntervals(rhs.numIntervals),
+      coefficients(rhs.coefficients)
+{ }
+
+template<typename T>
+TabulatedPsi<T>& TabulatedPsi<T>::operator=(TabulatedPsi<T> const& rhs) {
+    PsiFunction<T>* newPsi = rhs.psi->clone();
+    delete psi; psi = newPsi;
+    rhoMax = rhs.rhoMax;
+    invDeltaRho = rhs.invDeltaRho;
+    numIntervals = rhs.numIntervals;
+    coefficients = rhs.coefficients;
+    return *this;
+}
+
+template<typename T>
+TabulatedPsi<T>::~TabulatedPsi() {
+    delete psi;
+}
+
+template<typename T>
+T TabulatedPsi<T>::compute(T rho) const {
+    return evaluate(rho);
+}
+
+template<typename T>
+void TabulatedPsi<T>::computeRange(T const* rho, T* psi_, plint num) const {
+    for (plint i=0; i<num; ++i) {
+        psi_[i] = evaluate(rho[i]);
+    }
+}
+
+template<typename T>
+TabulatedPsi<T>* TabulatedPsi<T>::clone() const {
+    return new TabulatedPsi<T>(*this);
+}
+
 }  // namespace interparticlePotential
 
 }  // namespace plb
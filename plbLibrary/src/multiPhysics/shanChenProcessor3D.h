@@ -46,6 +46,7 @@
 #include "multiBlock/multiDataField3D.h"
 
 #include <memory>
+#include <vector>
 
 namespace plb {
 
@@ -67,6 +68,13 @@ public:
     virtual void process(Box3D domain, std::vector<BlockLattice3D<T,Descriptor>*> lattices );
     virtual ShanChenMultiComponentProcessor3D<T,Descriptor>* clone() const;
     virtual void getTypeOfModification(std::vector<modif::ModifT>& modified) const;
+private:
+    /// Store the density and momentum of each species of a cell in its external scalars.
+    void storeMoments(std::vector<BlockLattice3D<T,Descriptor>*>& lattices, plint iX, plint iY, plint iZ);
+    /// Store the momentum corrected by the interaction force of each species of a cell.
+    void storeInteraction(std::vector<BlockLattice3D<T,Descriptor>*>& lattices,
+                          std::vector<T>& omega, std::vector<T>& invOmega,
+                          std::vector<Array<T,Descriptor<T>::d> >& rhoContribution, plint iX, plint iY, plint iZ);
 private:
     T G;
     std::vector<T> speciesG;
@@ -87,6 +95,10 @@ public:
 private:
     T G;
     interparticlePotential::PsiFunction<T>* Psi;
+    /// Scratch storage for psi on the domain and a one-cell envelope. It is
+    ///   kept between calls to avoid an allocation per time step, and is not
+    ///   copied with the processor.
+    std::vector<T> psiField;
 };
 
 /// Shan-Chen coupling for multi-component flow with or without external force
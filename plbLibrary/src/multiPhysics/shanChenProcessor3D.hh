@@ -107,32 +107,32 @@ void ShanChenMultiComponentProcessor3D<T,Descriptor>::process (
 {
     // Number of species (or components) which are coupled in this Shan/Chen multi-component fluid.
     plint numSpecies = (plint) lattices.size();
-    // Short-hand notation for the lattice descriptor
-    typedef Descriptor<T> D;
-    // Handle to external scalars
-    enum {
-        densityOffset  = D::ExternalField::densityBeginsAt,
-        momentumOffset = D::ExternalField::momentumBeginsAt
-    };
-    
+    // Lattices restricted to a list of active cells (which must be the same for all
+    //   species) are only visited on this list.
+    bool activeCellsOnly = true;
+    for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
+        activeCellsOnly = activeCellsOnly && lattices[iSpecies]->hasActiveCells();
+    }
+    Box3D envelope(domain.enlarge(1));
+
     // Compute per-lattice density  and momentum on every site and on each
     //   lattice, and store result in external scalars;  envelope cells are included,
     //   because they are needed to compute the interaction potential in the following.
     //   Note that the per-lattice value of the momentum is stored temporarily only, as
     //   it is corrected later on, based on the common fluid velocity.
-    for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
-        for (plint iX=domain.x0-1; iX<=domain.x1+1; ++iX) {
-            for (plint iY=domain.y0-1; iY<=domain.y1+1; ++iY) {
-                for (plint iZ=domain.z0-1; iZ<=domain.z1+1; ++iZ) {
-                    // Get "intelligent" value of density through cell object, to account
-                    //   for the fact that the density value can be user-defined, for example
-                    //   on boundaries.
-                    Cell<T,Descriptor>& cell = lattices[iSpecies]->get(iX,iY,iZ);
-                    Array<T,Descriptor<T>::d> j;
-                    T rhoBar = cell.getDynamics().computeRhoBar(cell);
-                    momentTemplates<T,Descriptor>::get_j(cell,j);
-                    *cell.getExternal(densityOffset) = Descriptor<T>::fullRho(rhoBar);
-                    j.to_cArray(cell.getExternal(momentumOffset));
+    if (activeCellsOnly) {
+        std::vector<Dot3D> const& cells = lattices[0]->getActiveCells();
+        for (pluint iCell=0; iCell<cells.size(); ++iCell) {
+            if (contained(cells[iCell].x, cells[iCell].y, cells[iCell].z, envelope)) {
+                storeMoments(lattices, cells[iCell].x, cells[iCell].y, cells[iCell].z);
+            }
+        }
+    }
+    else {
+        for (plint iX=envelope.x0; iX<=envelope.x1; ++iX) {
+            for (plint iY=envelope.y0; iY<=envelope.y1; ++iY) {
+                for (plint iZ=envelope.z0; iZ<=envelope.z1; ++iZ) {
+                    storeMoments(lattices, iX, iY, iZ);
                 }
             }
         }
@@ -140,10 +140,8 @@ void ShanChenMultiComponentProcessor3D<T,Descriptor>::process (
 
     // Temporary variable for the relaxation parameters omega.
     std::vector<T> omega(numSpecies), invOmega(numSpecies);
-    // Temporary variable for total velocity.
-    Array<T,Descriptor<T>::d> uTot;
     // Temporary variable for interaction potential.
-    std::vector<Array<T,D::d> > rhoContribution(numSpecies);
+    std::vector<Array<T,Descriptor<T>::d> > rhoContribution(numSpecies);
 
     // If omega is constant and imposed by the user, copy its value to
     //   the vector "omega", and compute the inverse.
@@ -161,62 +159,113 @@ void ShanChenMultiComponentProcessor3D<T,Descriptor>::process (
 
     // Compute the interaction force between the species, and store it by
     //   means of a velocity correction in the external velocity field.
-    for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
-        for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
-            for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
-                // Computation of the common density over all populations, weighted by
-                //   the relaxation parameters omega.
-                T weightedDensity = T();
-                for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
-                    Cell<T,Descriptor> const& cell = lattices[iSpecies]->get(iX,iY,iZ);
-                    // Take this opportunity to read omega from the cell, unless the value
-                    //   of omega is constant and imposed by the user.
-                    if (imposedOmega.empty()) {
-                        omega[iSpecies] = cell.getDynamics().getOmega();
-                        invOmega[iSpecies] = (T)1/omega[iSpecies];
-                    }
-                    weightedDensity += omega[iSpecies] * (*cell.getExternal(densityOffset));
-                }
-                // Computation of the common velocity, shared among all populations.
-                for (int iD = 0; iD < Descriptor<T>::d; ++iD) {
-                    uTot[iD] = T();
-                    for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
-                        T *momentum = lattices[iSpecies]->get(iX,iY,iZ).getExternal(momentumOffset);
-                        uTot[iD] += momentum[iD] * omega[iSpecies];
-                    }
-                    uTot[iD] /= weightedDensity;
+    if (activeCellsOnly) {
+        std::vector<Dot3D> const& cells = lattices[0]->getActiveCells();
+        for (pluint iCell=0; iCell<cells.size(); ++iCell) {
+            if (contained(cells[iCell].x, cells[iCell].y, cells[iCell].z, domain)) {
+                storeInteraction(lattices, omega, invOmega, rhoContribution, cells[iCell].x, cells[iCell].y, cells[iCell].z);
+            }
+        }
+    }
+    else {
+        for (plint iX=domain.x0; iX<=domain.x1; ++iX) {
+            for (plint iY=domain.y0; iY<=domain.y1; ++iY) {
+                for (plint iZ=domain.z0; iZ<=domain.z1; ++iZ) {
+                    storeInteraction(lattices, omega, invOmega, rhoContribution, iX, iY, iZ);
                 }
+            }
+        }
+    }
+}
 
-                // Computation of the interaction potential.
-                for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
-                    multiPhaseTemplates3D<T,Descriptor>::shanChenInteraction (
-                            *lattices[iSpecies],rhoContribution[iSpecies],iX,iY,iZ );
-                }
+template<typename T, template<typename U> class Descriptor>
+void ShanChenMultiComponentProcessor3D<T,Descriptor>::storeMoments (
+        std::vector<BlockLattice3D<T,Descriptor>*>& lattices, plint iX, plint iY, plint iZ )
+{
+    enum {
+        densityOffset  = Descriptor<T>::ExternalField::densityBeginsAt,
+        momentumOffset = Descriptor<T>::ExternalField::momentumBeginsAt
+    };
+    for (pluint iSpecies=0; iSpecies<lattices.size(); ++iSpecies) {
+        // Get "intelligent" value of density through cell object, to account
+        //   for the fact that the density value can be user-defined, for example
+        //   on boundaries.
+        Cell<T,Descriptor>& cell = lattices[iSpecies]->get(iX,iY,iZ);
+        Array<T,Descriptor<T>::d> j;
+        T rhoBar = cell.getDynamics().computeRhoBar(cell);
+        momentTemplates<T,Descriptor>::get_j(cell,j);
+        *cell.getExternal(densityOffset) = Descriptor<T>::fullRho(rhoBar);
+        j.to_cArray(cell.getExternal(momentumOffset));
+    }
+}
 
-                // Computation and storage of the final velocity, consisting
-                //   of uTot plus the momentum difference due to interaction
-                //   potential and external force
-                for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
-                    Cell<T,Descriptor>& cell = lattices[iSpecies]->get(iX,iY,iZ);
-                    T *momentum = cell.getExternal(momentumOffset);
-                    for (int iD = 0; iD < D::d; ++iD) {
-                        momentum[iD] = uTot[iD];
-                        // Initialize force contribution with force from external fields if there
-                        //   is any, or with zero otherwise.
-                        T forceContribution = getExternalForceComponent(cell, iD);
-                        // Then, add a contribution from the potential of all other species.
-                        for (plint iPartnerSpecies=0; iPartnerSpecies<numSpecies; ++iPartnerSpecies) {
-                            if (iPartnerSpecies != iSpecies) {
-                                forceContribution -= speciesG[iSpecies * numSpecies + iPartnerSpecies] *
-                                    rhoContribution[iPartnerSpecies][iD];
-                            }
-                        }
-                        momentum[iD] += invOmega[iSpecies]*forceContribution;
-                        // Multiply by rho to convert from velocity to momentum.
-                        momentum[iD] *= *cell.getExternal(densityOffset);
-                    }
+template<typename T, template<typename U> class Descriptor>
+void ShanChenMultiComponentProcessor3D<T,Descriptor>::storeInteraction (
+        std::vector<BlockLattice3D<T,Descriptor>*>& lattices,
+        std::vector<T>& omega, std::vector<T>& invOmega,
+        std::vector<Array<T,Descriptor<T>::d> >& rhoContribution, plint iX, plint iY, plint iZ )
+{
+    plint numSpecies = (plint) lattices.size();
+    // Short-hand notation for the lattice descriptor
+    typedef Descriptor<T> D;
+    // Handle to external scalars
+    enum {
+        densityOffset  = D::ExternalField::densityBeginsAt,
+        momentumOffset = D::ExternalField::momentumBeginsAt
+    };
+    // Temporary variable for total velocity.
+    Array<T,Descriptor<T>::d> uTot;
+
+    // Computation of the common density over all populations, weighted by
+    //   the relaxation parameters omega.
+    T weightedDensity = T();
+    for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
+        Cell<T,Descriptor> const& cell = lattices[iSpecies]->get(iX,iY,iZ);
+        // Take this opportunity to read omega from the cell, unless the value
+        //   of omega is constant and imposed by the user.
+        if (imposedOmega.empty()) {
+            omega[iSpecies] = cell.getDynamics().getOmega();
+            invOmega[iSpecies] = (T)1/omega[iSpecies];
+        }
+        weightedDensity += omega[iSpecies] * (*cell.getExternal(densityOffset));
+    }
+    // Computation of the common velocity, shared among all populations.
+    for (int iD = 0; iD < Descriptor<T>::d; ++iD) {
+        uTot[iD] = T();
+        for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
+            T *momentum = lattices[iSpecies]->get(iX,iY,iZ).getExternal(momentumOffset);
+            uTot[iD] += momentum[iD] * omega[iSpecies];
+        }
+        uTot[iD] /= weightedDensity;
+    }
+
+    // Computation of the interaction potential.
+    for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
+        multiPhaseTemplates3D<T,Descriptor>::shanChenInteraction (
+                *lattices[iSpecies],rhoContribution[iSpecies],iX,iY,iZ );
+    }
+
+    // Computation and storage of the final velocity, consisting
+    //   of uTot plus the momentum difference due to interaction
+    //   potential and external force
+    for (plint iSpecies=0; iSpecies<numSpecies; ++iSpecies) {
+        Cell<T,Descriptor>& cell = lattices[iSpecies]->get(iX,iY,iZ);
+        T *momentum = cell.getExternal(momentumOffset);
+        for (int iD = 0; iD < D::d; ++iD) {
+            momentum[iD] = uTot[iD];
+            // Initialize force contribution with force from external fields if there
+            //   is any, or with zero otherwise.
+            T forceContribution = getExternalForceComponent(cell, iD);
+            // Then, add a contribution from the potential of all other species.
+            for (plint iPartnerSpecies=0; iPartnerSpecies<numSpecies; ++iPartnerSpecies) {
+                if (iPartnerSpecies != iSpecies) {
+                    forceContribution -= speciesG[iSpecies * numSpecies + iPartnerSpecies] *
+                        rhoContribution[iPartnerSpecies][iD];
                 }
             }
+            momentum[iD] += invOmega[iSpecies]*forceContribution;
+            // Multiply by rho to convert from velocity to momentum.
+            momentum[iD] *= *cell.getExternal(densityOffset);
         }
     }
 }
@@ -232,9 +281,10 @@ ShanChenMultiComponentProcessor3D<T,Descriptor>*
 template<typename T, template<typename U> class Descriptor>
 void ShanChenMultiComponentProcessor3D<T,Descriptor>::getTypeOfModification(std::vector<modif::ModifT>& modified) const
 {
-    // All blocks are modified by the Shan/Chen processor.
+    // All blocks are modified by the Shan/Chen processor, but only the external
+    //   scalars (density, momentum, force) are written, never the populations.
     for (pluint iBlock=0; iBlock<modified.size(); ++iBlock) {
-        modified[iBlock] = modif::staticVariables;
+        modified[iBlock] = modif::externalVariables;
     }
 }
 
@@ -302,13 +352,17 @@ void ShanChenSingleComponentProcessor3D<T,Descriptor>::process (
     plint offsetX = domain.x0-1;
     plint offsetY = domain.y0-1;
     plint offsetZ = domain.z0-1;
-    ScalarField3D<T> psiField(nx,ny,nz);
+    // The scratch storage only grows, so that it is allocated once per block.
+    if ((plint)psiField.size() < nx*ny*nz) {
+        psiField.resize(nx*ny*nz);
+    }
     
     // Compute density and momentum on every site and store result in external scalars;
-    //   furthermore, evaluate the interaction potential Psi and store it into a ScalarField.
-    //   Envelope cells are included, because they are needed to compute the interaction potential
-    //   in the following. Note that the value of the momentum is stored temporarily only, as
-    //   it is corrected later on to include corrections due to the interaction potential.
+    //   furthermore, store the density into the scratch field, where it is converted to the
+    //   interaction potential Psi in a single pass afterwards. Envelope cells are included,
+    //   because they are needed to compute the interaction potential in the following.
+    //   Note that the value of the momentum is stored temporarily only, as it is corrected
+    //   later on to include corrections due to the interaction potential.
     for (plint iX=domain.x0-1; iX<=domain.x1+1; ++iX) {
         for (plint iY=domain.y0-1; iY<=domain.y1+1; ++iY) {
             for (plint iZ=domain.z0-1; iZ<=domain.z1+1; ++iZ) {
@@ -317,8 +371,7 @@ void ShanChenSingleComponentProcessor3D<T,Descriptor>::process (
                 //   on boundaries.
                 Cell<T,Descriptor>& cell = lattice.get(iX,iY,iZ);
                 T rho = cell.computeDensity();
-                // Evaluate potential function psi.
-                psiField.get(iX-offsetX, iY-offsetY, iZ-offsetZ) = Psi->compute(rho);
+                psiField[((iX-offsetX)*ny + (iY-offsetY))*nz + (iZ-offsetZ)] = rho;
                 // Store density into the corresponding external scalar.
                 *cell.getExternal(densityOffset) = rho;
                 // Compute momentum through direct access to particle populations, and store
@@ -333,6 +386,8 @@ void ShanChenSingleComponentProcessor3D<T,Descriptor>::process (
             }
         }
     }
+    // Evaluate the potential function psi in place, with one virtual call per block.
+    Psi->computeRange(&psiField[0], &psiField[0], nx*ny*nz);
 
     // Compute the interparticle forces, and store they by means of a 
     //   velocity correction in the external velocity field.
@@ -346,7 +401,7 @@ void ShanChenSingleComponentProcessor3D<T,Descriptor>::process (
                     plint nextX = iX + D::c[iPop][0];
                     plint nextY = iY + D::c[iPop][1];
                     plint nextZ = iZ + D::c[iPop][2];
-                    T psi = psiField.get(nextX-offsetX, nextY-offsetY, nextZ-offsetZ);
+                    T psi = psiField[((nextX-offsetX)*ny + (nextY-offsetY))*nz + (nextZ-offsetZ)];
                     for (int iD = 0; iD < D::d; ++iD) {
                         rhoContribution[iD] += D::t[iPop] * psi * D::c[iPop][iD];
                     }
@@ -361,7 +416,7 @@ void ShanChenSingleComponentProcessor3D<T,Descriptor>::process (
                     //   is any, or with zero otherwise.
                     T forceContribution = getExternalForceComponent(cell, iD);
                     // Add interaction term.
-                    T psi = psiField.get(iX-offsetX, iY-offsetY, iZ-offsetZ);
+                    T psi = psiField[((iX-offsetX)*ny + (iY-offsetY))*nz + (iZ-offsetZ)];
                     forceContribution -= G * psi * rhoContribution[iD];
                     // Include into total momentum.
                     momentum[iD] += (T)1/cell.getDynamics().getOmega()*forceContribution;
@@ -51,7 +51,8 @@ namespace global {
 
 MpiManager::MpiManager()
     : ok(false),
-      responsibleForMpiMachine(false)
+      responsibleForMpiMachine(false),
+      persistentCommunication(false)
 { }
 
 MpiManager::~MpiManager() {
@@ -2721,6 +2722,45 @@ void MpiManager::wait(MPI_Request* request, MPI_Status* status)
     global::timer("plb_wait").stop();
 }
 
+void MpiManager::sendInit(char *buf, int count, int dest, MPI_Request* request, int tag)
+{
+    if (ok) {
+        MPI_Send_init(static_cast<void*>(buf), count, MPI_CHAR, dest, tag, getGlobalCommunicator(), request);
+    }
+}
+
+void MpiManager::recvInit(char *buf, int count, int source, MPI_Request* request, int tag)
+{
+    if (ok) {
+        MPI_Recv_init(static_cast<void*>(buf), count, MPI_CHAR, source, tag, getGlobalCommunicator(), request);
+    }
+}
+
+void MpiManager::start(MPI_Request* request)
+{
+    if (ok) {
+        MPI_Start(request);
+    }
+}
+
+void MpiManager::requestFree(MPI_Request* request)
+{
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (ok && !finalized && *request != MPI_REQUEST_NULL) {
+        MPI_Request_free(request);
+    }
+    *request = MPI_REQUEST_NULL;
+}
+
+void MpiManager::setPersistentCommunication(bool persistentCommunication_) {
+    persistentCommunication = persistentCommunication_;
+}
+
+bool MpiManager::usesPersistentCommunication() const {
+    return persistentCommunication;
+}
+
 }  // namespace global
 
 }  // namespace plb
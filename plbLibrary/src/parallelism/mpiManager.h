@@ -161,6 +161,23 @@ public:
     /// Complete a non-blocking MPI operation
     void wait(MPI_Request* request, MPI_Status* status);
 
+    /// Create a persistent request for sending the data at *buf
+    void sendInit( char *buf, int count, int dest, MPI_Request* request, int tag = 0 );
+
+    /// Create a persistent request for receiving data at *buf
+    void recvInit( char *buf, int count, int source, MPI_Request* request, int tag = 0 );
+
+    /// Start the communication of an inactive persistent request
+    void start(MPI_Request* request);
+
+    /// Free a persistent request. Does nothing once MPI is finalized.
+    void requestFree(MPI_Request* request);
+
+    /// Use persistent requests for the messages of static size exchanged
+    ///   by the send/receive pools of the block communicators.
+    void setPersistentCommunication(bool persistentCommunication_);
+    bool usesPersistentCommunication() const;
+
 private:
     /// Implementation code for Scatter
     template <typename T>
@@ -178,6 +195,7 @@ private:
     int numTasks, taskId;
     bool ok;
     bool responsibleForMpiMachine;
+    bool persistentCommunication;
     MPI_Comm globalCommunicator;
 
 friend MpiManager& mpi();
@@ -209,6 +227,9 @@ public:
     void sendToMaster( std::string& message, bool iAmRoot ) { }
     /// Synchronizes the processes
     void barrier() { }
+    /// Persistent communication is meaningless in serial
+    void setPersistentCommunication(bool persistentCommunication_) { }
+    bool usesPersistentCommunication() const { return false; }
 
 friend MpiManager& mpi();
 };
@@ -55,6 +55,25 @@ CommunicationStructure3D::CommunicationStructure3D (
         MultiBlockManagement3D const& originManagement,
         MultiBlockManagement3D const& destinationManagement,
         plint sizeOfCell )
+{
+    initialize( overlaps, originManagement, destinationManagement,
+                std::vector<plint>(1, sizeOfCell) );
+}
+
+CommunicationStructure3D::CommunicationStructure3D (
+        std::vector<Overlap3D> const& overlaps,
+        MultiBlockManagement3D const& originManagement,
+        MultiBlockManagement3D const& destinationManagement,
+        std::vector<plint> const& sizeOfCells )
+{
+    initialize(overlaps, originManagement, destinationManagement, sizeOfCells);
+}
+
+void CommunicationStructure3D::initialize (
+        std::vector<Overlap3D> const& overlaps,
+        MultiBlockManagement3D const& originManagement,
+        MultiBlockManagement3D const& destinationManagement,
+        std::vector<plint> const& sizeOfCells )
 {
     plint fromEnvelopeWidth = originManagement.getEnvelopeWidth();
     plint toEnvelopeWidth = destinationManagement.getEnvelopeWidth();
@@ -105,12 +124,16 @@ CommunicationStructure3D::CommunicationStructure3D (
         else if (fromAttribution.isLocal(info.fromBlockId))
         {
             sendPackage.push_back(info);
-            sendPool.subscribeMessage(info.toProcessId, numberOfCells*sizeOfCell);
+            for (pluint iCell=0; iCell<sizeOfCells.size(); ++iCell) {
+                sendPool.subscribeMessage(info.toProcessId, numberOfCells*sizeOfCells[iCell]);
+            }
         }
         else if (toAttribution.isLocal(info.toBlockId))
         {
             recvPackage.push_back(info);
-            recvPool.subscribeMessage(info.fromProcessId, numberOfCells*sizeOfCell);
+            for (pluint iCell=0; iCell<sizeOfCells.size(); ++iCell) {
+                recvPool.subscribeMessage(info.fromProcessId, numberOfCells*sizeOfCells[iCell]);
+            }
         }
     }
 
@@ -184,18 +207,16 @@ CommunicationPattern3D::CommunicationPattern3D (
 ////////////////////// Class ParallelBlockCommunicator3D /////////////////////
 
 ParallelBlockCommunicator3D::ParallelBlockCommunicator3D()
-    : overlapsModified(true),
-      communication(0)
+    : overlapsModified(true)
 { }
 
 ParallelBlockCommunicator3D::ParallelBlockCommunicator3D (
         ParallelBlockCommunicator3D const& rhs )
-    : overlapsModified(true),
-      communication(0)
+    : overlapsModified(true)
 { }
 
 ParallelBlockCommunicator3D::~ParallelBlockCommunicator3D() {
-    delete communication;
+    clearCommunications();
 }
 
 ParallelBlockCommunicator3D& ParallelBlockCommunicator3D::operator= (
@@ -207,7 +228,7 @@ ParallelBlockCommunicator3D& ParallelBlockCommunicator3D::operator= (
 
 void ParallelBlockCommunicator3D::swap(ParallelBlockCommunicator3D& rhs) {
     std::swap(overlapsModified,rhs.overlapsModified);
-    std::swap(communication,rhs.communication);
+    communications.swap(rhs.communications);
 }
 
 ParallelBlockCommunicator3D* ParallelBlockCommunicator3D::clone() const {
@@ -217,28 +238,65 @@ ParallelBlockCommunicator3D* ParallelBlockCommunicator3D::clone() const {
 void ParallelBlockCommunicator3D::duplicateOverlaps( MultiBlock3D& multiBlock,
                                                      modif::ModifT whichData ) const
 {
-    MultiBlockManagement3D const& multiBlockManagement = multiBlock.getMultiBlockManagement();
-    PeriodicitySwitch3D const& periodicity             = multiBlock.periodicity();
+    std::vector<plint> sizeOfCells(1, multiBlock.sizeOfCellContent(whichData));
+    communicate(getCommunication(multiBlock, sizeOfCells), multiBlock, multiBlock, whichData);
+}
 
-    // Implement a caching mechanism for the communication structure.
+void ParallelBlockCommunicator3D::duplicateOverlaps (
+        std::vector<MultiBlock3D*> const& multiBlocks,
+        std::vector<modif::ModifT> const& whichData ) const
+{
+    PLB_PRECONDITION( multiBlocks.size() == whichData.size() );
+    if (multiBlocks.empty()) {
+        return;
+    }
+    std::vector<plint> sizeOfCells(multiBlocks.size());
+    for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
+        PLB_PRECONDITION( multiBlocks[iBlock]->getMultiBlockManagement().equivalentTo (
+                              multiBlocks[0]->getMultiBlockManagement() ) );
+        sizeOfCells[iBlock] = multiBlocks[iBlock]->sizeOfCellContent(whichData[iBlock]);
+    }
+    // The overlaps only depend on the first multi-block, as all of them share
+    //   the same distribution and periodicity.
+    communicate(getCommunication(*multiBlocks[0], sizeOfCells), multiBlocks, whichData);
+}
+
+CommunicationStructure3D& ParallelBlockCommunicator3D::getCommunication (
+        MultiBlock3D const& multiBlock, std::vector<plint> const& sizeOfCells ) const
+{
+    // Implement a caching mechanism for the communication structures.
     if (overlapsModified) {
         overlapsModified = false;
-        LocalMultiBlockInfo3D const& localInfo = multiBlockManagement.getLocalInfo();
-        std::vector<Overlap3D> overlaps(multiBlockManagement.getLocalInfo().getNormalOverlaps());
-        for (pluint iOverlap=0; iOverlap<localInfo.getPeriodicOverlaps().size(); ++iOverlap) {
-            PeriodicOverlap3D const& pOverlap = localInfo.getPeriodicOverlaps()[iOverlap];
-            if (periodicity.get(pOverlap.normalX,pOverlap.normalY,pOverlap.normalZ)) {
-                overlaps.push_back(pOverlap.overlap);
-            }
+        clearCommunications();
+    }
+    CommunicationMap::iterator it = communications.find(sizeOfCells);
+    if (it != communications.end()) {
+        return *it->second;
+    }
+    MultiBlockManagement3D const& multiBlockManagement = multiBlock.getMultiBlockManagement();
+    PeriodicitySwitch3D const& periodicity             = multiBlock.periodicity();
+    LocalMultiBlockInfo3D const& localInfo = multiBlockManagement.getLocalInfo();
+    std::vector<Overlap3D> overlaps(multiBlockManagement.getLocalInfo().getNormalOverlaps());
+    for (pluint iOverlap=0; iOverlap<localInfo.getPeriodicOverlaps().size(); ++iOverlap) {
+        PeriodicOverlap3D const& pOverlap = localInfo.getPeriodicOverlaps()[iOverlap];
+        if (periodicity.get(pOverlap.normalX,pOverlap.normalY,pOverlap.normalZ)) {
+            overlaps.push_back(pOverlap.overlap);
         }
-        delete communication;
-        communication = new CommunicationStructure3D (
-                                overlaps,
-                                multiBlockManagement, multiBlockManagement,
-                                multiBlock.sizeOfCell() );
     }
+    CommunicationStructure3D* communication = new CommunicationStructure3D (
+                            overlaps,
+                            multiBlockManagement, multiBlockManagement,
+                            sizeOfCells );
+    communications[sizeOfCells] = communication;
+    return *communication;
+}
 
-    communicate(*communication, multiBlock, multiBlock, whichData);
+void ParallelBlockCommunicator3D::clearCommunications() const {
+    CommunicationMap::iterator it = communications.begin();
+    for (; it != communications.end(); ++it) {
+        delete it->second;
+    }
+    communications.clear();
 }
 
 void ParallelBlockCommunicator3D::communicate (
@@ -253,7 +311,7 @@ void ParallelBlockCommunicator3D::communicate (
             overlaps,
             originMultiBlock.getMultiBlockManagement(),
             destinationMultiBlock.getMultiBlockManagement(),
-            originMultiBlock.sizeOfCell() );
+            originMultiBlock.sizeOfCellContent(whichData) );
     communicate(communication, originMultiBlock, destinationMultiBlock, whichData);
 }
 
@@ -263,7 +321,7 @@ void ParallelBlockCommunicator3D::communicate (
         MultiBlock3D& destinationMultiBlock, modif::ModifT whichData ) const
 {
     global::profiler().start("mpiCommunication");
-    bool staticMessage = whichData == modif::staticVariables;
+    bool staticMessage = modif::hasStaticSize(whichData);
     // 1. Non-blocking receives.
     communication.recvComm.startBeingReceptive(staticMessage);
 
@@ -305,6 +363,66 @@ void ParallelBlockCommunicator3D::communicate (
     global::profiler().stop("mpiCommunication");
 }
 
+void ParallelBlockCommunicator3D::communicate (
+        CommunicationStructure3D& communication,
+        std::vector<MultiBlock3D*> const& multiBlocks,
+        std::vector<modif::ModifT> const& whichData ) const
+{
+    global::profiler().start("mpiCommunication");
+    // The messages of the group travel together: they can only be treated as
+    //   static if the content of all of them is static.
+    bool staticMessage = true;
+    for (pluint iBlock=0; iBlock<whichData.size(); ++iBlock) {
+        staticMessage = staticMessage && modif::hasStaticSize(whichData[iBlock]);
+    }
+    // 1. Non-blocking receives.
+    communication.recvComm.startBeingReceptive(staticMessage);
+
+    // 2. Non-blocking sends, one message per overlap and multi-block, in the
+    //    order in which they were subscribed.
+    for (unsigned iSend=0; iSend<communication.sendPackage.size(); ++iSend) {
+        CommunicationInfo3D const& info = communication.sendPackage[iSend];
+        for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
+            AtomicBlock3D const& fromBlock = multiBlocks[iBlock]->getComponent(info.fromBlockId);
+            fromBlock.getDataTransfer().send (
+                    info.fromDomain, communication.sendComm.getSendBuffer(info.toProcessId),
+                    whichData[iBlock] );
+            communication.sendComm.acceptMessage(info.toProcessId, staticMessage);
+        }
+    }
+
+    // 3. Local copies which require no communication.
+    for (unsigned iSendRecv=0; iSendRecv<communication.sendRecvPackage.size(); ++iSendRecv) {
+        CommunicationInfo3D const& info = communication.sendRecvPackage[iSendRecv];
+        plint deltaX = info.fromDomain.x0 - info.toDomain.x0;
+        plint deltaY = info.fromDomain.y0 - info.toDomain.y0;
+        plint deltaZ = info.fromDomain.z0 - info.toDomain.z0;
+        for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
+            AtomicBlock3D const& fromBlock = multiBlocks[iBlock]->getComponent(info.fromBlockId);
+            AtomicBlock3D& toBlock = multiBlocks[iBlock]->getComponent(info.toBlockId);
+            toBlock.getDataTransfer().attribute (
+                    info.toDomain, deltaX, deltaY, deltaZ, fromBlock,
+                    whichData[iBlock], info.absoluteOffset );
+        }
+    }
+
+    // 4. Finalize the receives.
+    for (unsigned iRecv=0; iRecv<communication.recvPackage.size(); ++iRecv) {
+        CommunicationInfo3D const& info = communication.recvPackage[iRecv];
+        for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
+            AtomicBlock3D& toBlock = multiBlocks[iBlock]->getComponent(info.toBlockId);
+            toBlock.getDataTransfer().receive (
+                    info.toDomain,
+                    communication.recvComm.receiveMessage(info.fromProcessId, staticMessage),
+                    whichData[iBlock], info.absoluteOffset );
+        }
+    }
+
+    // 5. Finalize the sends.
+    communication.sendComm.finalize(staticMessage);
+    global::profiler().stop("mpiCommunication");
+}
+
 void ParallelBlockCommunicator3D::signalPeriodicity() const {
     overlapsModified = true;
 }
@@ -373,6 +491,17 @@ void BlockingCommunicator3D::duplicateOverlaps( MultiBlock3D& multiBlock,
     communicate(*communication, multiBlock, multiBlock, whichData);
 }
 
+void BlockingCommunicator3D::duplicateOverlaps (
+        std::vector<MultiBlock3D*> const& multiBlocks,
+        std::vector<modif::ModifT> const& whichData ) const
+{
+    PLB_PRECONDITION( multiBlocks.size() == whichData.size() );
+    // The blocking communicator exchanges the multi-blocks one after the other.
+    for (pluint iBlock=0; iBlock<multiBlocks.size(); ++iBlock) {
+        multiBlocks[iBlock]->duplicateOverlaps(whichData[iBlock]);
+    }
+}
+
 void BlockingCommunicator3D::communicate (
         std::vector<Overlap3D> const& overlaps,
         MultiBlock3D const& originMultiBlock,
@@ -45,6 +45,7 @@
 #include "parallelism/sendRecvPool.h"
 #include "parallelism/communicationPackage3D.h"
 #include <vector>
+#include <map>
 
 namespace plb {
 
@@ -68,11 +69,24 @@ struct CommunicationStructure3D
             MultiBlockManagement3D const& originManagement,
             MultiBlockManagement3D const& destinationManagement,
             plint sizeOfCell );
+    /// Communication structure for a group of multi-blocks with the same
+    ///   distribution. For each overlap, one message is subscribed per
+    ///   multi-block, and all messages to a given process are packed together.
+    CommunicationStructure3D (
+            std::vector<Overlap3D> const& overlaps,
+            MultiBlockManagement3D const& originManagement,
+            MultiBlockManagement3D const& destinationManagement,
+            std::vector<plint> const& sizeOfCells );
     CommunicationPackage3D sendPackage;
     CommunicationPackage3D recvPackage;
     CommunicationPackage3D sendRecvPackage;
     SendPoolCommunicator sendComm;
     RecvPoolCommunicator recvComm;
+private:
+    void initialize( std::vector<Overlap3D> const& overlaps,
+                     MultiBlockManagement3D const& originManagement,
+                     MultiBlockManagement3D const& destinationManagement,
+                     std::vector<plint> const& sizeOfCells );
 };
 
 
@@ -86,6 +100,8 @@ public:
     void swap(ParallelBlockCommunicator3D& rhs);
     virtual ParallelBlockCommunicator3D* clone() const;
     virtual void duplicateOverlaps(MultiBlock3D& multiBlock, modif::ModifT whichData) const;
+    virtual void duplicateOverlaps( std::vector<MultiBlock3D*> const& multiBlocks,
+                                    std::vector<modif::ModifT> const& whichData ) const;
     virtual void communicate( std::vector<Overlap3D> const& overlaps,
                               MultiBlock3D const& originMultiBlock,
                               MultiBlock3D& destinationMultiBlock,
@@ -95,12 +111,23 @@ private:
     void communicate( CommunicationStructure3D& communication,
                       MultiBlock3D const& originMultiBlock,
                       MultiBlock3D& destinationMultiBlock, modif::ModifT whichData ) const;
+    void communicate( CommunicationStructure3D& communication,
+                      std::vector<MultiBlock3D*> const& multiBlocks,
+                      std::vector<modif::ModifT> const& whichData ) const;
     void subscribeOverlap (
         Overlap3D const& overlap, MultiBlockManagement3D const& multiBlockManagement,
         SendRecvPool& sendPool, SendRecvPool& recvPool, plint sizeOfCell ) const;
+    /// Get the cached communication structure for the envelopes of multiBlock, with
+    ///   one message per overlap and cell size. A new structure is created if needed.
+    CommunicationStructure3D& getCommunication (
+        MultiBlock3D const& multiBlock, std::vector<plint> const& sizeOfCells ) const;
+    void clearCommunications() const;
 private:
+    typedef std::map<std::vector<plint>, CommunicationStructure3D*> CommunicationMap;
     mutable bool overlapsModified;
-    mutable CommunicationStructure3D* communication;
+    /// The message sizes depend on the transmitted cell content: one communication
+    ///   structure is cached for each combination of cell sizes.
+    mutable CommunicationMap communications;
 };
 
 
@@ -114,6 +141,8 @@ public:
     void swap(BlockingCommunicator3D& rhs);
     virtual BlockingCommunicator3D* clone() const;
     virtual void duplicateOverlaps(MultiBlock3D& multiBlock, modif::ModifT whichData) const;
+    virtual void duplicateOverlaps( std::vector<MultiBlock3D*> const& multiBlocks,
+                                    std::vector<modif::ModifT> const& whichData ) const;
     virtual void communicate( std::vector<Overlap3D> const& overlaps,
                               MultiBlock3D const& originMultiBlock,
                               MultiBlock3D& destinationMultiBlock,
@@ -45,6 +45,15 @@ namespace plb {
 
 #ifdef PLB_MPI_PARALLEL
 
+namespace {
+
+/// Static messages go through the persistent requests, if they are enabled.
+bool usesPersistentMessage(bool staticMessage) {
+    return staticMessage && global::mpi().usesPersistentCommunication();
+}
+
+}  // namespace
+
 SendPoolCommunicator::SendPoolCommunicator(SendRecvPool const& pool)
     : subscriptions(pool.begin(), pool.end())
 {
@@ -86,8 +95,14 @@ void SendPoolCommunicator::finalize(bool staticMessage) {
         if (!staticMessage) {
             global::mpi().wait(&entry.sizeRequest, &entry.sizeStatus);
         }
+        if (usesPersistentMessage(staticMessage)) {
+            // Waiting leaves the persistent request inactive, ready for the next start.
+            if (entry.persistent.isInitialized()) {
+                global::mpi().wait(&entry.persistent.request, &entry.messageStatus);
+            }
+        }
         // Empty messages are neither sent nor received.
-        if (!entry.data.empty()) {
+        else if (!entry.data.empty()) {
             global::mpi().wait(&entry.messageRequest, &entry.messageStatus);
         }
     }
@@ -98,8 +113,10 @@ void SendPoolCommunicator::startCommunication(int toProc, bool staticMessage)
     std::map<int,CommunicatorEntry>::iterator entryPtr = subscriptions.find(toProc);
     PLB_ASSERT( entryPtr != subscriptions.end() );
     CommunicatorEntry& entry = entryPtr->second;
+    bool persistent = usesPersistentMessage(staticMessage);
+    std::vector<char>& data = persistent ? entry.persistent.data : entry.data;
     if (staticMessage) {
-        entry.data.resize(entry.cumDataLength);
+        data.resize(entry.cumDataLength);
     }
     else {
         // If the communicated data is non-static, the overall size of transmitted
@@ -110,17 +127,17 @@ void SendPoolCommunicator::startCommunication(int toProc, bool staticMessage)
             dynamicDataLength += entry.messages[iMessage].size();
             entry.dynamicDataSizes[iMessage] = entry.messages[iMessage].size();
         }
-        entry.data.resize(dynamicDataLength);
+        data.resize(dynamicDataLength);
     }
     // Merge the individual messages into a single vector.
     int pos=0;
     for (pluint iMessage=0; iMessage<entry.messages.size(); ++iMessage) {
         PLB_ASSERT( !staticMessage ||
                     ( (int)entry.messages[iMessage].size() == entry.lengths[iMessage] ));
-        PLB_ASSERT(pos+entry.messages[iMessage].size() <= entry.data.size());
-        if( !entry.messages[iMessage].empty() && !entry.data.empty() ) {
+        PLB_ASSERT(pos+entry.messages[iMessage].size() <= data.size());
+        if( !entry.messages[iMessage].empty() && !data.empty() ) {
             std::copy(entry.messages[iMessage].begin(),
-                      entry.messages[iMessage].end(), entry.data.begin()+pos);
+                      entry.messages[iMessage].end(), data.begin()+pos);
         }
         pos+=entry.messages[iMessage].size();
     }
@@ -131,9 +148,19 @@ void SendPoolCommunicator::startCommunication(int toProc, bool staticMessage)
                             &entry.sizeRequest);
     }
     // Empty messages are neither sent nor received.
-    if (!entry.data.empty()) {
-        global::profiler().increment("mpiSendChar", (plint)entry.data.size());
-        global::mpi().iSend(&entry.data[0], entry.data.size(), toProc, &entry.messageRequest);
+    if (data.empty()) {
+        return;
+    }
+    global::profiler().increment("mpiSendChar", (plint)data.size());
+    if (persistent) {
+        // The buffer keeps its size, so the request is bound to it once and for all.
+        if (!entry.persistent.isInitialized()) {
+            global::mpi().sendInit(&data[0], data.size(), toProc, &entry.persistent.request);
+        }
+        global::mpi().start(&entry.persistent.request);
+    }
+    else {
+        global::mpi().iSend(&data[0], data.size(), toProc, &entry.messageRequest);
     }
 }
 
@@ -153,6 +180,20 @@ void RecvPoolCommunicator::startBeingReceptive(bool staticMessage)
     for (; iter != subscriptions.end(); ++iter) {
         int fromProc = iter->first;
         CommunicatorEntry& entry = iter->second;
+        if (usesPersistentMessage(staticMessage)) {
+            std::vector<char>& data = entry.persistent.data;
+            // Empty messages are neither sent nor received.
+            if (entry.cumDataLength > 0) {
+                if (!entry.persistent.isInitialized()) {
+                    data.resize(entry.cumDataLength);
+                    global::mpi().recvInit(&data[0], data.size(),
+                                           fromProc, &entry.persistent.request);
+                }
+                global::profiler().increment("mpiReceiveChar", (plint)data.size());
+                global::mpi().start(&entry.persistent.request);
+            }
+            continue;
+        }
         entry.data.resize(entry.cumDataLength);
         // Empty messages are neither sent nor received.
         if (!entry.data.empty()) {
@@ -227,11 +268,14 @@ void RecvPoolCommunicator::finalizeStatic(int fromProc)
     std::map<int,CommunicatorEntry>::iterator entryPtr = subscriptions.find(fromProc);
     PLB_ASSERT( entryPtr != subscriptions.end() );
     CommunicatorEntry& entry = entryPtr->second;
+    bool persistent = usesPersistentMessage(true);
+    std::vector<char> const& data = persistent ? entry.persistent.data : entry.data;
+    MPI_Request& request = persistent ? entry.persistent.request : entry.messageRequest;
 
     // Empty messages are neither sent nor received.
-    if (!entry.data.empty()) {
+    if (!data.empty()) {
         // 1. Make sure the package of messages has been received.
-        global::mpi().wait(&entry.messageRequest, &entry.messageStatus);
+        global::mpi().wait(&request, &entry.messageStatus);
         
         // 2. The message package is split into individual messages.
         int pos=0;
@@ -239,9 +283,9 @@ void RecvPoolCommunicator::finalizeStatic(int fromProc)
         for (pluint iMessage=0; iMessage<entry.messages.size(); ++iMessage) {
             int length = entry.lengths[iMessage];
             entry.messages[iMessage].resize(length);
-            PLB_ASSERT(pos+length <= (int)entry.data.size());
+            PLB_ASSERT(pos+length <= (int)data.size());
             if (!entry.messages[iMessage].empty()) {
-                std::copy( entry.data.begin()+pos, entry.data.begin()+pos+length,
+                std::copy( data.begin()+pos, data.begin()+pos+length,
                            entry.messages[iMessage].begin() );
             }
             pos+=length;
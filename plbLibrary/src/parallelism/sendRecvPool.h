@@ -84,6 +84,31 @@ private:
     SubsT subscriptions;
 };
 
+/// A persistent request together with the buffer it is bound to. The request is
+///   created on first use and reused in all subsequent communications of static
+///   size. Copies do not share the request: they start out without one.
+struct PersistentMessage {
+    PersistentMessage()
+        : data(),
+          request(MPI_REQUEST_NULL)
+    { }
+    PersistentMessage(PersistentMessage const& rhs)
+        : data(),
+          request(MPI_REQUEST_NULL)
+    { }
+    PersistentMessage& operator=(PersistentMessage const& rhs) {
+        global::mpi().requestFree(&request);
+        data.clear();
+        return *this;
+    }
+    ~PersistentMessage() {
+        global::mpi().requestFree(&request);
+    }
+    bool isInitialized() const { return request != MPI_REQUEST_NULL; }
+    std::vector<char> data;
+    MPI_Request request;
+};
+
 /// This is a storage device for the communication between a pair of processors,
 ///   to be used in action.
 struct CommunicatorEntry {
@@ -133,6 +158,9 @@ struct CommunicatorEntry {
     int currentMessage;
     MPI_Request sizeRequest, messageRequest;
     MPI_Status  sizeStatus, messageStatus;
+    /// Used instead of data and messageRequest for static messages, if the
+    ///   MPI manager is configured for persistent communication.
+    PersistentMessage persistent;
 };
 
 /// The "in-action" device for all messages sent from a processor.
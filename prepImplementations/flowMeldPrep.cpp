@@ -0,0 +1,149 @@
+/************************************************************************************/
+/*  Copyright 2025. Corning Incorporated. All rights reserved.                      */                                                                                     #
+/*  This software may only be used in accordance with the identified license(s).    */
+/*                                                                                  */
+/*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      */
+/*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        */
+/*  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL         */
+/*  CORNING BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN      */
+/*  ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN               */
+/*  CONNECTION WITH THE SOFTWARE OR THE USE OF THE SOFTWARE.                        */
+/************************************************************************************/
+/*  Authors:                                                                        */
+/* Hamed Haddadi Staff Scientist                                                    */
+/*               haddadigh@corning.com                                              */
+/* David Heine   Principal Scientist and Manager                                    */
+/*               heinedr@corning.com                                                */
+/************************************************************************************/
+
+// main driver file for the microstructure preprocessing tool (flowmeld-prep)
+// segmented raw image -> tag field with inlet/outlet buffers in the solver's microstructure format
+
+# include "../helpers/header.h"
+# include "../helpers/mpFunctionals.h"
+# include "../helpers/microstructurePrep.h"
+
+
+int main(int argc, char ** argv) {
+
+    plbInit(&argc, &argv);
+
+    if (argc < 2) {
+        pcout << "usage: flowmeld-prep input.xml" << std::endl;
+        return -1;
+    }
+    std::string xmlFileName = argv[1];
+
+    microstructure::RawImage image;
+    std::string outputFileName{};
+    plint threshold{0}, factor{1};
+    plint inletBuffer{0}, outletBuffer{0};
+    bool solidAboveThreshold{true};
+    std::vector<plint> cropX, cropY, cropZ;
+
+    try {
+        XMLreader document(xmlFileName);
+        document["image"]["file"].read(image.fileName);
+        document["image"]["size"]["x"].read(image.nx);
+        document["image"]["size"]["y"].read(image.ny);
+        document["image"]["size"]["z"].read(image.nz);
+        document["image"]["bytes_per_voxel"].read(image.bytesPerVoxel);
+        document["segmentation"]["threshold"].read(threshold);
+        document["segmentation"]["solid_above_threshold"].read(solidAboveThreshold);
+        document["output"]["microstructure"].read(outputFileName);
+    } catch (PlbIOException & exception) {
+        pcout << exception.what() << std::endl;
+        return -1;
+    }
+    // optional settings: crop box (first and last voxel per axis), downsampling and buffers
+    try {
+        XMLreader document(xmlFileName);
+        document["crop"]["x"].read(cropX);
+        document["crop"]["y"].read(cropY);
+        document["crop"]["z"].read(cropZ);
+    } catch (PlbIOException & exception) {
+    }
+    try {
+        XMLreader document(xmlFileName);
+        document["downsampling_factor"].read(factor);
+    } catch (PlbIOException & exception) {
+    }
+    try {
+        XMLreader document(xmlFileName);
+        document["buffers"]["inlet"].read(inletBuffer);
+        document["buffers"]["outlet"].read(outletBuffer);
+    } catch (PlbIOException & exception) {
+    }
+
+    if (image.bytesPerVoxel != 1 && image.bytesPerVoxel != 2) {
+        pcout << "bytes_per_voxel must be 1 (uint8) or 2 (uint16)" << std::endl;
+        return -1;
+    }
+    if (factor < 1 || inletBuffer < 0 || outletBuffer < 0) {
+        pcout << "downsampling_factor must be positive and buffers non-negative" << std::endl;
+        return -1;
+    }
+    if (cropX.empty()) {
+        cropX = {0, image.nx - 1};
+    }
+    if (cropY.empty()) {
+        cropY = {0, image.ny - 1};
+    }
+    if (cropZ.empty()) {
+        cropZ = {0, image.nz - 1};
+    }
+    if (cropX.size() != 2 || cropY.size() != 2 || cropZ.size() != 2 ||
+            cropX[0] < 0 || cropY[0] < 0 || cropZ[0] < 0 ||
+            cropX[1] >= image.nx || cropY[1] >= image.ny || cropZ[1] >= image.nz) {
+        pcout << "crop must give the first and last voxel inside the image for x, y and z" << std::endl;
+        return -1;
+    }
+
+    // trailing voxels that do not fill a downsampled node are dropped
+    const plint imageNx = (cropX[1] - cropX[0] + 1)/factor;
+    const plint ny = (cropY[1] - cropY[0] + 1)/factor;
+    const plint nz = (cropZ[1] - cropZ[0] + 1)/factor;
+    const plint nx = inletBuffer + imageNx + outletBuffer;
+    if (imageNx < 1 || ny < 1 || nz < 1) {
+        pcout << "the cropped image is smaller than the downsampling factor" << std::endl;
+        return -1;
+    }
+
+    if (!microstructure::isReadable(image)) {
+        pcout << "Error: could not open image file " << image.fileName << " or it is smaller than its size" << std::endl;
+        return -1;
+    }
+
+    global::timer("prep").restart();
+    MultiScalarField3D<int> tags(nx, ny, nz, 0);
+    Box3D imageDomain(inletBuffer, inletBuffer + imageNx - 1, 0, ny - 1, 0, nz - 1);
+    if (!microstructure::readSegmentedImage(tags, imageDomain, image, Dot3D(cropX[0], cropY[0], cropZ[0]),
+            factor, threshold, solidAboveThreshold)) {
+        pcout << "Error: could not read image file " << image.fileName << " on every process" << std::endl;
+        return -1;
+    }
+    // the inlet buffer holds the invading fluid, the outlet buffer is void
+    if (inletBuffer > 0) {
+        setToConstant(tags, Box3D(0, inletBuffer - 1, 0, ny - 1, 0, nz - 1), 3);
+    }
+    mpfunctionals::classifySolidTags(tags, tags.getBoundingBox());
+
+    plint poreNodes = count(tags, imageDomain, mpfunctionals::IsFluidTag());
+    T porosity = (T) poreNodes/(T) (imageNx*ny*nz);
+
+    plb_ofstream ofile(outputFileName.c_str());
+    if (!ofile.is_open()) {
+        pcout << "Error: could not open output file " << outputFileName << std::endl;
+        return -1;
+    }
+    ofile << tags << std::endl;
+    ofile.close();
+
+    pcout << "microstructure written to " << outputFileName << std::endl;
+    pcout << "resolution: x " << nx << " y " << ny << " z " << nz
+          << " (image " << imageNx << ", inlet buffer " << inletBuffer << ", outlet buffer " << outletBuffer << ")" << std::endl;
+    pcout << "porosity of the image region: " << porosity << std::endl;
+    pcout << "preprocessing finished in " << global::timer("prep").stop() << std::endl;
+
+    return 0;
+}